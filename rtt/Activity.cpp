@@ -82,6 +82,11 @@ namespace RTT
     {
     }
 
+    Activity::Activity(int scheduler, int priority, Seconds period, const os::ThreadProfile& profile, RunnableInterface* r, const std::string& name )
+    : ActivityInterface(r), os::Thread(scheduler, priority, period, profile, name )
+    {
+    }
+
     Activity::~Activity()
     {
         stop();
@@ -153,6 +153,25 @@ namespace RTT
         Activity(int scheduler, int priority, Seconds period, unsigned cpu_affinity,
                  base::RunnableInterface* r = 0, const std::string& name ="Activity");
 
+        /**
+         * @brief Create an Activity with a given scheduler type, priority, period and thread profile.
+         *
+         * @param scheduler
+         *        The scheduler in which the activity's thread must run. Use ORO_SCHED_OTHER or
+         *        ORO_SCHED_RT.
+         * @param priority
+         *        The priority of this activity.
+         * @param period
+         *        The periodicity of the Activity
+         * @param profile
+         *        The CPU set, memory and deadline scheduling settings of the thread.
+         * @param r
+         *        The optional base::RunnableInterface to run exclusively within this Activity
+         * @param name The name of the underlying thread.
+         */
+        Activity(int scheduler, int priority, Seconds period, const os::ThreadProfile& profile,
+                 base::RunnableInterface* r = 0, const std::string& name ="Activity");
+
         /**
          * Stops and terminates a Activity
          */
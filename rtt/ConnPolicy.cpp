@@ -78,7 +78,7 @@ namespace RTT
     }
 
     ConnPolicy::ConnPolicy(int type /* = DATA*/, int lock_policy /*= LOCK_FREE*/)
-        : type(type), init(false), lock_policy(lock_policy), pull(false), size(0), transport(0), data_size(0) {}
+        : type(type), init(false), lock_policy(lock_policy), pull(false), size(0), max_readers(0), seqlock(false), transport(0), data_size(0) {}
 
     /** @cond */
     /** This is dead code. We use the boost::serialization now.
@@ -112,6 +112,13 @@ namespace RTT
             log(Error) <<"ConnPolicy: wrong property type of 'size'."<<endlog();
             return false;
         }
+        i = bag.getProperty("max_readers");
+        if ( i.ready() )
+            result.max_readers = i.get();
+        else if ( bag.find("max_readers") ){
+            log(Error) <<"ConnPolicy: wrong property type of 'max_readers'."<<endlog();
+            return false;
+        }
         i = bag.getProperty("data_size");
         if ( i.ready() )
             result.data_size = i.get();
@@ -141,6 +148,13 @@ namespace RTT
             log(Error) <<"ConnPolicy: wrong property type of 'pull'."<<endlog();
             return false;
         }
+        b = bag.getProperty("seqlock");
+        if ( b.ready() )
+            result.seqlock = b.get();
+        else if ( bag.find("seqlock") ){
+            log(Error) <<"ConnPolicy: wrong property type of 'seqlock'."<<endlog();
+            return false;
+        }
 
         s = bag.getProperty("name_id");
         if ( s.ready() )
@@ -165,6 +179,8 @@ namespace RTT
         targetbag.ownProperty( new Property<int>("lock_policy","Locking Policy", cp.lock_policy));
         targetbag.ownProperty( new Property<bool>("pull","Fetch data over network", cp.pull));
         targetbag.ownProperty( new Property<int>("size","The size of a buffered connection", cp.size));
+        targetbag.ownProperty( new Property<int>("max_readers","The maximum number of concurrent readers of a data connection. Set to zero if unsure.", cp.max_readers));
+        targetbag.ownProperty( new Property<bool>("seqlock","Use a sequence lock on a lock-free data connection with a single writer.", cp.seqlock));
         targetbag.ownProperty( new Property<int>("transport","The prefered transport. Set to zero if unsure.", cp.transport));
         targetbag.ownProperty( new Property<int>("data_size","A hint about the data size of a single data sample. Set to zero if unsure.", cp.transport));
         targetbag.ownProperty( new Property<string>("name_id","The name of the connection to be formed.",cp.name_id));
@@ -61,6 +61,12 @@ namespace RTT {
      *       synchronisation at all (not thread safe). The latter should
      *       be used only when there is no contention (simultaneous write-read).
      *
+     *  <li> the maximum number of concurrent readers of a data connection.
+     *       Lock-free data connections reserve a copy of the data for each reader.
+     *
+     *  <li> if a lock-free data connection with a single writer may use a
+     *       sequence lock instead, which needs no copy per reader.
+     *
      *  <li> if, upon connection, the last value that has been written on the
      *       writer end should be written on the connection as well to
      *       initialize it. This flag has an effect only if the writer has
@@ -157,6 +163,21 @@ namespace RTT {
         bool   pull;
         /** If the connection is a buffered connection, the size of the buffer */
         int    size;
+        /**
+         * The maximum number of threads that read a lock-free data connection
+         * concurrently. The connection keeps one copy of the data per reader, so
+         * too low a value causes lost samples and too high a value wastes memory.
+         * Set to zero to use the default of 2.
+         */
+        int    max_readers;
+        /**
+         * If true, a lock-free data connection of a trivially copyable type of
+         * at most 64 bytes uses a base::DataObjectSeqLock instead of a
+         * base::DataObjectLockFree. Only set this if a single thread writes
+         * the connection, since concurrent writers corrupt a sequence lock.
+         * Defaults to false.
+         */
+        bool   seqlock;
         /**
          * The prefered transport used. 0 is local (in process), a higher number
          * is used for inter-process or networked communication transports.
@@ -125,7 +125,7 @@ namespace RTT
         for_each(handles.begin(), handles.end(), boost::bind(&Handle::disconnect, _1));
     }
 #else
-    void DataFlowInterface::dataOnPort(base::PortInterface* port)
+    void DataFlowInterface::dataOnPort(base::InputPortInterface* port)
     {
         if ( mservice && mservice->getOwner() )
             mservice->getOwner()->dataOnPort(port);
@@ -142,7 +142,8 @@ namespace RTT
 
 #ifdef ORO_SIGNALLING_PORTS
         // setup synchronous callback, only purpose is to register that port fired and trigger the TC's engine.
-        Handle h = port.getNewDataOnPortEvent()->connect(boost::bind(&TaskContext::dataOnPort, mservice->getOwner(), _1) );
+        // The port is bound here, such that dataOnPort() needs not cast the PortInterface argument.
+        Handle h = port.getNewDataOnPortEvent()->connect(boost::bind(&TaskContext::dataOnPort, mservice->getOwner(), &port) );
         if (h) {
             log(Info) << mservice->getName() << " will be triggered when new data is available on InputPort " << port.getName() << endlog();
             handles.push_back(h);
@@ -171,11 +172,12 @@ namespace RTT
                     // for this reason, we take a ref to mservice until we leave removePort.
                     mservice_ref = mservice->provides(); // uses shared_from_this()
                     mservice->removeService( name );
-                    if (mservice->getOwner())
-                        mservice->getOwner()->dataOnPortRemoved( *it );
                 }
                 (*it)->disconnect(); // remove all connections and callbacks.
                 (*it)->setInterface(0);
+                // after disconnect(), such that the port is not queued again.
+                if (mservice && mservice->getOwner())
+                    mservice->getOwner()->dataOnPortRemoved( *it );
                 mports.erase(it);
                 return;
             }
@@ -188,6 +190,8 @@ namespace RTT
             if ( (*it)->getName() == name ) {
                 (*it)->disconnect(); // remove all connections and callbacks.
                 (*it)->setInterface(0);
+                if (mservice && mservice->getOwner())
+                    mservice->getOwner()->dataOnPortRemoved( *it );
                 mports.erase(it);
                 return;
             }
@@ -259,7 +259,7 @@ namespace RTT
         /**
          * Used by the input ports to notify this class of new data.
          */
-        void dataOnPort(base::PortInterface* port);
+        void dataOnPort(base::InputPortInterface* port);
 #endif
     protected:
         /**
@@ -42,15 +42,22 @@
 #include "base/TaskCore.hpp"
 #include "rtt-fwd.hpp"
 #include "os/MutexLock.hpp"
-#include "internal/MWSRQueue.hpp"
+#include "internal/SegmentedMWSRQueue.hpp"
 #include "TaskContext.hpp"
 #include "internal/CatchConfig.hpp"
 #include "extras/SlaveActivity.hpp"
+#include "internal/AtomicMPMCQueue.hpp"
+#include "os/CAS.hpp"
+#include "os/Thread.hpp"
+#include "os/threads.hpp"
 
 #include <boost/bind.hpp>
 #include <algorithm>
+#include <sstream>
 
+#ifndef ORONUM_EE_MQUEUE_SIZE
 #define ORONUM_EE_MQUEUE_SIZE 100
+#endif
 
 namespace RTT
 {
@@ -65,11 +72,321 @@ namespace RTT
     using namespace detail;
     using namespace boost;
 
+    namespace {
+        /**
+         * Records the lifetime of this object in a histogram.
+         */
+        struct ScopedTiming {
+            os::TimingHistogram& h;
+            os::TimeService::ticks start;
+            ScopedTiming(os::TimingHistogram& hist)
+                : h(hist), start( os::TimeService::Instance()->getTicks() ) {}
+            ~ScopedTiming() {
+                h.record( os::TimeService::ticks2nsecs( os::TimeService::Instance()->ticksSince(start) ) );
+            }
+        };
+    }
+
+    /**
+     * Executes the children of an ExecutionEngine on helper threads.
+     * Each step, the children without predecessors are queued. The
+     * engine's thread and the helpers take children from the queue,
+     * and queue the successors of which all predecessors are done,
+     * until all children are done.
+     */
+    class ExecutionEngine::ParallelChildren
+    {
+        class Helper
+            : public os::Thread
+        {
+            ParallelChildren* mowner;
+            unsigned int mslot;
+        public:
+            Helper(ParallelChildren* owner, unsigned int slot, int scheduler, int priority, unsigned cpu_affinity, const std::string& name)
+                : os::Thread(scheduler, priority, 0.0, cpu_affinity, name), mowner(owner), mslot(slot)
+            {}
+
+            ~Helper()
+            {
+                this->stop();
+            }
+
+            void loop()
+            {
+                mowner->help(mslot);
+            }
+
+            bool breakLoop()
+            {
+                // the owner sets mquit before it stops its helpers.
+                return true;
+            }
+        };
+
+        /**
+         * The child which a thread is executing, or zero.
+         */
+        struct Slot
+        {
+            Slot() : current(0) {}
+            TaskCore* volatile current;
+        };
+
+        ExecutionEngine* mee;
+        std::vector<Helper*> mhelpers;
+        /**
+         * The children, their number of predecessors and their successors,
+         * copied or computed by rebuild().
+         */
+        std::vector<TaskCore*> mchildren;
+        std::vector<int> mpreds;
+        std::vector< std::vector<unsigned int> > msuccs;
+        /**
+         * The number of predecessors of each child which are not done yet.
+         */
+        std::vector<os::AtomicInt> mpending;
+        /**
+         * Slot 0 is the engine's thread, slot i is helper i-1.
+         */
+        std::vector<Slot> mslots;
+        internal::AtomicMPMCQueue<unsigned int>* mready;
+        os::AtomicInt mremaining;
+        os::AtomicInt msleeping;
+        os::AtomicInt mstopping;
+        unsigned int mgeneration;
+        bool mquit;
+        volatile bool mrunning;
+        os::Mutex mlock;
+        os::Condition mcond;
+    public:
+        /**
+         * Set when the children or their order changed.
+         */
+        bool dirty;
+
+        ParallelChildren(ExecutionEngine* ee)
+            : mee(ee), mready(0), mremaining(0), msleeping(0), mstopping(0),
+              mgeneration(0), mquit(false), mrunning(false), dirty(true)
+        {}
+
+        ~ParallelChildren()
+        {
+            {
+                os::MutexLock lock(mlock);
+                mquit = true;
+                mcond.broadcast();
+            }
+            for (unsigned int i = 0; i != mhelpers.size(); ++i)
+                delete mhelpers[i];
+            delete mready;
+        }
+
+        bool start(unsigned int helpers, int scheduler, int priority, unsigned cpu_affinity)
+        {
+            std::vector<unsigned int> cpus;
+            for (unsigned int cpu = 0; cpu != os::OnlineProcessors() && cpu != 8 * sizeof(unsigned); ++cpu)
+                if ( cpu_affinity & (1u << cpu) )
+                    cpus.push_back(cpu);
+            mslots.resize(helpers + 1);
+            bool ok = true;
+            for (unsigned int i = 0; i != helpers; ++i) {
+                std::stringstream name;
+                name << "ChildHelper" << i;
+                mhelpers.push_back( new Helper(this, i + 1, scheduler, priority, cpus.empty() ? 0 : 1u << cpus[i % cpus.size()], name.str()) );
+                ok = mhelpers.back()->start() && ok;
+            }
+            return ok;
+        }
+
+        unsigned int size() const
+        {
+            return mhelpers.size();
+        }
+
+        /**
+         * Returns the slot of the calling thread if it is executing
+         * children in run(), or -1 otherwise.
+         */
+        int slot() const
+        {
+            for (unsigned int i = 0; i != mhelpers.size(); ++i)
+                if ( mhelpers[i]->isSelf() )
+                    return i + 1;
+            if ( mrunning && mee->getActivity() && mee->getActivity()->thread()->isSelf() )
+                return 0;
+            return -1;
+        }
+
+        /**
+         * Copies the children and computes their order. This allocates,
+         * and is only done after the children or their order changed.
+         * Requires the lock on child_lock.
+         */
+        void rebuild()
+        {
+            mchildren = mee->children;
+            unsigned int n = mchildren.size();
+            mpreds.assign(n, 0);
+            msuccs.assign(n, std::vector<unsigned int>());
+            mpending.assign(n, os::AtomicInt(0));
+            for (unsigned int k = 0; k != mee->child_order.size(); ++k) {
+                unsigned int b = find(mchildren.begin(), mchildren.end(), mee->child_order[k].first) - mchildren.begin();
+                unsigned int a = find(mchildren.begin(), mchildren.end(), mee->child_order[k].second) - mchildren.begin();
+                if ( b != n && a != n ) {
+                    msuccs[b].push_back(a);
+                    ++mpreds[a];
+                }
+            }
+            if ( mready == 0 || mready->capacity() < n ) {
+                delete mready;
+                mready = new internal::AtomicMPMCQueue<unsigned int>( n );
+            }
+            dirty = false;
+        }
+
+        /**
+         * Executes all children and returns when they are done.
+         */
+        void run()
+        {
+            unsigned int n = mpreds.size();
+            if ( n == 0 )
+                return;
+            for (unsigned int i = 0; i != n; ++i)
+                mpending[i].set( mpreds[i] );
+            mremaining.set( n );
+            for (unsigned int i = 0; i != n; ++i)
+                if ( mpreds[i] == 0 )
+                    mready->enqueue( i );
+            {
+                os::MutexLock lock(mlock);
+                ++mgeneration;
+                mcond.broadcast();
+            }
+            mrunning = true;
+            work(0);
+            mrunning = false;
+        }
+
+        /**
+         * Called from \a slot, which may be executing \a tc
+         * itself, to wait until no other thread executes \a tc.
+         * The caller has set the target state of \a tc, such that
+         * it is not executed again.
+         */
+        void waitChild(TaskCore* tc, int slot)
+        {
+            os::MutexLock lock(mlock);
+            // execute() reads mstopping after it cleared its slot.
+            mstopping.inc();
+            while ( !mquit && executing(tc, slot) )
+                mcond.wait(mlock);
+            mstopping.dec();
+        }
+
+    private:
+        bool executing(TaskCore* tc, int except) const
+        {
+            for (unsigned int i = 0; i != mslots.size(); ++i)
+                if ( int(i) != except && mslots[i].current == tc )
+                    return true;
+            return false;
+        }
+
+        void help(unsigned int slot)
+        {
+            unsigned int seen;
+            {
+                os::MutexLock lock(mlock);
+                seen = mgeneration;
+            }
+            while ( true ) {
+                {
+                    os::MutexLock lock(mlock);
+                    while ( !mquit && mgeneration == seen )
+                        mcond.wait(mlock);
+                    if ( mquit )
+                        return;
+                    seen = mgeneration;
+                }
+                work(slot);
+            }
+        }
+
+        void work(unsigned int slot)
+        {
+            while ( mremaining.read() != 0 ) {
+                unsigned int i;
+                if ( mready->dequeue(i) ) {
+                    execute(i, slot);
+                    continue;
+                }
+                os::MutexLock lock(mlock);
+                // push() reads msleeping after it queued, so we check
+                // the queue again after incrementing it.
+                msleeping.inc();
+                while ( !mquit && mremaining.read() != 0 && mready->isEmpty() )
+                    mcond.wait(mlock);
+                msleeping.dec();
+                if ( mquit )
+                    return;
+            }
+        }
+
+        void execute(unsigned int i, unsigned int slot)
+        {
+            // the CAS orders the slot before the state check of processChild(),
+            // against the state change before waitChild().
+            os::CAS( &mslots[slot].current, (TaskCore*)0, mchildren[i] );
+            mee->processChild( mchildren[i] );
+            mslots[slot].current = 0;
+            if ( mstopping.read() != 0 ) {
+                os::MutexLock lock(mlock);
+                mcond.broadcast();
+            }
+            // queue the successors before counting this child as done,
+            // such that run() does not return while we are still here.
+            for (unsigned int k = 0; k != msuccs[i].size(); ++k)
+                if ( mpending[ msuccs[i][k] ].dec_and_test() )
+                    push( msuccs[i][k] );
+            if ( mremaining.dec_and_test() ) {
+                os::MutexLock lock(mlock);
+                mcond.broadcast();
+            }
+        }
+
+        void push(unsigned int i)
+        {
+            mready->enqueue(i);
+            if ( msleeping.read() != 0 ) {
+                os::MutexLock lock(mlock);
+                mcond.broadcast();
+            }
+        }
+    };
+
+    namespace {
+        /**
+         * Returns true if \a a precedes \a b in \a order.
+         */
+        bool precedes(const std::vector< std::pair<TaskCore*, TaskCore*> >& order, TaskCore* a, TaskCore* b)
+        {
+            if ( a == b )
+                return true;
+            for (unsigned int k = 0; k != order.size(); ++k)
+                if ( order[k].first == a && precedes(order, order[k].second, b) )
+                    return true;
+            return false;
+        }
+    }
+
     ExecutionEngine::ExecutionEngine( TaskCore* owner )
         : taskc(owner),
-          mqueue(new MWSRQueue<DisposableInterface*>(ORONUM_EE_MQUEUE_SIZE) ),
-          f_queue( new MWSRQueue<ExecutableInterface*>(ORONUM_EE_MQUEUE_SIZE) ),
-          mmaster(0)
+          mqueue(new SegmentedMWSRQueue<DisposableInterface*>(ORONUM_EE_MQUEUE_SIZE) ),
+          f_queue( new SegmentedMWSRQueue<ExecutableInterface*>(ORONUM_EE_MQUEUE_SIZE) ),
+          max_messages(0), max_message_ticks(0),
+          msg_drained(0), msg_backlog(0), msg_time(0.0), msg_depth(0),
+          mmaster(0), mparallel(0)
     {
     }
 
@@ -77,6 +394,9 @@ namespace RTT
     {
         Logger::In in("~ExecutionEngine");
 
+        delete mparallel;
+        deleteRetired();
+
         // make a copy to avoid call-back troubles:
         std::vector<TaskCore*> copy = children;
         for (std::vector<TaskCore*>::iterator it = copy.begin(); it != copy.end();++it){
@@ -101,18 +421,93 @@ namespace RTT
     }
 
     void ExecutionEngine::addChild(TaskCore* tc) {
+        MutexLock lock(child_lock);
         children.push_back( tc );
+        if ( mparallel )
+            mparallel->dirty = true;
     }
 
     void ExecutionEngine::removeChild(TaskCore* tc) {
+        MutexLock lock(child_lock);
         vector<TaskCore*>::iterator it = find (children.begin(), children.end(), tc );
         if ( it != children.end() )
             children.erase(it);
+        for (unsigned int k = 0; k != child_order.size(); )
+            if ( child_order[k].first == tc || child_order[k].second == tc )
+                child_order.erase( child_order.begin() + k );
+            else
+                ++k;
+        if ( mparallel )
+            mparallel->dirty = true;
+    }
+
+    bool ExecutionEngine::setParallelChildren(unsigned int helpers, unsigned cpu_affinity) {
+        MutexLock lock(child_lock);
+        // step() may be running the old helpers, so these are
+        // deleted by our thread, see deleteRetired().
+        if ( mparallel )
+            mretired.push_back( mparallel );
+        mparallel = 0;
+        if ( helpers == 0 )
+            return true;
+        // the helpers run at the priority of our thread.
+        int scheduler = ORO_SCHED_OTHER;
+        int priority = os::LowestPriority;
+        if ( this->getActivity() && this->getActivity()->thread() ) {
+            scheduler = this->getActivity()->thread()->getScheduler();
+            priority = this->getActivity()->thread()->getPriority();
+        }
+        mparallel = new ParallelChildren(this);
+        if ( !mparallel->start(helpers, scheduler, priority, cpu_affinity) ) {
+            log(Error) << "Could not start the helper threads for executing children in parallel." << endlog();
+            delete mparallel;
+            mparallel = 0;
+            return false;
+        }
+        return true;
+    }
+
+    unsigned int ExecutionEngine::getParallelChildren() const {
+        MutexLock lock(child_lock);
+        return mparallel ? mparallel->size() : 0;
+    }
+
+    void ExecutionEngine::deleteRetired() {
+        std::vector<ParallelChildren*> retired;
+        {
+            MutexLock lock(child_lock);
+            retired.swap( mretired );
+        }
+        for (unsigned int i = 0; i != retired.size(); ++i)
+            delete retired[i];
+    }
+
+    bool ExecutionEngine::addChildDependency(TaskCore* before, TaskCore* after) {
+        MutexLock lock(child_lock);
+        if ( precedes(child_order, after, before) )
+            return false;
+        child_order.push_back( std::make_pair(before, after) );
+        if ( mparallel )
+            mparallel->dirty = true;
+        return true;
+    }
+
+    bool ExecutionEngine::removeChildDependency(TaskCore* before, TaskCore* after) {
+        MutexLock lock(child_lock);
+        std::vector< std::pair<TaskCore*, TaskCore*> >::iterator it =
+            find(child_order.begin(), child_order.end(), std::make_pair(before, after));
+        if ( it == child_order.end() )
+            return false;
+        child_order.erase(it);
+        if ( mparallel )
+            mparallel->dirty = true;
+        return true;
     }
 
     void ExecutionEngine::processFunctions()
     {
         // Execute all loaded Functions :
+        ScopedTiming timing(func_timing);
         ExecutableInterface* foo = 0;
         int nbr = f_queue->size(); // nbr to process.
         // 1. Fetch new ones from queue.
@@ -121,8 +516,12 @@ namespace RTT
             if ( foo->execute() == false ){
                 foo->unloaded();
                 msg_cond.broadcast(); // required for waitForFunctions() (3rd party thread)
-            } else {
-                f_queue->enqueue( foo );
+            } else if ( f_queue->enqueue( foo ) == false ) {
+                // only possible after setQueueSize() when the new segment is full.
+                log(Error) << "Function queue full: unloading function." << endlog();
+                f_queue_rejected.inc();
+                foo->unloaded();
+                msg_cond.broadcast();
             }
             if ( --nbr == 0) // we did a round-trip
                 break;
@@ -137,6 +536,8 @@ namespace RTT
                 return false;
             f->loaded(this);
             bool result = f_queue->enqueue( f );
+            if ( !result )
+                f_queue_rejected.inc();
             // signal work is to be done:
             this->getActivity()->trigger();
             return result;
@@ -198,7 +599,11 @@ namespace RTT
             if ( f  == foo) {
                 return true;
             }
-            f_queue->enqueue(foo);
+            if ( f_queue->enqueue(foo) == false ) {
+                log(Error) << "Function queue full: unloading function." << endlog();
+                f_queue_rejected.inc();
+                foo->unloaded();
+            }
             --nbr;
         }
         return true;
@@ -219,10 +624,20 @@ namespace RTT
         // execute all commands from the AtomicQueue.
         // msg_lock may not be held when entering this function !
         DisposableInterface* com(0);
+        unsigned int drained = 0;
+        // a message may recurse into processMessages(), only the outermost call records the statistics.
+        bool outermost = msg_depth++ == 0;
+        os::TimeService::ticks start = 0;
         {
-            while ( mqueue->dequeue(com) ) {
+            while ( (max_messages == 0 || drained != max_messages) && mqueue->dequeue(com) ) {
                 assert( com );
+                // steps without messages do not read the clock.
+                if ( drained == 0 )
+                    start = os::TimeService::Instance()->getTicks();
                 com->executeAndDispose();
+                ++drained;
+                if ( max_message_ticks != 0 && os::TimeService::Instance()->ticksSince(start) >= max_message_ticks )
+                    break;
             }
             // there's no need to hold the lock during
             // emptying the queue. But we must hold the
@@ -232,8 +647,19 @@ namespace RTT
             // This allows us to recurse into processMessages.
             MutexLock locker( msg_lock );
         }
+        --msg_depth;
+        if ( outermost ) {
+            os::TimeService::ticks spent = drained ? os::TimeService::Instance()->ticksSince(start) : 0;
+            msg_timing.record( os::TimeService::ticks2nsecs(spent) );
+            msg_time = nsecs_to_Seconds( os::TimeService::ticks2nsecs(spent) );
+            msg_drained = drained;
+            msg_backlog = mqueue->size();
+        }
         if ( com )
             msg_cond.broadcast(); // required for waitForMessages() (3rd party thread)
+        // the budget expired: carry the remaining messages over to the next step.
+        if ( outermost && msg_backlog && drained && this->getActivity() )
+            this->getActivity()->trigger();
     }
 
     bool ExecutionEngine::process( DisposableInterface* c )
@@ -249,6 +675,8 @@ namespace RTT
                 return false;
 
             bool result = mqueue->enqueue( c );
+            if ( !result )
+                mqueue_rejected.inc();
             this->getActivity()->trigger();
             msg_cond.broadcast(); // required for waitAndProcessMessages() (EE thread)
             return result;
@@ -296,6 +724,78 @@ namespace RTT
         RTT::base::RunnableInterface::setActivity(task);
     }
 
+    bool ExecutionEngine::setQueueSize(unsigned int size, bool growable)
+    {
+        mqueue->setGrowable(growable);
+        f_queue->setGrowable(growable);
+        if ( size == mqueue->capacity() && size == f_queue->capacity() )
+            return true;
+        // check both queues first, such that they are resized together or not at all.
+        if ( !mqueue->canResize() || !f_queue->canResize() ) {
+            log(Error) << "Could not resize the queues of the ExecutionEngine: too many resizes which are not processed yet." << endlog();
+            return false;
+        }
+        unsigned int mcap = mqueue->resize(size);
+        unsigned int fcap = f_queue->resize(size);
+        if ( mcap != size || fcap != size ) {
+            log(Error) << "Resized the queues of the ExecutionEngine to "<< mcap << " and " << fcap
+                       << " elements instead of " << size << "." << endlog();
+            return false;
+        }
+        return true;
+    }
+
+    unsigned int ExecutionEngine::getQueueSize() const
+    {
+        return mqueue->capacity();
+    }
+
+    bool ExecutionEngine::isQueueGrowable() const
+    {
+        return mqueue->isGrowable();
+    }
+
+    unsigned int ExecutionEngine::getRejectedMessages() const
+    {
+        return mqueue_rejected.read();
+    }
+
+    unsigned int ExecutionEngine::getRejectedFunctions() const
+    {
+        return f_queue_rejected.read();
+    }
+
+    void ExecutionEngine::setMessageBudget(unsigned int max, Seconds max_time)
+    {
+        max_messages = max;
+        max_message_ticks = max_time > 0.0 ? os::TimeService::nsecs2ticks( Seconds_to_nsecs(max_time) ) : 0;
+    }
+
+    unsigned int ExecutionEngine::getMaxMessages() const
+    {
+        return max_messages;
+    }
+
+    Seconds ExecutionEngine::getMaxMessageTime() const
+    {
+        return nsecs_to_Seconds( os::TimeService::ticks2nsecs(max_message_ticks) );
+    }
+
+    unsigned int ExecutionEngine::getMessagesDrained() const
+    {
+        return msg_drained;
+    }
+
+    unsigned int ExecutionEngine::getMessagesBacklog() const
+    {
+        return msg_backlog;
+    }
+
+    Seconds ExecutionEngine::getMessagesTime() const
+    {
+        return msg_time;
+    }
+
     void ExecutionEngine::waitForMessagesInternal(boost::function<bool(void)> const& pred)
     {
         if ( pred() )
@@ -318,7 +818,9 @@ namespace RTT
                 // We must lock because the cond variable will unlock msg_lock.
                 os::MutexLock lock(msg_lock);
                 if (!pred()) {
-                    msg_cond.wait(msg_lock); // now processMessages may run.
+                    // messages may be left over when the message budget expired.
+                    if ( mqueue->isEmpty() )
+                        msg_cond.wait(msg_lock); // now processMessages may run.
                 } else {
                     return; // do not process messages when pred() == true;
                 }
@@ -356,7 +858,11 @@ namespace RTT
             // A trigger() in startHook() will be ignored, we trigger in TaskCore after startHook finishes.
             if ( taskc->mTaskState == TaskCore::Running && taskc->mTargetState == TaskCore::Running ) {
                 TRY (
-                    taskc->prepareUpdateHook();
+                    {
+                        ScopedTiming timing(taskc->mhookstats.prepareUpdateHook);
+                        taskc->prepareUpdateHook();
+                    }
+                    ScopedTiming timing(taskc->mhookstats.updateHook);
                     taskc->updateHook();
                 ) CATCH(std::exception const& e,
                     log(Error) << "in updateHook(): switching to exception state because of unhandled exception" << endlog();
@@ -370,6 +876,7 @@ namespace RTT
             // in case start() or updateHook() called error(), this will be called:
             if (taskc->mTaskState == TaskCore::RunTimeError && taskc->mTargetState >= TaskCore::Running) {
                 TRY (
+                    ScopedTiming timing(taskc->mhookstats.errorHook);
                     taskc->errorHook();
                 ) CATCH(std::exception const& e,
                     log(Error) << "in errorHook(): switching to exception state because of unhandled exception" << endlog();
@@ -383,37 +890,70 @@ namespace RTT
         }
         if ( !this->getActivity() || ! this->getActivity()->isRunning() ) return;
 
-        // call all children as well.
-        for (std::vector<TaskCore*>::iterator it = children.begin(); it != children.end();++it) {
-            if ( (*it)->mTaskState == TaskCore::Running  && (*it)->mTargetState == TaskCore::Running  ){
-                TRY (
-                    (*it)->prepareUpdateHook();
-                    (*it)->updateHook();
-                ) CATCH(std::exception const& e,
-                    log(Error) << "in updateHook(): switching to exception state because of unhandled exception" << endlog();
-                    log(Error) << "  " << e.what() << endlog();
-                    (*it)->exception();
-               ) CATCH_ALL (
-                    log(Error) << "in updateHook(): switching to exception state because of unhandled exception" << endlog();
-                    (*it)->exception(); // calls stopHook,cleanupHook
-                )
+        // a hint, which is checked again under child_lock.
+        if ( mparallel || !mretired.empty() ) {
+            // if the children are being changed, execute them one after the other.
+            ParallelChildren* parallel = 0;
+            bool retired = false;
+            {
+                os::MutexTryLock lock(child_lock);
+                if ( lock.isSuccessful() ) {
+                    retired = !mretired.empty();
+                    if ( mparallel && mparallel->dirty )
+                        mparallel->rebuild();
+                    parallel = mparallel;
+                }
             }
-            if ((*it)->mTaskState == TaskCore::RunTimeError && (*it)->mTargetState == TaskCore::RunTimeError){
-                TRY (
-                    (*it)->errorHook();
-                ) CATCH(std::exception const& e,
-                    log(Error) << "in errorHook(): switching to exception state because of unhandled exception" << endlog();
-                    log(Error) << "  " << e.what() << endlog();
-                    (*it)->exception();
-               ) CATCH_ALL (
-                    log(Error) << "in errorHook(): switching to exception state because of unhandled exception" << endlog();
-                    (*it)->exception(); // calls stopHook,cleanupHook
-                )
+            if ( retired )
+                deleteRetired();
+            // run without child_lock, such that children may change
+            // the children or stop themselves.
+            if ( parallel ) {
+                parallel->run();
+                return;
             }
+        }
+
+        // call all children as well.
+        for (std::vector<TaskCore*>::iterator it = children.begin(); it != children.end();++it) {
+            processChild(*it);
             if ( !this->getActivity() || ! this->getActivity()->isRunning() ) return;
         }
     }
 
+    void ExecutionEngine::processChild(TaskCore* tc) {
+        if ( tc->mTaskState == TaskCore::Running  && tc->mTargetState == TaskCore::Running  ){
+            TRY (
+                {
+                    ScopedTiming timing(tc->mhookstats.prepareUpdateHook);
+                    tc->prepareUpdateHook();
+                }
+                ScopedTiming timing(tc->mhookstats.updateHook);
+                tc->updateHook();
+            ) CATCH(std::exception const& e,
+                log(Error) << "in updateHook(): switching to exception state because of unhandled exception" << endlog();
+                log(Error) << "  " << e.what() << endlog();
+                tc->exception();
+           ) CATCH_ALL (
+                log(Error) << "in updateHook(): switching to exception state because of unhandled exception" << endlog();
+                tc->exception(); // calls stopHook,cleanupHook
+            )
+        }
+        if (tc->mTaskState == TaskCore::RunTimeError && tc->mTargetState == TaskCore::RunTimeError){
+            TRY (
+                ScopedTiming timing(tc->mhookstats.errorHook);
+                tc->errorHook();
+            ) CATCH(std::exception const& e,
+                log(Error) << "in errorHook(): switching to exception state because of unhandled exception" << endlog();
+                log(Error) << "  " << e.what() << endlog();
+                tc->exception();
+           ) CATCH_ALL (
+                log(Error) << "in errorHook(): switching to exception state because of unhandled exception" << endlog();
+                tc->exception(); // calls stopHook,cleanupHook
+            )
+        }
+    }
+
     bool ExecutionEngine::breakLoop() {
         bool ok = true;
         if (taskc)
@@ -425,6 +965,24 @@ namespace RTT
     }
 
     bool ExecutionEngine::stopTask(TaskCore* task) {
+        // a child stopped from within an updateHook() which runs in parallel:
+        // step() is waiting for that updateHook(), so we can not synchronize
+        // with step(). Wait until no other thread executes the child instead.
+        // The helpers are only deleted by our thread, so they outlive this.
+        ParallelChildren* owner = 0;
+        int slot = -1;
+        {
+            MutexLock lock(child_lock);
+            if ( mparallel && (slot = mparallel->slot()) != -1 )
+                owner = mparallel;
+            for (unsigned int i = 0; owner == 0 && i != mretired.size(); ++i)
+                if ( (slot = mretired[i]->slot()) != -1 )
+                    owner = mretired[i];
+        }
+        if ( owner ) {
+            owner->waitChild(task, slot);
+            return true;
+        }
         // stop and start where former will call breakLoop() in case of non-periodic.
         // this is a forced synchronization point, since stop() will only return when
         // step() returned.
@@ -451,7 +1009,7 @@ namespace RTT
             
 
     void ExecutionEngine::finalize() {
-        // nop
+        deleteRetired();
     }
 
 }
@@ -42,6 +42,9 @@
 #include "os/Mutex.hpp"
 #include "os/MutexLock.hpp"
 #include "os/Condition.hpp"
+#include "os/Atomic.hpp"
+#include "os/TimeService.hpp"
+#include "os/TimingHistogram.hpp"
 #include "base/RunnableInterface.hpp"
 #include "base/ActivityInterface.hpp"
 #include "base/DisposableInterface.hpp"
@@ -199,6 +202,131 @@ namespace RTT
          */
         virtual void setActivity( base::ActivityInterface* task );
 
+        /**
+         * Sets the number of messages and functions that can be queued
+         * in between two steps. This may be called at any time, queued
+         * messages and functions are kept and executed in order.
+         * @param size The new capacity of the message and function queues.
+         * @param growable When true, the queues grow when they overflow,
+         * instead of rejecting new messages or functions. Growing allocates
+         * memory and is thus not real-time.
+         * @return false if the queues were resized too many times before
+         * the queued messages were processed, or if the queues did not get
+         * a capacity of \a size.
+         */
+        bool setQueueSize(unsigned int size, bool growable = false);
+
+        /**
+         * Returns the number of messages that can be queued in between
+         * two steps before process() rejects them.
+         */
+        unsigned int getQueueSize() const;
+
+        /**
+         * Returns true if the queues grow when they overflow.
+         */
+        bool isQueueGrowable() const;
+
+        /**
+         * Returns the number of messages rejected by process() because
+         * the message queue was full.
+         */
+        unsigned int getRejectedMessages() const;
+
+        /**
+         * Returns the number of functions rejected by runFunction() because
+         * the function queue was full.
+         */
+        unsigned int getRejectedFunctions() const;
+
+        /**
+         * Limits the number of messages executed in each step. Messages
+         * which exceed the budget remain queued and are executed in the
+         * next step, which bounds the time a burst of messages can steal
+         * from updateHook().
+         * @param max_messages The maximum number of messages executed in
+         * one step, or zero for no limit.
+         * @param max_time Stop executing messages in a step once this amount
+         * of seconds was spent, or zero for no limit. The message being
+         * executed when the budget expires is always completed.
+         */
+        void setMessageBudget(unsigned int max_messages, Seconds max_time);
+
+        /**
+         * Returns the maximum number of messages executed in one step,
+         * zero if unlimited.
+         */
+        unsigned int getMaxMessages() const;
+
+        /**
+         * Returns the maximum time in seconds spent on executing messages
+         * in one step, zero if unlimited.
+         */
+        Seconds getMaxMessageTime() const;
+
+        /**
+         * Returns the number of messages executed in the last step.
+         */
+        unsigned int getMessagesDrained() const;
+
+        /**
+         * Returns the number of messages which were left in the queue
+         * after the last step.
+         */
+        unsigned int getMessagesBacklog() const;
+
+        /**
+         * Returns the time in seconds spent on executing messages in
+         * the last step.
+         */
+        Seconds getMessagesTime() const;
+
+        /**
+         * Returns the histogram of the time spent in processMessages()
+         * in each step. It may be read from any thread.
+         */
+        os::TimingHistogram& getMessagesTiming() { return msg_timing; }
+
+        /**
+         * Returns the histogram of the time spent in processFunctions()
+         * in each step. It may be read from any thread.
+         */
+        os::TimingHistogram& getFunctionsTiming() { return func_timing; }
+
+        /**
+         * Executes the updateHook() of the children (see addChild()) on
+         * \a helpers threads in addition to the thread of this engine,
+         * which waits until all children are done before step() returns.
+         * Children without an order (see addChildDependency()) may run
+         * at the same time, so they must not share data without locking.
+         * @param helpers The number of helper threads, zero to execute
+         * the children one after the other in this engine's thread (the default).
+         * @param cpu_affinity The helpers are pinned, one by one, to the
+         * processors in this mask.
+         * The previous helpers are stopped by this engine's thread, after
+         * the step() that may be using them.
+         * @return false if helper threads could not be started.
+         */
+        bool setParallelChildren(unsigned int helpers, unsigned cpu_affinity = ~0);
+
+        /**
+         * Returns the number of helper threads set by setParallelChildren().
+         */
+        unsigned int getParallelChildren() const;
+
+        /**
+         * Declare that child \a before must finish its updateHook() before
+         * the updateHook() of child \a after starts, when executing children
+         * in parallel.
+         * @return false if \a before already depends on \a after.
+         */
+        bool addChildDependency(base::TaskCore* before, base::TaskCore* after);
+
+        /**
+         * Remove a dependency declared with addChildDependency().
+         */
+        bool removeChildDependency(base::TaskCore* before, base::TaskCore* after);
+
     protected:
         /**
          * Call this if you wish to block on a message arriving in the Execution Engine.
@@ -251,27 +379,88 @@ namespace RTT
         /**
          * Our Message queue
          */
-        internal::MWSRQueue<base::DisposableInterface*>* mqueue;
+        internal::SegmentedMWSRQueue<base::DisposableInterface*>* mqueue;
 
         std::vector<base::TaskCore*> children;
 
         /**
          * Stores all functions we're executing.
          */
-        internal::MWSRQueue<base::ExecutableInterface*>* f_queue;
+        internal::SegmentedMWSRQueue<base::ExecutableInterface*>* f_queue;
+
+        /**
+         * Counts the enqueues which failed because mqueue or f_queue
+         * was full.
+         */
+        os::AtomicInt mqueue_rejected, f_queue_rejected;
 
         os::Mutex msg_lock;
         os::Condition msg_cond;
 
+        /**
+         * The message budget of one step, set by setMessageBudget().
+         */
+        unsigned int max_messages;
+        os::TimeService::ticks max_message_ticks;
+
+        /**
+         * The statistics of the last processMessages().
+         */
+        unsigned int msg_drained;
+        unsigned int msg_backlog;
+        Seconds msg_time;
+        /**
+         * The number of processMessages() calls in progress.
+         */
+        unsigned int msg_depth;
+
+        /**
+         * The execution times of processMessages() and processFunctions().
+         * The hooks of the TaskCores are recorded in TaskCore::getHookStatistics().
+         */
+        os::TimingHistogram msg_timing;
+        os::TimingHistogram func_timing;
+
         /**
          * A master ExecutionEngine which should process our messages.
          * This is used for ExecutionEngines running in a SlaveActivity which forward incoming messages to their master engine.
          */
         ExecutionEngine *mmaster;
 
+        /**
+         * The helper threads and state of setParallelChildren().
+         */
+        class ParallelChildren;
+        ParallelChildren* mparallel;
+        /**
+         * Helpers replaced by setParallelChildren(), which step() may still be
+         * using. These are deleted by deleteRetired().
+         */
+        std::vector<ParallelChildren*> mretired;
+
+        /**
+         * The (before, after) pairs of addChildDependency().
+         */
+        std::vector< std::pair<base::TaskCore*, base::TaskCore*> > child_order;
+
+        /**
+         * Protects \a children, \a child_order, \a mparallel and \a mretired.
+         * The children are executed without holding it.
+         */
+        mutable os::Mutex child_lock;
+
         void processMessages();
         void processFunctions();
         void processChildren();
+        /**
+         * Deletes the helpers in \a mretired. Only called by our own thread
+         * when it is not executing children, or when we are destroyed.
+         */
+        void deleteRetired();
+        /**
+         * Executes the updateHook() or errorHook() of child \a tc.
+         */
+        void processChild(base::TaskCore* tc);
 
         virtual bool initialize();
 
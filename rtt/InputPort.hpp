@@ -84,6 +84,34 @@ namespace RTT
             return false;
         }
 
+        bool do_readShared(typename base::ChannelElement<T>::shared_sample_t& sample, FlowStatus& result, bool copy_old_data, const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        {
+            typename base::ChannelElement<T>::shared_ptr input = static_cast< base::ChannelElement<T>* >( descriptor.get<1>().get() );
+            assert( result != NewData );
+            if ( input ) {
+                FlowStatus tresult = input->readShared(sample, copy_old_data);
+                if (tresult == NewData) {
+                    result = tresult;
+                    return true;
+                }
+                if (tresult > result)
+                    result = tresult;
+            }
+            return false;
+        }
+
+        bool do_readAll(std::vector<T>& samples, FlowStatus& result, bool copy_old_data, const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        {
+            typename base::ChannelElement<T>::shared_ptr input = static_cast< base::ChannelElement<T>* >( descriptor.get<1>().get() );
+            if ( input ) {
+                FlowStatus tresult = input->readAll(samples);
+                if (tresult > result)
+                    result = tresult;
+            }
+            // visit all connections.
+            return false;
+        }
+
         /**
          * You are not allowed to copy ports.
          * In case you want to create a container of ports,
@@ -115,6 +143,23 @@ namespace RTT
             return read(ds->set(), copy_old_data);
         }
 
+        /** Reads a sample from the connection, without copying it if it was
+         * written with OutputPort::publish() over a local connection.
+         * \a sample refers to the same sample as the writer and the other readers,
+         * and keeps it from returning to the writer's pool until it is reset or
+         * overwritten. Samples written with OutputPort::write() are copied into
+         * a newly allocated sample, which is not real-time.
+         *
+         * @param copy_old_data Set to false to leave \a sample unchanged if
+         * the return value is RTT::OldData.
+         */
+        FlowStatus readShared(internal::SharedSample<T>& sample, bool copy_old_data = true)
+        {
+            FlowStatus result = NoData;
+            cmanager.select_reader_channel( boost::bind( &InputPort::do_readShared, this, boost::ref(sample), boost::ref(result), _1, _2 ), copy_old_data );
+            return result;
+        }
+
         /** Read all new samples that are available on this port, and returns
          * the last one.
          *
@@ -147,12 +192,22 @@ namespace RTT
 	 * be updated in the case that the return type is equal to RTT::OldData.
 	 * In case @arg copy_old_data is false and an old sample is available, the
 	 * method will still return RTT::OldData but the sample will not be updated
+         *
+         * If isNewestOnly(), this reads like readNewest().
          */
         FlowStatus read(typename base::ChannelElement<T>::reference_t sample, bool copy_old_data)
         {
             FlowStatus result = NoData;
             // read and iterate if necessary.
             cmanager.select_reader_channel( boost::bind( &InputPort::do_read, this, boost::ref(sample), boost::ref(result), _1, _2 ), copy_old_data );
+            if ( result == NewData && isNewestOnly() ) {
+                // drop the older samples of buffered connections.
+                FlowStatus next;
+                do {
+                    next = NoData;
+                    cmanager.select_reader_channel( boost::bind( &InputPort::do_read, this, boost::ref(sample), boost::ref(next), _1, _2 ), false );
+                } while ( next == NewData );
+            }
             return result;
         }
 
@@ -173,6 +228,23 @@ namespace RTT
             return RTT::NewData;
         }
 
+        /** Reads all new samples of all connections of this port in one call.
+         * Buffered connections are read in one batch, oldest sample first.
+         * This is real-time if \a samples has enough capacity.
+         *
+         * @param samples Is cleared and filled with the new samples.
+         * @return RTT::NewData if at least one sample was read, and
+         * either RTT::OldData or RTT::NoData otherwise.
+         */
+        FlowStatus readAll(std::vector<T>& samples)
+        {
+            FlowStatus result = NoData;
+            samples.clear();
+            internal::ConnectionManager::ChannelDescriptor descriptor;
+            cmanager.find_if( boost::bind( &InputPort::do_readAll, this, boost::ref(samples), boost::ref(result), _1, _2 ), false, descriptor );
+            return result;
+        }
+
         /**
          * Get a sample of the data on this port, without actually reading the port's data.
          * It's the complement of OutputPort::setDataSample() and serves to retrieve the size
@@ -55,6 +55,11 @@ boost::shared_ptr<base::DisposableInterface> OperationInterfacePart::getLocalOpe
     return boost::shared_ptr<base::DisposableInterface>();
 }
 
+bool OperationInterfacePart::setCompletion(base::DataSourceBase::shared_ptr handle, boost::function<void(void)> const& done) const
+{
+    return false;
+}
+
 void OperationInterface::clear()
 {
     for (map_t::iterator i = data.begin(); i != data.end(); ++i)
@@ -41,6 +41,7 @@
 
 #include <string>
 #include <vector>
+#include <boost/function.hpp>
 
 #include "base/DataSourceBase.hpp"
 #include "internal/DataSource.hpp"
@@ -179,6 +180,18 @@ namespace RTT
          */
         virtual base::DataSourceBase::shared_ptr produceCollect(const std::vector<base::DataSourceBase::shared_ptr>& args, internal::DataSource<bool>::shared_ptr blocking) const = 0;
 
+        /**
+         * Run a function in the caller's ExecutionEngine once a sent call
+         * of this operation completed.
+         * @param handle A DataSource returned by produceHandle(), which
+         * holds the SendHandle of the call.
+         * @param done The function to run.
+         * @return false if \a handle does not hold a SendHandle of this
+         * operation or if the call does not support completion callbacks.
+         * @see SendHandle::onCompletion
+         */
+        RTT_API virtual bool setCompletion(base::DataSourceBase::shared_ptr handle, boost::function<void(void)> const& done) const;
+
 #ifdef ORO_SIGNALLING_OPERATIONS
         /**
          * Attach a Signal Handle to this operation which fills in the given data sources and
@@ -84,6 +84,67 @@ namespace RTT
             }
         }
 
+        bool do_writeAll(std::vector<T> const& samples, const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        {
+            typename base::ChannelElement<T>::shared_ptr output
+                = boost::static_pointer_cast< base::ChannelElement<T> >(descriptor.get<1>());
+            if (output->writeAll(samples))
+                return false;
+            else
+            {
+                log(Error) << "A channel of port " << getName() << " has been invalidated during write(), it will be removed" << endlog();
+                return true;
+            }
+        }
+
+        bool do_publish(typename base::ChannelElement<T>::shared_sample_t const& sample, const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        {
+            typename base::ChannelElement<T>::shared_ptr output
+                = boost::static_pointer_cast< base::ChannelElement<T> >(descriptor.get<1>());
+            if (output->writeShared(sample))
+                return false;
+            else
+            {
+                log(Error) << "A channel of port " << getName() << " has been invalidated during publish(), it will be removed" << endlog();
+                return true;
+            }
+        }
+
+        /**
+         * The number of shared samples a connection with policy \a policy
+         * may hold: the samples in its storage, the last sample read and
+         * the one the reader holds. The storage of a data connection
+         * also holds the last sample read.
+         */
+        static unsigned int loanedSamples(ConnPolicy const& policy)
+        {
+            if (policy.type == ConnPolicy::DATA)
+                return internal::ChannelDataElement<T>::SharedSamples + 1;
+            return policy.size + 2;
+        }
+
+        /**
+         * Replaces the pool of loan() if it is too small for the
+         * current connections and \a extra additional samples.
+         */
+        void growLoanPool(unsigned int extra)
+        {
+            if (loans == 0)
+                return;
+            unsigned int required = loans + extra;
+            std::list<internal::ConnectionManager::ChannelDescriptor> channels = cmanager.getChannels();
+            for (std::list<internal::ConnectionManager::ChannelDescriptor>::const_iterator it = channels.begin(); it != channels.end(); ++it)
+                required += loanedSamples( it->get<2>() );
+            if (loan_pool && loan_pool->capacity() >= required)
+                return;
+            // older pools are released when this port is destroyed,
+            // since a concurrent loan() may still use them.
+            internal::SamplePool<T>* old_pool = loan_pool;
+            if (old_pool)
+                retired_loan_pools.push_back(old_pool);
+            loan_pool = new internal::SamplePool<T>(required, has_initial_sample ? sample->Get() : T());
+        }
+
         bool do_init(typename base::ChannelElement<T>::param_t sample, const internal::ConnectionManager::ChannelDescriptor& descriptor)
         {
             typename base::ChannelElement<T>::shared_ptr output
@@ -105,6 +166,8 @@ namespace RTT
             typename base::ChannelElement<T>::shared_ptr channel_el_input =
                 static_cast< base::ChannelElement<T>* >(channel_input.get());
 
+            growLoanPool( loanedSamples(policy) );
+
             if (has_initial_sample)
             {
                 T const& initial_sample = sample->Get();
@@ -135,6 +198,11 @@ namespace RTT
         // This is used to allow the use of the 'init' connection policy option
         bool keeps_last_written_value;
         typename base::DataObjectInterface<T>::shared_ptr sample;
+        /// The number of outstanding loans requested with reserveLoans(), 0 if loaning is disabled.
+        unsigned int loans;
+        /// The pool of loan(), null if loaning is disabled.
+        internal::SamplePool<T>* volatile loan_pool;
+        std::vector<internal::SamplePool<T>*> retired_loan_pools;
 
         /**
          * You are not allowed to copy ports.
@@ -169,11 +237,23 @@ namespace RTT
             , keeps_next_written_value(false)
             , keeps_last_written_value(false)
             , sample( new base::DataObject<T>() )
+            , loans(0)
+            , loan_pool(0)
         {
             if (keep_last_written_value)
                 keepLastWrittenValue(true);
         }
 
+        ~OutputPort()
+        {
+            // disconnect first, such that the connections give up their samples.
+            disconnect();
+            if (loan_pool)
+                loan_pool->release();
+            for (typename std::vector<internal::SamplePool<T>*>::iterator it = retired_loan_pools.begin(); it != retired_loan_pools.end(); ++it)
+                (*it)->release();
+        }
+
         void keepNextWrittenValue(bool keep)
         {
             keeps_next_written_value = keep;
@@ -257,6 +337,89 @@ namespace RTT
                     );
         }
 
+        /**
+         * Writes a sequence of samples to all receivers (if any), in order.
+         * Buffered connections store them in one batch, data connections
+         * only keep the last sample.
+         * @param samples The new samples to send out.
+         */
+        void write(const std::vector<T>& samples)
+        {
+            if ( samples.empty() )
+                return;
+            if (keeps_last_written_value || keeps_next_written_value)
+            {
+                keeps_next_written_value = false;
+                has_initial_sample = true;
+                this->sample->Set(samples.back());
+            }
+            has_last_written_value = keeps_last_written_value;
+
+            cmanager.delete_if( boost::bind(
+                        &OutputPort<T>::do_writeAll, this, boost::cref(samples), _1 )
+                    );
+        }
+
+        /**
+         * Enables loan() and publish() on this port. This allocates a pool
+         * of samples, which is large enough for \a loans samples held by the caller
+         * and for the samples the connections of this port may hold. Connections
+         * which are created later on grow the pool. The samples are initialized
+         * with the data sample of this port, so call setDataSample() or write()
+         * before this function for dynamically sized types.
+         * @param loans The number of samples the writer holds at the same time.
+         * @note Not real-time.
+         */
+        void reserveLoans(unsigned int loans = 1)
+        {
+            this->loans = loans;
+            growLoanPool(0);
+        }
+
+        /**
+         * Returns a writable sample of the pool of this port. The sample
+         * is handed over to the connections with publish().
+         * @return An invalid sample if reserveLoans() was not called or if
+         * all samples of the pool are in use.
+         * @note Real-time and lock-free.
+         */
+        internal::LoanedSample<T> loan()
+        {
+            internal::SamplePool<T>* pool = loan_pool;
+            if (pool)
+                return internal::LoanedSample<T>( pool->allocate() );
+            return internal::LoanedSample<T>();
+        }
+
+        /**
+         * Writes a loaned sample to all receivers, without copying it.
+         * Each connection keeps a reference to the same sample, which
+         * returns to the pool once all connections and readers released it.
+         * Connections which are not local, copy the sample as in write().
+         * If this port keeps the last written value, the sample is copied
+         * once into this port.
+         * @param sample A sample returned by loan(). Passing it moves the
+         * sample into this call, such that the caller's LoanedSample is empty
+         * afterwards and the sample can no longer be modified.
+         */
+        void publish(internal::LoanedSample<T> sample)
+        {
+            if ( !sample.valid() )
+                return;
+            typename base::ChannelElement<T>::shared_sample_t shared( sample.share() );
+            if (keeps_last_written_value || keeps_next_written_value)
+            {
+                keeps_next_written_value = false;
+                has_initial_sample = true;
+                this->sample->Set(*shared);
+            }
+            has_last_written_value = keeps_last_written_value;
+
+            cmanager.delete_if( boost::bind(
+                        &OutputPort<T>::do_publish, this, boost::cref(shared), _1 )
+                    );
+        }
+
         void write(base::DataSourceBase::shared_ptr source)
         {
             typename internal::AssignableDataSource<T>::shared_ptr ds =
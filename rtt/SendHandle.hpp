@@ -127,6 +127,24 @@ namespace RTT
                 return this->impl->collect();
             return SendFailure;
         }
+
+        /**
+         * Runs \a done in the ExecutionEngine of the caller once the call
+         * completed, instead of blocking in collect() or polling collectIfDone().
+         * The receiver posts the completion to the caller's message queue,
+         * and \a done may use collectIfDone() to read the results. \a done runs
+         * once, also when the call completed before this function was called.
+         *
+         * @return false if this handle is not ready, if the operation was sent
+         * without caller ExecutionEngine or if the operation does not support
+         * completion callbacks.
+         */
+        bool onCompletion(boost::function<void(void)> const& done)
+        {
+            if (this->impl)
+                return this->impl->setCompletion(done);
+            return false;
+        }
 	protected:
 	};
 }
@@ -50,6 +50,9 @@
 #include "internal/DataSource.hpp"
 #include "internal/mystd.hpp"
 #include "internal/MWSRQueue.hpp"
+#include "os/CAS.hpp"
+#include "internal/FusedFunctorDataSource.hpp"
+#include "internal/StatsService.hpp"
 #include "OperationCaller.hpp"
 
 #include "rtt-config.h"
@@ -69,7 +72,7 @@ namespace RTT
 
     TaskContext::TaskContext(const std::string& name, TaskState initial_state /*= Stopped*/)
         :  TaskCore( initial_state)
-           ,portqueue( new MWSRQueue<PortInterface*>(64) )
+           ,portqueue( new MWSRQueue<InputPortInterface*>(64) )
            ,tcservice(new Service(name,this) ), tcrequests( new ServiceRequester(name,this) )
 #if defined(ORO_ACT_DEFAULT_SEQUENTIAL)
            ,our_act( new SequentialActivity( this->engine() ) )
@@ -82,7 +85,7 @@ namespace RTT
 
     TaskContext::TaskContext(const std::string& name, ExecutionEngine* parent, TaskState initial_state /*= Stopped*/ )
         :  TaskCore(parent, initial_state)
-           ,portqueue( new MWSRQueue<PortInterface*>(64) )
+           ,portqueue( new MWSRQueue<InputPortInterface*>(64) )
            ,tcservice(new Service(name,this) ), tcrequests( new ServiceRequester(name,this) )
 #if defined(ORO_ACT_DEFAULT_SEQUENTIAL)
            ,our_act( parent ? 0 : new SequentialActivity( this->engine() ) )
@@ -93,6 +96,12 @@ namespace RTT
         this->setup();
     }
 
+    namespace {
+        unsigned int messagesDrained(const TaskCore* tc) { return tc->engine()->getMessagesDrained(); }
+        unsigned int messagesBacklog(const TaskCore* tc) { return tc->engine()->getMessagesBacklog(); }
+        Seconds messagesTime(const TaskCore* tc) { return tc->engine()->getMessagesTime(); }
+    }
+
     void TaskContext::setup()
     {
         tcservice->setOwner(this);
@@ -109,6 +118,17 @@ namespace RTT
         this->addOperation("setPeriod", &TaskContext::setPeriod, this, ClientThread).doc("Set the execution period in seconds.").arg("s", "Period in seconds.");
         this->addOperation("getCpuAffinity", &TaskContext::getCpuAffinity, this, ClientThread).doc("Get the configured cpu affinity.");
         this->addOperation("setCpuAffinity", &TaskContext::setCpuAffinity, this, ClientThread).doc("Set the cpu affinity.").arg("cpu", "Cpu mask.");
+        this->addOperation("setQueueSize", &TaskContext::setQueueSize, this, ClientThread).doc("Set the capacity of the message queue.").arg("size", "Number of messages that can be queued in between two steps.").arg("growable", "Grow the queue instead of rejecting messages when full.");
+        this->addOperation("getQueueSize", &TaskContext::getQueueSize, this, ClientThread).doc("Get the capacity of the message queue.");
+        this->addOperation("getRejectedMessages", &TaskContext::getRejectedMessages, this, ClientThread).doc("Get the number of messages rejected because the message queue was full.");
+        this->addOperation("setMessageBudget", &TaskContext::setMessageBudget, this, ClientThread).doc("Limit the messages executed in each step, the rest is executed in the next step.").arg("max_messages", "Maximum number of messages per step, 0 for no limit.").arg("max_time", "Maximum time in seconds spent on messages per step, 0.0 for no limit.");
+        // statistics of the last step, read through the current engine:
+        Alias drained("messagesDrained", new FusedFunctorDataSource<unsigned int(void)>( boost::bind(&messagesDrained, this) ) );
+        Alias backlog("messagesBacklog", new FusedFunctorDataSource<unsigned int(void)>( boost::bind(&messagesBacklog, this) ) );
+        Alias mtime("messagesTime", new FusedFunctorDataSource<Seconds(void)>( boost::bind(&messagesTime, this) ) );
+        this->addAttribute( drained );
+        this->addAttribute( backlog );
+        this->addAttribute( mtime );
         this->addOperation("isActive", &TaskContext::isActive, this, ClientThread).doc("Is the Execution Engine of this TaskContext active ?");
         this->addOperation("inFatalError", &TaskContext::inFatalError, this, ClientThread).doc("Check if this TaskContext is in the FatalError state.");
         this->addOperation("error", &TaskContext::error, this, ClientThread).doc("Enter the RunTimeError state (= errorHook() ).");
@@ -118,6 +138,9 @@ namespace RTT
 
         this->addOperation("trigger", &TaskContext::trigger, this, ClientThread).doc("Trigger the update method for execution in the thread of this task.\n Only succeeds if the task isRunning() and allowed by the Activity executing this task.");
         this->addOperation("loadService", &TaskContext::loadService, this, ClientThread).doc("Loads a service known to RTT into this component.").arg("service_name","The name with which the service is registered by in the PluginLoader.");
+        // execution time statistics, recorded by the ExecutionEngine:
+        provides()->addService( Service::shared_ptr( new StatsService(this) ) );
+
         // activity runs from the start.
         if (our_act)
             our_act->start();
@@ -423,10 +446,14 @@ namespace RTT
         return false;
     }
 
-    void TaskContext::dataOnPort(PortInterface* port)
+    void TaskContext::dataOnPort(InputPortInterface* port)
     {
         if ( this->dataOnPortHook(port) ) {
-            portqueue->enqueue( port );
+            // a newest-only port waiting in the queue is served by the coming step.
+            if ( port->isNewestOnly() && !os::CAS(&port->mqueued, 0, 1) )
+                return;
+            if ( !portqueue->enqueue( port ) )
+                os::CAS(&port->mqueued, 1, 0);
             this->getActivity()->trigger();
         }
     }
@@ -447,13 +474,28 @@ namespace RTT
         if (it != user_callbacks.end() ) {
             user_callbacks.erase(it);
         }
+        // the port may be deleted after this, so prepareUpdateHook()
+        // must not find it in the queue anymore.
+        std::vector<InputPortInterface*> others;
+        InputPortInterface* queued = 0;
+        while ( portqueue->dequeue( queued ) == true ) {
+            if ( queued == port )
+                os::CAS(&queued->mqueued, 1, 0);
+            else
+                others.push_back( queued );
+        }
+        for (std::vector<InputPortInterface*>::iterator q = others.begin(); q != others.end(); ++q)
+            portqueue->enqueue( *q );
     }
 
     void TaskContext::prepareUpdateHook()
     {
         MutexLock lock(mportlock);
-        PortInterface* port = 0;
+        InputPortInterface* port = 0;
         while ( portqueue->dequeue( port ) == true ) {
+            // data arriving from now on needs a new step. The CAS orders
+            // this before the reads of the callback.
+            os::CAS(&port->mqueued, 1, 0);
             UserCallbacks::iterator it = user_callbacks.find(port);
             if (it != user_callbacks.end() )
                 it->second(port); // fire the user callback
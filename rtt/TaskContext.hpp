@@ -643,7 +643,7 @@ namespace RTT
         void setup();
 
         friend class DataFlowInterface;
-        internal::MWSRQueue<base::PortInterface*>* portqueue;
+        internal::MWSRQueue<base::InputPortInterface*>* portqueue;
         typedef std::map<base::PortInterface*, SlotFunction > UserCallbacks;
         UserCallbacks user_callbacks;
 
@@ -651,7 +651,7 @@ namespace RTT
          * This callback is called each time data arrived on an
          * event port.
          */
-        void dataOnPort(base::PortInterface* port);
+        void dataOnPort(base::InputPortInterface* port);
         /**
          * Called to inform us of the number of possible
          * ports that will trigger a dataOnPort event.
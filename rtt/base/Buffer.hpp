@@ -80,15 +80,38 @@ namespace RTT
     public:
         /**
          * Create a fifo queue of fixed size.
+         * @param circular Set to true to drop the oldest element when
+         * the buffer is full, instead of the new one.
          */
-        Buffer( int qsize, const T& initial_value = T())
+        Buffer( int qsize, const T& initial_value = T(), bool circular = false)
 #if defined(OROBLD_OS_NO_ASM)
-            : BufferLocked<T>(qsize, initial_value)
+            : BufferLocked<T>(qsize, initial_value, circular)
 #else
-            : BufferLockFree<T>(qsize, initial_value)
+            : BufferLockFree<T>(qsize, initial_value, circular)
 #endif
         {}
     };
+
+    /**
+     * Creates the default thread-safe buffer for \a qsize elements.
+     * Contrary to Buffer, this also works for buffers which are
+     * larger than BufferLockFree<T>::max_capacity(): these use a
+     * 32-bit index if ORO_HAVE_CAS64 is defined and are locked otherwise.
+     * @param circular Set to true to drop the oldest element when
+     * the buffer is full, instead of the new one.
+     */
+    template< class T>
+    BufferInterface<T>* buildBuffer( int qsize, const T& initial_value = T(), bool circular = false)
+    {
+#if !defined(OROBLD_OS_NO_ASM)
+        if ( qsize <= BufferLockFree<T>::max_capacity() )
+            return new BufferLockFree<T>(qsize, initial_value, circular);
+# if defined(ORO_HAVE_CAS64)
+        return new BufferLockFree<T, unsigned int>(qsize, initial_value, circular);
+# endif
+#endif
+        return new BufferLocked<T>(qsize, initial_value, circular);
+    }
 }}
 
 
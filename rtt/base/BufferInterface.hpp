@@ -85,6 +85,26 @@ namespace RTT
          */
         virtual size_type Pop( std::vector<value_t>& items ) = 0;
 
+        /**
+         * Read at most \a max values from the buffer and append them
+         * to \a items, oldest first. Contrary to Pop(std::vector<value_t>&),
+         * \a items is not cleared first.
+         * @return the number of items appended.
+         * @cts
+         * @rt if \a items has enough capacity.
+         */
+        virtual size_type Pop( std::vector<value_t>& items, size_type max )
+        {
+            size_type quant = 0;
+            value_t* item;
+            while ( quant < max && (item = this->PopWithoutRelease()) ) {
+                items.push_back( *item );
+                this->Release( item );
+                ++quant;
+            }
+            return quant;
+        }
+
 	/**
 	 * Returns a pointer to the first element in the buffer.
 	 * The pointer is only garanteed to stay valid until 
@@ -47,6 +47,9 @@ namespace RTT {
 #if defined(__GNUC__)
         // Force an instantiation, so that the compiler checks the syntax.
         template class BufferLockFree<double>;
+#ifdef ORO_HAVE_CAS64
+        template class BufferLockFree<double, unsigned int>;
+#endif
 #endif
     }
 }
@@ -42,9 +42,10 @@
 #include "../os/Atomic.hpp"
 #include "../os/CAS.hpp"
 #include "BufferInterface.hpp"
-#include "../internal/AtomicMWSRQueue.hpp"
+#include "../internal/AtomicMPMCQueue.hpp"
 #include "../internal/TsPool.hpp"
 #include <vector>
+#include <limits>
 
 #ifdef ORO_PRAGMA_INTERFACE
 #pragma interface
@@ -63,9 +64,12 @@ namespace RTT
      * One thread may read and any number of threads may write this buffer.
      * @param T The value type to be stored in the Buffer.
      * Example : BufferLockFree<A> is a buffer which holds values of type A.
+     * @param Index The index type of the underlying pool. The default
+     * limits the buffer to max_capacity() == 65534 elements. Use an unsigned int
+     * for larger buffers, which is only available if ORO_HAVE_CAS64 is defined.
      * @ingroup PortBuffers
      */
-    template< class T>
+    template< class T, class Index = unsigned short>
     class BufferLockFree
         : public BufferInterface<T>
     {
@@ -76,9 +80,14 @@ namespace RTT
         typedef T value_t;
     private:
         typedef T Item;
-        internal::AtomicMWSRQueue<Item*> bufs;
+        /**
+         * The number of items Push(const std::vector<T>&) and
+         * Pop(std::vector<T>&) claim at once.
+         */
+        enum { BatchSize = 16 };
+        internal::AtomicMPMCQueue<Item*> bufs;
         // is mutable because of reference counting.
-        mutable internal::TsPool<Item> mpool;
+        mutable internal::TsPool<Item, Index> mpool;
         const bool mcircular;
         RTT::os::AtomicInt droppedSamples;
         
@@ -120,6 +129,18 @@ namespace RTT
             return bufs.capacity();
         }
 
+        /**
+         * The largest bufsize this buffer type supports.
+         */
+        static size_type max_capacity()
+        {
+            // the largest index marks the end of the pool.
+            unsigned long long max_index = Index(-1);
+            if ( max_index - 1 > (unsigned long long)std::numeric_limits<size_type>::max() - 1 )
+                return std::numeric_limits<size_type>::max() - 1;
+            return size_type( max_index - 1 );
+        }
+
         size_type size() const
         {
             return bufs.size();
@@ -203,21 +224,29 @@ namespace RTT
 
         size_type Push(const std::vector<T>& items)
         {
-            // @todo Make this function more efficient as in BufferLocked.
-            int towrite  = items.size();
+            // claims pool items and queue positions for a batch at a time.
+            Item* mitems[BatchSize];
+            size_type towrite = items.size();
             size_type written = 0;
-            typename std::vector<T>::const_iterator it;
-            for(  it = items.begin(); it != items.end(); ++it) {
-                if ( this->Push( *it ) == false ) {
-                    break; // will only happen in non-circular case !
+            while ( written != towrite ) {
+                size_type n = towrite - written < size_type(BatchSize) ? towrite - written : size_type(BatchSize);
+                size_type k = mpool.allocate( mitems, n );
+                for (size_type i = 0; i != k; ++i)
+                    *mitems[i] = items[written + i];
+                size_type q = bufs.enqueue( mitems, k );
+                mpool.deallocate( mitems + q, k - q );
+                written += q;
+                if ( q != n ) {
+                    // buffer full: drop the rest, or let Push() make place for it.
+                    if ( !mcircular || this->Push( items[written] ) == false )
+                        break;
+                    ++written;
                 }
-                written++;
             }
             droppedSamples.add(towrite - written);
             return written;
         }
 
-
         bool Pop( reference_t item )
         {
             Item* ipop;
@@ -231,14 +260,25 @@ namespace RTT
 
         size_type Pop(std::vector<T>& items )
         {
-            Item* ipop;
             items.clear();
-            while( bufs.dequeue(ipop) ) {
-                items.push_back( *ipop );
-                if (mpool.deallocate(ipop) == false)
-                    assert(false);
+            return Pop(items, capacity());
+        }
+
+        size_type Pop(std::vector<T>& items, size_type max )
+        {
+            // claims queue positions and releases pool items for a batch at a time.
+            Item* ipop[BatchSize];
+            size_type quant = 0;
+            while ( quant < max ) {
+                size_type k = bufs.dequeue( ipop, max - quant < size_type(BatchSize) ? max - quant : size_type(BatchSize) );
+                if ( k == 0 )
+                    break;
+                for (size_type i = 0; i != k; ++i)
+                    items.push_back( *ipop[i] );
+                mpool.deallocate( ipop, k );
+                quant += k;
             }
-            return items.size();
+            return quant;
         }
         
         value_t* PopWithoutRelease()
@@ -172,6 +172,18 @@ namespace RTT
             return quant;
         }
 
+        size_type Pop(std::vector<T>& items, size_type max )
+        {
+            os::MutexLock locker(lock);
+            int quant = 0;
+            while ( quant < max && !buf.empty() ) {
+                items.push_back( buf.front() );
+                buf.pop_front();
+                ++quant;
+            }
+            return quant;
+        }
+
 	value_t* PopWithoutRelease()
 	{
             os::MutexLock locker(lock);
@@ -54,3 +54,4 @@
 #include "DataObject.hpp"
 #include "DataObjectLockFree.hpp"
 #include "DataObjectLocked.hpp"
+#include "DataObjectSeqLock.hpp"
@@ -41,8 +41,10 @@
 
 #include <boost/intrusive_ptr.hpp>
 #include <boost/call_traits.hpp>
+#include <vector>
 #include "ChannelElementBase.hpp"
 #include "../FlowStatus.hpp"
+#include "../internal/SharedSample.hpp"
 
 namespace RTT { namespace base {
 
@@ -58,6 +60,7 @@ namespace RTT { namespace base {
         typedef boost::intrusive_ptr< ChannelElement<T> > shared_ptr;
         typedef typename boost::call_traits<T>::param_type param_t;
         typedef typename boost::call_traits<T>::reference reference_t;
+        typedef internal::SharedSample<T> shared_sample_t;
 
         shared_ptr getOutput()
         {
@@ -121,6 +124,65 @@ namespace RTT { namespace base {
             else
                 return NoData;
         }
+
+        /** Writes a shared sample on this connection. Storage elements
+         * keep a reference to \a sample instead of copying it. The default
+         * implementation copies the sample with write().
+         *
+         * @returns false if an error occured that requires the channel to be invalidated.
+         */
+        virtual bool writeShared(shared_sample_t const& sample)
+        {
+            return this->write(*sample);
+        }
+
+        /** Reads a shared sample from the connection, without copying it
+         * if the sample was written with writeShared(). The default implementation
+         * reads a copy of the sample into a newly allocated sample, which
+         * is not real-time.
+         */
+        virtual FlowStatus readShared(shared_sample_t& sample, bool copy_old_data)
+        {
+            internal::LoanedSample<T> copy = internal::LoanedSample<T>::create( value_t() );
+            FlowStatus result = this->read(*copy, copy_old_data);
+            if ( result == NewData || (result == OldData && copy_old_data) )
+                sample = copy.share();
+            return result;
+        }
+
+        /** Writes all \a samples in order on this connection. Storage
+         * elements store them in one batch. The default implementation
+         * calls write() for each sample.
+         *
+         * @returns false if an error occured that requires the channel to be invalidated.
+         */
+        virtual bool writeAll(std::vector<value_t> const& samples)
+        {
+            for (typename std::vector<value_t>::const_iterator it = samples.begin(); it != samples.end(); ++it)
+                if ( !this->write(*it) )
+                    return false;
+            return true;
+        }
+
+        /** Reads all new samples from the connection and appends them to
+         * \a samples, oldest first. Storage elements read them in one batch.
+         * The default implementation calls read() until it returns no new
+         * data, which is not real-time for dynamically sized types.
+         *
+         * @return NewData if at least one sample was appended, and
+         * the result of read() otherwise.
+         */
+        virtual FlowStatus readAll(std::vector<value_t>& samples)
+        {
+            value_t sample = value_t();
+            FlowStatus result = this->read(sample, false);
+            if ( result != NewData )
+                return result;
+            do {
+                samples.push_back(sample);
+            } while ( this->read(sample, false) == NewData );
+            return NewData;
+        }
     };
 }}
 
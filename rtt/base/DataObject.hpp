@@ -51,6 +51,8 @@
 #else
 #include "DataObjectLocked.hpp"
 #include "DataObjectLockFree.hpp"
+#include "DataObjectSeqLock.hpp"
+#include <boost/type_traits/has_trivial_copy.hpp>
 #endif
 
 namespace RTT
@@ -88,6 +90,52 @@ namespace RTT
 #endif
         {}
     };
+
+#if !defined(OROBLD_OS_NO_ASM)
+    /**
+     * Selects the lock-free data object for \a T: a DataObjectSeqLock if it
+     * is asked for and \a T is small and trivially copyable, a
+     * DataObjectLockFree otherwise.
+     */
+    template< class T, bool CanSeqLock = boost::has_trivial_copy<T>::value && sizeof(T) <= 64 >
+    struct LockFreeDataObjectBuilder
+    {
+        static DataObjectInterface<T>* build( const T& initial_value, unsigned int max_readers, bool )
+        {
+            return new DataObjectLockFree<T>(initial_value, max_readers);
+        }
+    };
+
+    template< class T >
+    struct LockFreeDataObjectBuilder<T, true>
+    {
+        static DataObjectInterface<T>* build( const T& initial_value, unsigned int max_readers, bool seqlock )
+        {
+            if ( seqlock )
+                return new DataObjectSeqLock<T>(initial_value);
+            return new DataObjectLockFree<T>(initial_value, max_readers);
+        }
+    };
+#endif
+
+    /**
+     * Creates the default thread-safe data object, which is a
+     * DataObjectLockFree that holds max_readers + 2 copies of the data.
+     * @param max_readers The maximum number of threads that read the data
+     * object concurrently.
+     * @param seqlock Use a DataObjectSeqLock instead if \a T is trivially
+     * copyable and at most 64 bytes. This is only safe if a single thread
+     * writes the data object.
+     */
+    template< class T >
+    DataObjectInterface<T>* buildDataObject( const T& initial_value = T(), unsigned int max_readers = 2, bool seqlock = false )
+    {
+#if !defined(OROBLD_OS_NO_ASM)
+        return LockFreeDataObjectBuilder<T>::build(initial_value, max_readers, seqlock);
+#else
+        return new DataObjectLocked<T>(initial_value);
+#endif
+    }
 }}
 
 #endif
@@ -84,9 +84,9 @@ namespace RTT
         typedef T DataType;
 
         /**
-         * @brief The maximum number of threads.
+         * @brief The maximum number of threads that read concurrently.
          *
-         * When used in data flow, this is always 2.
+         * When used in data flow, this is ConnPolicy::max_readers or 2.
          */
         const unsigned int MAX_THREADS; // = 2
     private:
@@ -127,8 +127,9 @@ namespace RTT
         /**
          * Construct a DataObjectLockFree by name.
          *
-         * @param _name The name of this DataObject.
          * @param initial_value The initial value of this DataObject.
+         * @param max_threads The maximum number of threads that read
+         * concurrently. Each one needs its own copy of the data.
          */
         DataObjectLockFree( const T& initial_value = T(), unsigned int max_threads = 2 )
             : MAX_THREADS(max_threads), BUF_LEN( max_threads + 2),
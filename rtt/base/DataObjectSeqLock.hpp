@@ -0,0 +1,134 @@
+/***************************************************************************
+  tag: DataObjectSeqLock.hpp
+
+                        DataObjectSeqLock.hpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef CORELIB_DATAOBJECT_SEQLOCK_HPP
+#define CORELIB_DATAOBJECT_SEQLOCK_HPP
+
+#include "../os/CAS.hpp"
+#include "DataObjectInterface.hpp"
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
+
+namespace RTT
+{ namespace base {
+
+    /**
+     * @brief A single writer DataObject for trivially copyable types,
+     * using a sequence counter instead of per-reader buffers.
+     *
+     * The data is kept in two copies which are written one after the other.
+     * The sequence counter tells the readers which copy is stable, such that
+     * a reader never waits for a preempted writer and only retries when a
+     * Set() completed during its Get(). The number of readers is unlimited
+     * and reading takes no atomic read-modify-write on shared memory.
+     *
+     * Only one thread may Set() at a time, and \a T must be trivially
+     * copyable, since readers may copy a sample while it is being written
+     * and discard that copy afterwards.
+     * @ingroup PortBuffers
+     */
+    template<class T>
+    class DataObjectSeqLock
+        : public DataObjectInterface<T>
+    {
+        BOOST_STATIC_ASSERT( boost::has_trivial_copy<T>::value );
+    public:
+        /**
+         * The type of the data.
+         */
+        typedef T DataType;
+    private:
+        /**
+         * Odd while data[0] is written, even while data[1] is written.
+         * Readers use the other copy.
+         */
+        volatile unsigned int seq;
+        DataType data[2];
+
+        /**
+         * A locked instruction on a private word orders the memory
+         * accesses around it like a full barrier.
+         */
+        static void barrier()
+        {
+            volatile unsigned int word = 0;
+            os::CAS(&word, 0u, 0u);
+        }
+    public:
+        /**
+         * Construct a DataObjectSeqLock with an initial value.
+         *
+         * @param initial_value The initial value of this DataObject.
+         */
+        DataObjectSeqLock( const T& initial_value = T() )
+            : seq(0)
+        {
+            data_sample(initial_value);
+        }
+
+        virtual DataType Get() const { DataType cache; Get(cache); return cache; }
+
+        virtual void Get( DataType& pull ) const
+        {
+            unsigned int start;
+            do {
+                start = seq;
+                barrier();
+                pull = data[start & 1];
+                barrier();
+            } while ( start != seq ); // a Set() completed meanwhile
+        }
+
+        virtual void Set( const DataType& push )
+        {
+            seq = seq + 1;
+            barrier();
+            data[0] = push;
+            barrier();
+            seq = seq + 1;
+            barrier();
+            data[1] = push;
+        }
+
+        virtual void data_sample( const DataType& sample ) {
+            data[0] = sample;
+            data[1] = sample;
+        }
+    };
+}}
+
+#endif
@@ -59,6 +59,7 @@ InputPortInterface::InputPortInterface(std::string const& name, ConnPolicy const
 #else
  , msignal_interface(false)
 #endif
+  , mnewest_only(false), mqueued(0)
 {}
 
 InputPortInterface::~InputPortInterface()
@@ -74,6 +75,12 @@ InputPortInterface::~InputPortInterface()
 ConnPolicy InputPortInterface::getDefaultPolicy() const
 { return default_policy; }
 
+void InputPortInterface::setNewestOnly(bool newest_only)
+{ mnewest_only = newest_only; }
+
+bool InputPortInterface::isNewestOnly() const
+{ return mnewest_only; }
+
 #ifdef ORO_SIGNALLING_PORTS
 InputPortInterface::NewDataOnPortEvent* InputPortInterface::getNewDataOnPortEvent()
 {
@@ -59,6 +59,7 @@ namespace RTT
      */
     class RTT_API InputPortInterface : public PortInterface
     {
+        friend class RTT::TaskContext;
 #ifdef ORO_SIGNALLING_PORTS
     public:
         typedef internal::Signal<void(PortInterface*)> NewDataOnPortEvent;
@@ -77,6 +78,12 @@ namespace RTT
          */
         void signal();
 #endif
+        bool mnewest_only;
+        /**
+         * Set by TaskContext::dataOnPort() while this port waits in
+         * the queue of ports with new data.
+         */
+        volatile int mqueued;
 
         InputPortInterface(const InputPortInterface& orig);
     public:
@@ -152,6 +159,21 @@ namespace RTT
         void signalInterface(bool true_false);
 #endif
 
+        /**
+         * When set, only the newest sample of this port is delivered:
+         * InputPort::read() returns it and drops the older samples that are
+         * still buffered, and the component of this event port is notified
+         * and its callback called at most once per step, however many samples
+         * arrived since the previous step.
+         */
+        void setNewestOnly(bool newest_only);
+
+        /**
+         * Returns true if the component is notified at most once per step
+         * of new data on this port.
+         */
+        bool isNewestOnly() const;
+
         virtual bool connectTo(PortInterface* other, ConnPolicy const& policy);
 
         virtual bool connectTo(PortInterface* other);
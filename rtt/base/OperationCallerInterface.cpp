@@ -21,10 +21,22 @@ void OperationCallerInterface::setOwner(ExecutionEngine* ee) {
     myengine = ee;
 }
 
+namespace {
+    unsigned int send_pool_size = 4;
+}
+
 void OperationCallerInterface::setCaller(ExecutionEngine* ee) {
     caller = ee;
 }
 
+void OperationCallerInterface::setSendPoolSize(unsigned int n) {
+    send_pool_size = n;
+}
+
+unsigned int OperationCallerInterface::getSendPoolSize() {
+    return send_pool_size;
+}
+
 bool OperationCallerInterface::setThread(ExecutionThread et, ExecutionEngine* executor) {
     met = et;
     setOwner(executor);
@@ -51,7 +51,22 @@ namespace RTT
              * @param ee The ExecutionEngine of the component that
              * is calling this operation.
              */
-            void setCaller(ExecutionEngine* ee);
+            virtual void setCaller(ExecutionEngine* ee);
+
+            /**
+             * Sets the number of call records an operation caller
+             * preallocates in setCaller() for sending operations without
+             * allocating memory. Only affects subsequent setCaller() calls.
+             * @param n The number of records. Zero disables the pool and
+             * each send() allocates its own record.
+             */
+            static void setSendPoolSize(unsigned int n);
+
+            /**
+             * Returns the number of call records an operation caller
+             * preallocates in setCaller().
+             */
+            static unsigned int getSendPoolSize();
 
             /**
              * Sets the Thread execution policy of this object.
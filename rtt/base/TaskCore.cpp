@@ -289,6 +289,26 @@ namespace RTT {
         return this->engine()->getActivity() ? this->engine()->getActivity()->setCpuAffinity(cpu) : false;
     }
 
+    bool TaskCore::setQueueSize(unsigned int size, bool growable)
+    {
+        return this->engine()->setQueueSize(size, growable);
+    }
+
+    unsigned int TaskCore::getQueueSize() const
+    {
+        return this->engine()->getQueueSize();
+    }
+
+    unsigned int TaskCore::getRejectedMessages() const
+    {
+        return this->engine()->getRejectedMessages();
+    }
+
+    void TaskCore::setMessageBudget(unsigned int max_messages, Seconds max_time)
+    {
+        this->engine()->setMessageBudget(max_messages, max_time);
+    }
+
     bool TaskCore::configureHook() {
         return true;
     }
@@ -43,6 +43,7 @@
 #include "../rtt-fwd.hpp"
 #include "../rtt-config.h"
 #include "../Time.hpp"
+#include "../os/TimingHistogram.hpp"
 
 namespace RTT
 { namespace base {
@@ -256,6 +257,35 @@ namespace RTT
          */
         virtual bool setCpuAffinity(unsigned cpu);
 
+        /**
+         * Sets the capacity of the message and function queues of
+         * this component's ExecutionEngine.
+         * @param size The number of messages that can be queued in between two steps.
+         * @param growable Allow the queues to grow on overflow instead of
+         * rejecting messages.
+         * @see ExecutionEngine::setQueueSize()
+         */
+        virtual bool setQueueSize(unsigned int size, bool growable);
+
+        /**
+         * Returns the capacity of the message queue of this
+         * component's ExecutionEngine.
+         */
+        virtual unsigned int getQueueSize() const;
+
+        /**
+         * Returns the number of messages which were rejected because
+         * the message queue was full.
+         */
+        virtual unsigned int getRejectedMessages() const;
+
+        /**
+         * Limits the number of messages and the time spent on them in
+         * each step of this component's ExecutionEngine.
+         * @see ExecutionEngine::setMessageBudget()
+         */
+        virtual void setMessageBudget(unsigned int max_messages, Seconds max_time);
+
         /**
          * Inspect if the component is in the FatalError state.
          * There is no possibility to recover from this state.
@@ -321,6 +351,29 @@ namespace RTT
          */
         void setExecutionEngine(ExecutionEngine* engine);
 
+        /**
+         * The execution times of the hooks of a TaskCore, recorded
+         * by the ExecutionEngine which runs it.
+         */
+        struct HookStatistics
+        {
+            os::TimingHistogram prepareUpdateHook;
+            os::TimingHistogram updateHook;
+            os::TimingHistogram errorHook;
+        };
+
+        /**
+         * Returns the execution time statistics of the hooks
+         * of this TaskCore.
+         */
+        HookStatistics& getHookStatistics() { return mhookstats; }
+
+        /**
+         * Returns the execution time statistics of the hooks
+         * of this TaskCore.
+         */
+        const HookStatistics& getHookStatistics() const { return mhookstats; }
+
         /**
          * Get a const pointer to the ExecutionEngine of this Task.
          */
@@ -447,6 +500,11 @@ namespace RTT
 
         TaskState mTaskState;
 
+        /**
+         * Written by the ExecutionEngine, read by getHookStatistics().
+         */
+        HookStatistics mhookstats;
+
     private:
         /**
          * Store the component's initial state here so that we can transition to
@@ -28,7 +28,7 @@ namespace RTT {
         class DataObject;
         template< class T>
         class Buffer;
-        template< class T>
+        template< class T, class Index>
         class BufferLockFree;
         template<class F>
         struct OperationCallerBase;
@@ -43,6 +43,8 @@ namespace RTT {
         template<class T>
         class DataObjectLocked;
         template<class T>
+        class DataObjectSeqLock;
+        template<class T>
         class DataObjectUnSync;
         template<typename T>
         class ChannelElement;
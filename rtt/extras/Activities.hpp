@@ -48,6 +48,7 @@
  */
 #include "SlaveActivity.hpp"
 #include "SequentialActivity.hpp"
+#include "PooledActivity.hpp"
 #include "PeriodicActivity.hpp"
 #include "../Activity.hpp"
 #include "../base/RunnableInterface.hpp"
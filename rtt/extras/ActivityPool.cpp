@@ -0,0 +1,250 @@
+/***************************************************************************
+  tag: ActivityPool.cpp
+
+                        ActivityPool.cpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "ActivityPool.hpp"
+#include "PooledActivity.hpp"
+
+#include "../os/MutexLock.hpp"
+#include "../os/threads.hpp"
+#include <sstream>
+
+namespace RTT {
+    using namespace extras;
+    using os::MutexLock;
+
+    const unsigned int ActivityPool::MAX_ACTIVITIES;
+
+    ActivityPool::ActivityPoolList ActivityPool::ActivityPools;
+
+    namespace {
+        /**
+         * Guards ActivityPool::ActivityPools.
+         */
+        os::Mutex& poolsLock() { static os::Mutex lock; return lock; }
+    }
+
+    /**
+     * A worker thread of the pool.
+     */
+    class ActivityPool::Worker
+        : public os::Thread
+    {
+        ActivityPool* mpool;
+        unsigned int mindex;
+    public:
+        Worker(ActivityPool* pool, unsigned int index, unsigned cpu_affinity, const std::string& name)
+            : os::Thread(pool->mscheduler, pool->mpriority, 0.0, cpu_affinity, name),
+              mpool(pool), mindex(index)
+        {}
+
+        ~Worker()
+        {
+            this->stop();
+        }
+
+        void loop()
+        {
+            mpool->work(mindex);
+        }
+
+        bool breakLoop()
+        {
+            // the pool sets mquit before it stops its workers.
+            return true;
+        }
+    };
+
+    ActivityPoolPtr ActivityPool::Instance(int scheduler, int priority)
+    {
+        os::CheckPriority(scheduler, priority);
+        MutexLock lock( poolsLock() );
+        ActivityPoolList::iterator it = ActivityPools.begin();
+        while ( it != ActivityPools.end() ) {
+            ActivityPoolPtr pptr = it->lock();
+            // detect old pointer.
+            if ( !pptr ) {
+                ActivityPools.erase(it);
+                it = ActivityPools.begin();
+                continue;
+            }
+            if ( pptr->getScheduler() == scheduler && pptr->getPriority() == priority )
+                return pptr;
+            ++it;
+        }
+        ActivityPoolPtr ret( new ActivityPool(scheduler, priority) );
+        ActivityPools.push_back( ret );
+        return ret;
+    }
+
+    ActivityPool::ActivityPool(int scheduler, int priority, unsigned int workers, const std::string& name)
+        : mscheduler(scheduler), mpriority(priority), midle(0), mactivities(0),
+          mnext(0), msleeping(0), mquit(false)
+    {
+        os::CheckPriority(mscheduler, mpriority);
+        unsigned int cpus = os::OnlineProcessors();
+        if (workers == 0)
+            workers = cpus < 2 ? 2 : cpus;
+        for (unsigned int i = 0; i != workers; ++i)
+            mqueues.push_back( new Queue(MAX_ACTIVITIES) );
+        for (unsigned int i = 0; i != workers; ++i) {
+            std::stringstream wname;
+            wname << name << "Worker" << i;
+            // with one worker per processor, each worker keeps its own caches.
+            unsigned cpu_affinity = (workers == cpus && cpus <= 8 * sizeof(unsigned)) ? 1u << i : 0;
+            mworkers.push_back( new Worker(this, i, cpu_affinity, wname.str()) );
+        }
+        midle = new os::Thread(mscheduler, mpriority, 0.0, 0, name);
+        for (unsigned int i = 0; i != workers; ++i)
+            mworkers[i]->start();
+    }
+
+    ActivityPool::~ActivityPool()
+    {
+        {
+            MutexLock lock(mlock);
+            mquit = true;
+            mwork.broadcast();
+        }
+        for (unsigned int i = 0; i != mworkers.size(); ++i)
+            delete mworkers[i];
+        for (unsigned int i = 0; i != mqueues.size(); ++i)
+            delete mqueues[i];
+        delete midle;
+    }
+
+    bool ActivityPool::addActivity()
+    {
+        MutexLock lock(mlock);
+        if ( mactivities.read() == int(MAX_ACTIVITIES) )
+            return false;
+        mactivities.inc();
+        return true;
+    }
+
+    bool ActivityPool::removeActivity()
+    {
+        MutexLock lock(mlock);
+        if ( mactivities.read() == 0 )
+            return false;
+        mactivities.dec();
+        return true;
+    }
+
+    void ActivityPool::schedule( PooledActivity* a )
+    {
+        // a trigger from within a worker stays on that worker.
+        for (unsigned int i = 0; i != mworkers.size(); ++i)
+            if ( mworkers[i]->isSelf() ) {
+                push(i, a);
+                return;
+            }
+        mnext.inc();
+        push( (unsigned int)mnext.read() % mworkers.size(), a );
+    }
+
+    void ActivityPool::push(unsigned int i, PooledActivity* a)
+    {
+        // can not fail: each started activity is queued at most once.
+        mqueues[i]->enqueue(a);
+        if ( msleeping.read() != 0 ) {
+            MutexLock lock(mlock);
+            mwork.broadcast();
+        }
+    }
+
+    PooledActivity* ActivityPool::take(unsigned int i)
+    {
+        PooledActivity* a;
+        for (unsigned int k = 0; k != mqueues.size(); ++k)
+            if ( mqueues[(i + k) % mqueues.size()]->dequeue(a) )
+                return a;
+        return 0;
+    }
+
+    void ActivityPool::work(unsigned int i)
+    {
+        while ( !mquit ) {
+            PooledActivity* a = take(i);
+            if ( a == 0 ) {
+                MutexLock lock(mlock);
+                // push() reads msleeping after it queued, so we check
+                // the queues again after incrementing it.
+                msleeping.inc();
+                while ( !mquit && (a = take(i)) == 0 )
+                    mwork.wait(mlock);
+                msleeping.dec();
+            }
+            if ( a && a->work( mworkers[i] ) )
+                push(i, a);
+        }
+    }
+
+    void ActivityPool::release(PooledActivity* a)
+    {
+        MutexLock lock(mlock);
+        a->mreleased = true;
+        mreleased.broadcast();
+    }
+
+    void ActivityPool::waitRelease(PooledActivity* a)
+    {
+        MutexLock lock(mlock);
+        while ( !a->mreleased )
+            mreleased.wait(mlock);
+        a->mreleased = false;
+    }
+
+    unsigned int ActivityPool::getWorkerCount() const
+    {
+        return mworkers.size();
+    }
+
+    os::ThreadInterface* ActivityPool::idleThread()
+    {
+        return midle;
+    }
+
+    int ActivityPool::getScheduler() const
+    {
+        return mscheduler;
+    }
+
+    int ActivityPool::getPriority() const
+    {
+        return mpriority;
+    }
+}
@@ -0,0 +1,188 @@
+/***************************************************************************
+  tag: ActivityPool.hpp
+
+                        ActivityPool.hpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_ACTIVITY_POOL_HPP
+#define ORO_ACTIVITY_POOL_HPP
+
+#include <vector>
+#include <string>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include "../os/Thread.hpp"
+#include "../os/Mutex.hpp"
+#include "../os/Condition.hpp"
+#include "../os/Atomic.hpp"
+#include "../internal/AtomicMPMCQueue.hpp"
+#include "rtt-extras-fwd.hpp"
+
+namespace RTT
+{ namespace extras {
+
+    typedef boost::shared_ptr<ActivityPool> ActivityPoolPtr;
+
+    /**
+     * A fixed set of worker threads which execute triggered
+     * PooledActivity objects.
+     *
+     * Each worker has its own queue of triggered activities. A trigger
+     * from within a worker is queued on that worker, other triggers are
+     * spread over the workers. A worker which runs out of work steals
+     * from the queues of the other workers before it goes to sleep.
+     * An activity is queued at most once, such that it never runs
+     * in two workers at the same time.
+     *
+     * @see PooledActivity
+     * @ingroup CoreLibActivities
+     */
+    class RTT_API ActivityPool
+    {
+    public:
+        /**
+         * The maximum number of activities that can use one pool.
+         */
+        static const unsigned int MAX_ACTIVITIES = 1024;
+
+        /**
+         * Create a pool and start its workers.
+         * @param scheduler The scheduler of the workers.
+         * @param priority The priority of the workers.
+         * @param workers The number of workers. Zero creates one
+         * worker per online processor, but at least two, such that one
+         * pooled component can wait for another one in the same pool.
+         * @param name The name of the pool, the workers are named after it.
+         */
+        ActivityPool(int scheduler, int priority, unsigned int workers = 0, const std::string& name = "ActivityPool");
+
+        /**
+         * Stops the workers. All activities of this pool must be
+         * stopped first.
+         */
+        ~ActivityPool();
+
+        /**
+         * Returns the shared pool of workers with \a scheduler and \a priority.
+         * It is created if it did not exist yet.
+         */
+        static ActivityPoolPtr Instance(int scheduler, int priority);
+
+        /**
+         * Register a PooledActivity, such that queue space is reserved for it.
+         * @return false if MAX_ACTIVITIES are registered already.
+         */
+        bool addActivity();
+
+        /**
+         * Unregister a PooledActivity. It must not be queued anymore.
+         */
+        bool removeActivity();
+
+        /**
+         * Queue a triggered activity for execution by a worker.
+         * This is only called by a PooledActivity that was not queued yet.
+         */
+        void schedule( PooledActivity* a );
+
+        /**
+         * Returns the number of worker threads.
+         */
+        unsigned int getWorkerCount() const;
+
+        /**
+         * Returns a thread that represents this pool for activities that
+         * are not running. It is never started, such that no thread is
+         * mistaken for the thread of an idle activity.
+         */
+        os::ThreadInterface* idleThread();
+
+        int getScheduler() const;
+
+        int getPriority() const;
+
+    private:
+        class Worker;
+        friend class Worker;
+        friend class PooledActivity;
+        typedef internal::AtomicMPMCQueue<PooledActivity*> Queue;
+
+        /**
+         * The loop of worker \a i, which returns when the pool is destroyed.
+         */
+        void work(unsigned int i);
+
+        /**
+         * Takes the next activity for worker \a i, stealing from the other
+         * workers if its own queue is empty.
+         * @return zero if all queues are empty.
+         */
+        PooledActivity* take(unsigned int i);
+
+        /**
+         * Queue \a a on worker \a i and wake up a sleeping worker.
+         */
+        void push(unsigned int i, PooledActivity* a);
+
+        /**
+         * Called by a worker which hands a stopped activity back to stop()
+         * or PooledActivity::waitWorker().
+         */
+        void release(PooledActivity* a);
+
+        /**
+         * Called by stop() to wait for the worker which runs \a a.
+         */
+        void waitRelease(PooledActivity* a);
+
+        int mscheduler, mpriority;
+        std::vector<Worker*> mworkers;
+        std::vector<Queue*> mqueues;
+        os::Thread* midle;
+        os::AtomicInt mactivities;
+        os::AtomicInt mnext;
+        os::AtomicInt msleeping;
+        volatile bool mquit;
+        os::Mutex mlock;
+        os::Condition mwork;
+        os::Condition mreleased;
+
+        typedef std::vector< boost::weak_ptr<ActivityPool> > ActivityPoolList;
+
+        static ActivityPoolList ActivityPools;
+    };
+}}
+
+#endif
@@ -57,6 +57,10 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#endif
 
 #endif
 
@@ -65,7 +69,9 @@
 using namespace RTT;
 using namespace extras;
 using namespace base;
+#ifndef __linux__
 const char FileDescriptorActivity::CMD_ANY_COMMAND;
+#endif
 
 /**
  * Create a FileDescriptorActivity with a given priority and RunnableInterface
@@ -86,9 +92,7 @@ FileDescriptorActivity::FileDescriptorActivity(int priority, RunnableInterface*
     , m_trigger(false)
     , m_update_sets(false)
 {
-    FD_ZERO(&m_fd_set);
-    FD_ZERO(&m_fd_work);
-    m_interrupt_pipe[0] = m_interrupt_pipe[1] = -1;
+    setup();
 }
 
 /**
@@ -111,9 +115,7 @@ FileDescriptorActivity::FileDescriptorActivity(int scheduler, int priority, Runn
     , m_trigger(false)
     , m_update_sets(false)
 {
-    FD_ZERO(&m_fd_set);
-    FD_ZERO(&m_fd_work);
-    m_interrupt_pipe[0] = m_interrupt_pipe[1] = -1;
+    setup();
 }
 
 FileDescriptorActivity::FileDescriptorActivity(int scheduler, int priority, Seconds period, RunnableInterface* _r, const std::string& name )
@@ -127,9 +129,7 @@ FileDescriptorActivity::FileDescriptorActivity(int scheduler, int priority, Seco
     , m_trigger(false)
     , m_update_sets(false)
 {
-    FD_ZERO(&m_fd_set);
-    FD_ZERO(&m_fd_work);
-    m_interrupt_pipe[0] = m_interrupt_pipe[1] = -1;
+    setup();
 }
 
 FileDescriptorActivity::FileDescriptorActivity(int scheduler, int priority, Seconds period, unsigned cpu_affinity, RunnableInterface* _r, const std::string& name )
@@ -142,6 +142,39 @@ FileDescriptorActivity::FileDescriptorActivity(int scheduler, int priority, Seco
     , m_break_loop(false)
     , m_trigger(false)
     , m_update_sets(false)
+{
+    setup();
+}
+
+#ifdef __linux__
+void FileDescriptorActivity::setup()
+{
+    m_edge_triggered = false;
+    m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    m_event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    m_timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (m_epoll_fd == -1 || m_event_fd == -1 || m_timer_fd == -1)
+    {
+        log(Error) << "FileDescriptorActivity: cannot create epoll, eventfd or timerfd, errno = " << errno << endlog();
+        return;
+    }
+    epoll_event ev = epoll_event();
+    ev.events = EPOLLIN;
+    ev.data.fd = m_event_fd;
+    epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_event_fd, &ev);
+    ev.data.fd = m_timer_fd;
+    epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_timer_fd, &ev);
+}
+
+FileDescriptorActivity::~FileDescriptorActivity()
+{
+    stop();
+    if (m_epoll_fd != -1) close(m_epoll_fd);
+    if (m_event_fd != -1) close(m_event_fd);
+    if (m_timer_fd != -1) close(m_timer_fd);
+}
+#else
+void FileDescriptorActivity::setup()
 {
     FD_ZERO(&m_fd_set);
     FD_ZERO(&m_fd_work);
@@ -152,6 +185,7 @@ FileDescriptorActivity::~FileDescriptorActivity()
 {
     stop();
 }
+#endif
 
 Seconds FileDescriptorActivity::getPeriod() const
 { return m_period; }
@@ -185,6 +219,80 @@ void FileDescriptorActivity::setTimeout_us(int timeout_us)
         log(Error) << "Ignoring invalid timeout (" << timeout_us << ")" << endlog();
     }
 }
+#ifdef __linux__
+bool FileDescriptorActivity::addWatch(int fd)
+{
+    epoll_event ev = epoll_event();
+    ev.events = EPOLLIN;
+    if (m_edge_triggered)
+        ev.events |= EPOLLET;
+    ev.data.fd = fd;
+    int ret = epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+    if (ret == -1 && errno == EEXIST)
+        ret = epoll_ctl(m_epoll_fd, EPOLL_CTL_MOD, fd, &ev);
+    if (ret == -1)
+    {
+        // for example EPERM for regular files, which epoll can not watch.
+        log(Error) << "FileDescriptorActivity: cannot watch file descriptor " << fd << ", errno = " << errno << endlog();
+        return false;
+    }
+    return true;
+}
+
+void FileDescriptorActivity::watch(int fd)
+{ RTT::os::MutexLock lock(m_lock);
+    if (fd < 0)
+    {
+        log(Error) << "negative file descriptor given to FileDescriptorActivity::watch" << endlog();
+        return;
+    }
+
+    // epoll_ctl() takes effect in a running epoll_wait(), loop() need not be woken up.
+    if ( addWatch(fd) )
+        m_watched_fds.insert(fd);
+}
+void FileDescriptorActivity::unwatch(int fd)
+{ RTT::os::MutexLock lock(m_lock);
+    if ( m_watched_fds.erase(fd) )
+        epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, fd, 0);
+}
+void FileDescriptorActivity::clearAllWatches()
+{ RTT::os::MutexLock lock(m_lock);
+    for (std::set<int>::iterator it = m_watched_fds.begin(); it != m_watched_fds.end(); ++it)
+        epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, *it, 0);
+    m_watched_fds.clear();
+}
+void FileDescriptorActivity::triggerUpdateSets()
+{
+    { RTT::os::MutexLock lock(m_command_mutex);
+        m_update_sets = true;
+    }
+    wakeUp();
+}
+void FileDescriptorActivity::wakeUp()
+{
+    boost::uint64_t one = 1;
+    int unused; (void)unused;
+    unused = write(m_event_fd, &one, sizeof(one));
+}
+bool FileDescriptorActivity::isUpdated(int fd) const
+{ return std::find(m_updated.begin(), m_updated.end(), fd) != m_updated.end(); }
+bool FileDescriptorActivity::isWatched(int fd) const
+{ RTT::os::MutexLock lock(m_lock);
+    return m_watched_fds.count(fd) != 0; }
+bool FileDescriptorActivity::setEdgeTriggered(bool edge_triggered)
+{ RTT::os::MutexLock lock(m_lock);
+    if (m_edge_triggered == edge_triggered)
+        return true;
+    m_edge_triggered = edge_triggered;
+    bool result = true;
+    for (std::set<int>::iterator it = m_watched_fds.begin(); it != m_watched_fds.end(); ++it)
+        result = addWatch(*it) && result;
+    return result;
+}
+bool FileDescriptorActivity::isEdgeTriggered() const
+{ return m_edge_triggered; }
+#else
 void FileDescriptorActivity::watch(int fd)
 { RTT::os::MutexLock lock(m_lock);
     if (fd < 0)
@@ -214,19 +322,58 @@ void FileDescriptorActivity::triggerUpdateSets()
     { RTT::os::MutexLock lock(m_command_mutex);
         m_update_sets = true;
     }
+    wakeUp();
+}
+void FileDescriptorActivity::wakeUp()
+{
     int unused; (void)unused;
     unused = write(m_interrupt_pipe[1], &CMD_ANY_COMMAND, 1);
 }
 bool FileDescriptorActivity::isUpdated(int fd) const
 { return FD_ISSET(fd, &m_fd_work); }
+bool FileDescriptorActivity::isWatched(int fd) const
+{ RTT::os::MutexLock lock(m_lock);
+    return FD_ISSET(fd, &m_fd_set); }
+bool FileDescriptorActivity::setEdgeTriggered(bool edge_triggered)
+{ return !edge_triggered; }
+bool FileDescriptorActivity::isEdgeTriggered() const
+{ return false; }
+#endif
 bool FileDescriptorActivity::hasError() const
 { return m_has_error; }
 bool FileDescriptorActivity::hasTimeout() const
 { return m_has_timeout; }
-bool FileDescriptorActivity::isWatched(int fd) const
-{ RTT::os::MutexLock lock(m_lock);
-    return FD_ISSET(fd, &m_fd_set); }
 
+#ifdef __linux__
+bool FileDescriptorActivity::start()
+{
+    if ( isActive() )
+        return false;
+
+    if (m_epoll_fd == -1 || m_event_fd == -1 || m_timer_fd == -1)
+    {
+        log(Error) << "FileDescriptorActivity: no epoll instance to wait on" << endlog();
+        return false;
+    }
+
+    // drop wakeups which were left by a previous run
+    boost::uint64_t count;
+    int unused; (void)unused;
+    unused = read(m_event_fd, &count, sizeof(count));
+
+    // reset flags
+    m_break_loop = false;
+    m_trigger = false;
+    m_update_sets = false;
+
+    if (!Activity::start())
+    {
+        log(Error) << "FileDescriptorActivity: Activity::start() failed" << endlog();
+        return false;
+    }
+    return true;
+}
+#else
 bool FileDescriptorActivity::start()
 {
     if ( isActive() )
@@ -269,6 +416,7 @@ bool FileDescriptorActivity::start()
     }
     return true;
 }
+#endif
 
 bool FileDescriptorActivity::trigger()
 { 
@@ -276,8 +424,7 @@ bool FileDescriptorActivity::trigger()
         { RTT::os::MutexLock lock(m_command_mutex);
             m_trigger = true;
         }
-        int unused; (void)unused;
-        unused = write(m_interrupt_pipe[1], &CMD_ANY_COMMAND, 1);
+        wakeUp();
         return true;
     } else
         return false;
@@ -294,6 +441,97 @@ struct fd_watch {
     }
 };
 
+#ifdef __linux__
+void FileDescriptorActivity::loop()
+{
+    while(true)
+    {
+        { RTT::os::MutexLock lock(m_lock);
+            // room for all watched FDs, the eventfd and the timerfd, such
+            // that every ready FD is reported in one wakeup.
+            if (m_events.size() < m_watched_fds.size() + 2)
+            {
+                m_events.resize(m_watched_fds.size() + 2);
+                m_updated.reserve(m_events.size());
+            }
+        }
+
+        // (re-)arm the one-shot timeout, or disarm it when there is none,
+        // which also discards a pending expiration of a previous timeout.
+        static const int USECS_PER_SEC = 1000000;
+        itimerspec timeout = itimerspec();
+        timeout.it_value.tv_sec  = m_timeout_us / USECS_PER_SEC;
+        timeout.it_value.tv_nsec = (m_timeout_us % USECS_PER_SEC) * 1000;
+        timerfd_settime(m_timer_fd, 0, &timeout, NULL);
+
+        m_running = false;
+        int ret = epoll_wait(m_epoll_fd, &m_events[0], m_events.size(), -1);
+
+        m_has_error   = false;
+        m_has_timeout = false;
+        m_updated.clear();
+        bool timer_expired = false;
+        if (ret == -1)
+        {
+            log(Error) << "FileDescriptorActivity: error in epoll_wait(), errno = " << errno << endlog();
+            m_has_error = true;
+        }
+        boost::uint64_t count;
+        int unused; (void)unused;
+        for (int i = 0; i < ret; ++i)
+        {
+            int fd = m_events[i].data.fd;
+            if (fd == m_event_fd)
+                // breakLoop or trigger requests, all of them are read at once.
+                unused = read(m_event_fd, &count, sizeof(count));
+            else if (fd == m_timer_fd)
+                // fails if the timer was re-armed or disarmed since it expired.
+                timer_expired = read(m_timer_fd, &count, sizeof(count)) == sizeof(count);
+            else
+                m_updated.push_back(fd);
+        }
+        if (timer_expired && ret == 1)
+        {
+            log(Error) << "FileDescriptorActivity: timeout in epoll_wait()" << endlog();
+            m_has_timeout = true;
+        }
+
+        // We check the flags after the eventfd was read as we could miss commands otherwise:
+        bool do_trigger = true;
+        { RTT::os::MutexLock lock(m_command_mutex);
+            // This section should be really fast to not block threads calling trigger(), breakLoop() or watch().
+            if (m_trigger) {
+                do_trigger = true;
+                m_trigger = false;
+            }
+            if (m_update_sets) {
+                m_update_sets = false;
+                do_trigger = false;
+            }
+            if (m_break_loop) {
+                m_break_loop = false;
+                break;
+            }
+        }
+
+        if (do_trigger)
+        {
+            try
+            {
+                m_running = true;
+                step();
+                m_running = false;
+            }
+            catch(...)
+            {
+                m_running = false;
+                throw;
+            }
+        }
+    }
+    m_updated.clear();
+}
+#else
 void FileDescriptorActivity::loop()
 {
     int pipe = m_interrupt_pipe[0];
@@ -396,14 +634,14 @@ void FileDescriptorActivity::loop()
         }
     }
 }
+#endif
 
 bool FileDescriptorActivity::breakLoop()
 {
     { RTT::os::MutexLock lock(m_command_mutex);
         m_break_loop = true;
     }
-    int unused; (void)unused;
-    unused = write(m_interrupt_pipe[1], &CMD_ANY_COMMAND, 1);
+    wakeUp();
     return true;
 }
 
@@ -425,8 +663,10 @@ bool FileDescriptorActivity::stop()
     // quit)
     if ( Activity::stop() == true )
     {
+#ifndef __linux__
         fd_watch watch_pipe_0(m_interrupt_pipe[0]);
         fd_watch watch_pipe_1(m_interrupt_pipe[1]);
+#endif
         return true;
     }
     return false;
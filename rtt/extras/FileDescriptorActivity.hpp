@@ -42,6 +42,11 @@
 #include "FileDescriptorActivityInterface.hpp"
 #include "../Activity.hpp"
 #include <set>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 
 namespace RTT { namespace extras {
 
@@ -100,23 +105,53 @@ namespace RTT { namespace extras {
      *   }
      * }
      * </code>
+     *
+     * On Linux, the activity waits with epoll(), so there is no limit on the
+     * value of the watched file descriptors and the cost of a wakeup does
+     * not depend on the number of watched file descriptors. All file
+     * descriptors that are ready are reported in one wakeup. They can be
+     * watched in edge-triggered mode with setEdgeTriggered(). epoll() can
+     * not watch regular files: watch() logs an error and ignores them. On other
+     * platforms, select() is used.
      */
     class RTT_API FileDescriptorActivity : public extras::FileDescriptorActivityInterface,
                                            public Activity
     {
         std::set<int> m_watched_fds;
         bool m_running;
-        int  m_interrupt_pipe[2];
         int  m_timeout_us;		//! timeout in microseconds
         Seconds m_period;		//! intended period
         /** Lock that protects the access to m_fd_set and m_watched_fds */
         mutable RTT::os::Mutex m_lock;
+#ifdef __linux__
+        /** The epoll instance, the eventfd which interrupts it and the
+         * timerfd which implements the timeout. They live as long as
+         * this activity.
+         */
+        int  m_epoll_fd;
+        int  m_event_fd;
+        int  m_timer_fd;
+        bool m_edge_triggered;
+        /** The events of one epoll_wait(), with room for all watched FDs */
+        std::vector<epoll_event> m_events;
+        /** The FDs which were ready in the last wakeup */
+        std::vector<int> m_updated;
+
+        /**
+         * Registers \a fd in the epoll instance, with m_lock held.
+         * @return false if epoll can not watch \a fd, which is logged.
+         */
+        bool addWatch(int fd);
+#else
+        int  m_interrupt_pipe[2];
         fd_set m_fd_set;
         fd_set m_fd_work;
+
+        static const char CMD_ANY_COMMAND = 0;
+#endif
         bool m_has_error;
         bool m_has_timeout;
 
-        static const char CMD_ANY_COMMAND = 0;
         RTT::os::Mutex m_command_mutex;
         bool m_break_loop;
         bool m_trigger;
@@ -127,6 +162,12 @@ namespace RTT { namespace extras {
          */
         void triggerUpdateSets();
 
+        /** Wakes up loop() to process the command flags */
+        void wakeUp();
+
+        /** Initializes the members, called from all constructors */
+        void setup();
+
     public:
         /**
          * Create a FileDescriptorActivity with a given priority and base::RunnableInterface
@@ -274,6 +315,21 @@ namespace RTT { namespace extras {
          */
         int getTimeout_us() const;
 
+        /** Watches the FDs in edge-triggered mode, in which a FD is only
+         * reported again when new data arrives. step() must then read all
+         * the available data of each updated FD. This is only supported
+         * by the epoll() implementation on Linux.
+         *
+         * This method is thread-safe, i.e. it can be called from any thread
+         *
+         * @return false if edge-triggered mode is not supported, or
+         * if a watched FD could not be switched to it.
+         */
+        bool setEdgeTriggered(bool edge_triggered);
+
+        /** True if the FDs are watched in edge-triggered mode */
+        bool isEdgeTriggered() const;
+
         virtual bool start();
         virtual void loop();
         virtual bool breakLoop();
@@ -95,9 +95,13 @@ namespace RTT {
     PeriodicActivity::~PeriodicActivity()
     {
         stop();
+        if ( thread_ )
+            thread_->removeDependencies( this );
     }
 
     void PeriodicActivity::init() {
+        deadline = 0;
+        overruns = 0;
     }
 
     bool PeriodicActivity::start()
@@ -206,6 +210,27 @@ namespace RTT {
 
     os::ThreadInterface* PeriodicActivity::thread() { return thread_.get(); }
 
+    TimerThreadPtr PeriodicActivity::getTimerThread() const { return thread_; }
+
+    bool PeriodicActivity::setDeadline(Seconds d) {
+        if ( d < 0 )
+            return false;
+        deadline = Seconds_to_nsecs(d);
+        if ( thread_ )
+            thread_->updateSchedule();
+        return true;
+    }
+
+    Seconds PeriodicActivity::getDeadline() const {
+        if ( deadline == 0 )
+            return getPeriod();
+        return nsecs_to_Seconds(deadline);
+    }
+
+    unsigned int PeriodicActivity::getOverruns() const {
+        return overruns;
+    }
+
     bool PeriodicActivity::isPeriodic() const {
         return true;
     }
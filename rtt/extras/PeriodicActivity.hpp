@@ -192,6 +192,31 @@ namespace RTT
 
         virtual os::ThreadInterface* thread();
 
+        /**
+         * Returns the thread which runs this activity.
+         */
+        TimerThreadPtr getTimerThread() const;
+
+        /**
+         * Set the time after the start of each period before which
+         * step() should have returned. It orders the activities in the
+         * TimerThread::DeadlineOrder and counts getOverruns().
+         * @param d The deadline, or zero for the period of the thread.
+         * @return false if \a d is negative.
+         */
+        bool setDeadline(Seconds d);
+
+        /**
+         * Returns the deadline of this activity, which is by
+         * default the period of the thread.
+         */
+        Seconds getDeadline() const;
+
+        /**
+         * Returns the number of times step() returned after the deadline.
+         */
+        unsigned int getOverruns() const;
+
         /**
          * @see base::RunnableInterface::initialize()
          */
@@ -208,6 +233,8 @@ namespace RTT
         virtual void finalize();
 
     protected:
+        friend class TimerThread;
+
         void init();
 
         /**
@@ -224,6 +251,16 @@ namespace RTT
          * The thread which runs this activity.
          */
         TimerThreadPtr thread_;
+
+        /**
+         * The deadline in nanoseconds, or zero for the period.
+         */
+        nsecs deadline;
+
+        /**
+         * Counted by the TimerThread.
+         */
+        unsigned int overruns;
     };
 
 }}
@@ -0,0 +1,252 @@
+/***************************************************************************
+  tag: PooledActivity.cpp
+
+                        PooledActivity.cpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PooledActivity.hpp"
+#include "../os/CAS.hpp"
+#include "../os/threads.hpp"
+#include "../Logger.hpp"
+
+namespace RTT {
+    using namespace extras;
+    using namespace base;
+
+    PooledActivity::PooledActivity( RunnableInterface* run /*= 0*/ )
+        : ActivityInterface(run), mpool( ActivityPool::Instance(ORO_SCHED_OTHER, os::LowestPriority) ),
+          active(false), mtriggers(0), mworker(0), mreleased(false)
+    {
+    }
+
+    PooledActivity::PooledActivity( int scheduler, int priority, RunnableInterface* run /*= 0*/ )
+        : ActivityInterface(run), mpool( ActivityPool::Instance(scheduler, priority) ),
+          active(false), mtriggers(0), mworker(0), mreleased(false)
+    {
+    }
+
+    PooledActivity::PooledActivity( ActivityPoolPtr pool, RunnableInterface* run /*= 0*/ )
+        : ActivityInterface(run), mpool(pool),
+          active(false), mtriggers(0), mworker(0), mreleased(false)
+    {
+    }
+
+    PooledActivity::~PooledActivity()
+    {
+        stop();
+        // a worker may still run us after a stop() from within step().
+        waitWorker();
+    }
+
+    ActivityPoolPtr PooledActivity::getPool() const
+    {
+        return mpool;
+    }
+
+    Seconds PooledActivity::getPeriod() const
+    {
+        return 0.0;
+    }
+
+    bool PooledActivity::setPeriod(Seconds s) {
+        if ( s == 0.0)
+            return true;
+        return false;
+    }
+
+    unsigned PooledActivity::getCpuAffinity() const
+    {
+        return ~0;
+    }
+
+    bool PooledActivity::setCpuAffinity(unsigned)
+    {
+        return false;
+    }
+
+    os::ThreadInterface* PooledActivity::thread()
+    {
+        os::ThreadInterface* w = mworker;
+        return w ? w : mpool->idleThread();
+    }
+
+    bool PooledActivity::initialize()
+    {
+        return true;
+    }
+
+    void PooledActivity::step()
+    {
+    }
+
+    bool PooledActivity::breakLoop()
+    {
+        return false;
+    }
+
+    void PooledActivity::finalize()
+    {
+    }
+
+    bool PooledActivity::start()
+    {
+        if (active == true )
+            return false;
+
+        // restarted from within step(): the worker that runs us keeps us.
+        os::ThreadInterface* w = mworker;
+        if ( w != 0 && w->isSelf() ) {
+            int old;
+            do {
+                old = mtriggers;
+            } while ( !os::CAS(&mtriggers, old, old & ~StopFlag) );
+        } else
+            waitWorker();
+
+        if ( !mpool->addActivity() ) {
+            log(Error) << "PooledActivity: can not start more than " << ActivityPool::MAX_ACTIVITIES
+                       << " activities in one ActivityPool." << endlog();
+            return false;
+        }
+
+        active = true;
+
+        if ( runner ? runner->initialize() : this->initialize() ) {
+        } else {
+            active = false;
+            mpool->removeActivity();
+        }
+        return active;
+    }
+
+    bool PooledActivity::stop()
+    {
+        if ( !active )
+            return false;
+
+        active = false;
+
+        // A worker which finds the stop flag hands us back with release().
+        // Wait for that, unless stop() is called from within step(). Then
+        // the worker hands us back after step() returns and waitWorker()
+        // waits for it.
+        os::ThreadInterface* w = mworker;
+        bool self = w != 0 && w->isSelf();
+        int old;
+        do {
+            old = mtriggers;
+        } while ( !os::CAS(&mtriggers, old, old | StopFlag) );
+        if ( old != 0 && !self )
+            mpool->waitRelease(this);
+
+        if (runner)
+            runner->finalize();
+        else
+            this->finalize();
+        if ( old == 0 || !self )
+            mtriggers = 0;
+        mpool->removeActivity();
+        return true;
+    }
+
+    void PooledActivity::waitWorker()
+    {
+        if ( mtriggers & StopFlag ) {
+            mpool->waitRelease(this);
+            mtriggers = 0;
+        }
+    }
+
+    bool PooledActivity::isRunning() const
+    {
+        return active;
+    }
+
+    bool PooledActivity::isPeriodic() const
+    {
+        return false;
+    }
+
+    bool PooledActivity::isActive() const
+    {
+        return active;
+    }
+
+    bool PooledActivity::trigger()
+    {
+        if ( !active )
+            return false;
+        // Only the first trigger queues us. The worker steps again for
+        // triggers that arrive while we are queued or running.
+        int old;
+        do {
+            old = mtriggers;
+        } while ( !os::CAS(&mtriggers, old, old + 1) );
+        if ( old == 0 )
+            mpool->schedule(this);
+        return true;
+    }
+
+    bool PooledActivity::execute()
+    {
+        return false;
+    }
+
+    bool PooledActivity::work(os::ThreadInterface* w)
+    {
+        int n = mtriggers;
+        if ( active && !(n & StopFlag) ) {
+            mworker = w;
+            if (runner) runner->step(); else this->step();
+            bool again = active && runner && runner->hasWork();
+            mworker = 0;
+            if ( again )
+                return true;
+        }
+        while ( true ) {
+            int m = mtriggers;
+            if ( m & StopFlag ) {
+                // stop() is waiting for us.
+                mpool->release(this);
+                return false;
+            }
+            // triggered while we were running: step again, after
+            // the other activities in the queue.
+            if ( m != n )
+                return true;
+            if ( os::CAS(&mtriggers, n, 0) )
+                return false;
+        }
+    }
+}
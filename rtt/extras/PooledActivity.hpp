@@ -0,0 +1,185 @@
+/***************************************************************************
+  tag: PooledActivity.hpp
+
+                        PooledActivity.hpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_POOLED_ACTIVITY_HPP
+#define ORO_POOLED_ACTIVITY_HPP
+
+#include "../base/ActivityInterface.hpp"
+#include "../base/RunnableInterface.hpp"
+#include "ActivityPool.hpp"
+
+namespace RTT
+{ namespace extras {
+
+
+    /**
+     * @brief A non periodic activity which is executed by a shared pool
+     * of worker threads instead of by a thread of its own.
+     *
+     * Use this activity for the many components that only react to
+     * events, such as new data on event ports or operation calls, and
+     * are idle otherwise. All PooledActivity objects with the same
+     * scheduler and priority share one ActivityPool, which has one worker
+     * per processor. A component is never executed by two workers at the
+     * same time, and triggers that arrive while it is being executed cause
+     * one more step(), such that no event is lost and messages are still
+     * processed in FIFO order.
+     *
+     * A component that blocks, for example in a synchronous call to an
+     * operation of another component in the same pool, blocks a worker of
+     * the pool. The pool has at least two workers, but many concurrently
+     * blocking components may stall it.
+     *
+     * \section ExecReact Reactions to execute():
+     * Always returns false.
+     *
+     * \section TrigReact Reactions to trigger():
+     * This causes step() to be executed by a worker of the pool.
+     *
+     * @ingroup CoreLibActivities
+     */
+    class RTT_API PooledActivity
+        :public base::ActivityInterface
+    {
+    public:
+        /**
+         * Create an activity in the shared pool of workers with the
+         * lowest, non real-time priority.
+         * @param run Run this instance.
+         */
+        PooledActivity( base::RunnableInterface* run = 0 );
+
+        /**
+         * Create an activity in the shared pool of workers with the given
+         * \a scheduler and \a priority.
+         * @param run Run this instance.
+         */
+        PooledActivity( int scheduler, int priority, base::RunnableInterface* run = 0 );
+
+        /**
+         * Create an activity in a given \a pool of workers.
+         * @param run Run this instance.
+         */
+        PooledActivity( ActivityPoolPtr pool, base::RunnableInterface* run = 0 );
+
+        /**
+         * Cleanup and notify the base::RunnableInterface that we are gone.
+         * Waits until no worker runs this activity anymore, so it must not
+         * be destroyed from within its own step().
+         */
+        ~PooledActivity();
+
+        /**
+         * Returns the pool of workers that executes this activity.
+         */
+        ActivityPoolPtr getPool() const;
+
+        Seconds getPeriod() const;
+
+        bool setPeriod(Seconds s);
+
+        unsigned getCpuAffinity() const;
+
+        bool setCpuAffinity(unsigned cpu);
+
+        /**
+         * Returns the worker which is executing this activity, or
+         * ActivityPool::idleThread() if no worker is executing it.
+         */
+        os::ThreadInterface* thread();
+
+        bool initialize();
+        void step();
+        bool breakLoop();
+        void finalize();
+
+        bool start();
+
+        bool stop();
+
+        bool isRunning() const;
+
+        bool isPeriodic() const;
+
+        bool isActive() const;
+
+        bool execute();
+
+        bool trigger();
+    private:
+        friend class ActivityPool;
+
+        /**
+         * Executed by worker \a w of the pool.
+         * @return true if this activity must be queued again.
+         */
+        bool work(os::ThreadInterface* w);
+
+        /**
+         * Waits until the worker hands us back after a stop() from
+         * within step(). Returns at once if no worker runs us.
+         */
+        void waitWorker();
+
+        /**
+         * Set by stop() in mtriggers, such that a worker hands us back
+         * instead of stepping or queueing us again.
+         */
+        static const int StopFlag = 1 << 30;
+
+        ActivityPoolPtr mpool;
+        volatile bool active;
+        /**
+         * The number of triggers since this activity was queued,
+         * or zero if it is not queued nor running.
+         */
+        volatile int mtriggers;
+        /**
+         * The worker which is executing this activity, if any.
+         */
+        os::ThreadInterface* volatile mworker;
+        /**
+         * Set by a worker which hands a stopped activity back to stop()
+         * or waitWorker().
+         */
+        bool mreleased;
+    };
+
+}}
+
+
+#endif
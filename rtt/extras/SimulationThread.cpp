@@ -138,6 +138,13 @@ namespace RTT {
         return os::MainThread::Instance();
     }
 
+    bool SimulationThread::isStepping() const
+    {
+        if ( sim_running )
+            return os::MainThread::Instance()->isSelf();
+        return TimerThread::isStepping();
+    }
+
     bool SimulationThread::initialize()
     {
         Logger::In in("SimulationThread");
@@ -121,6 +121,10 @@ namespace RTT
         bool initialize();
         void step();
         void finalize();
+        /**
+         * run() executes step() in the simthread().
+         */
+        bool isStepping() const;
 
         /**
          * Constructor
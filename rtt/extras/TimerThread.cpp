@@ -45,6 +45,9 @@
 #include <algorithm>
 #include "../os/MutexLock.hpp"
 #include "../os/MainThread.hpp"
+#include "../os/TimeService.hpp"
+#include "../os/CAS.hpp"
+#include <cassert>
 
 namespace RTT {
     using namespace extras;
@@ -93,15 +96,27 @@ namespace RTT {
     }
 
     TimerThread::TimerThread(int priority, const std::string& name, double periodicity, unsigned cpu_affinity)
-        : Thread( ORO_SCHED_RT, priority, periodicity, cpu_affinity, name), cleanup(false)
+        : Thread( ORO_SCHED_RT, priority, periodicity, cpu_affinity, name),
+          order(InsertionOrder), changed(false), current(0), waiting(0)
     {
     	tasks.reserve(MAX_ACTIVITIES);
+    	schedule.reserve(MAX_ACTIVITIES);
     }
 
     TimerThread::TimerThread(int scheduler, int priority, const std::string& name, double periodicity, unsigned cpu_affinity)
-        : Thread(scheduler, priority, periodicity, cpu_affinity, name), cleanup(false)
+        : Thread(scheduler, priority, periodicity, cpu_affinity, name),
+          order(InsertionOrder), changed(false), current(0), waiting(0)
     {
     	tasks.reserve(MAX_ACTIVITIES);
+    	schedule.reserve(MAX_ACTIVITIES);
+    }
+
+    TimerThread::TimerThread(int scheduler, int priority, const std::string& name, double periodicity, const os::ThreadProfile& profile)
+        : Thread(scheduler, priority, periodicity, profile, name),
+          order(InsertionOrder), changed(false), current(0), waiting(0)
+    {
+    	tasks.reserve(MAX_ACTIVITIES);
+    	schedule.reserve(MAX_ACTIVITIES);
     }
 
     TimerThread::~TimerThread()
@@ -117,22 +132,96 @@ namespace RTT {
             return false;
         }
         tasks.push_back( t );
+        changed = true;
 //         Logger::log() << Logger::Debug << "TimerThread : successfully started Activity : "<< t  << Logger::endl;
         return true;
     }
 
     bool TimerThread::removeActivity( PeriodicActivity* t ) {
+        {
+            MutexLock lock(mutex);
+            ActivityList::iterator it = find(tasks.begin(), tasks.end(), t);
+            if ( it == tasks.end() ) {
+//             Logger::log() << Logger::Debug << "TimerThread : failed to stop Activity : "<< t->getPeriod() << Logger::endl;
+                return false;
+            }
+            tasks.erase(it);
+            // step() re-reads the slot after publishing current, so either it
+            // sees the cleared slot, or we see that it is executing t.
+            for (ActivityList::iterator s_iter = schedule.begin(); s_iter != schedule.end(); ++s_iter)
+                if ( *s_iter == t )
+                    os::CAS(&*s_iter, t, (PeriodicActivity*)0);
+            changed = true;
+        }
+        if ( this->isStepping() )
+            return true; // removed from within step() or finalize().
+        MutexLock lock(waitlock);
+        waiting.inc();
+        while ( current == t )
+            stepped.wait(waitlock);
+        waiting.dec();
+        return true;
+    }
+
+    void TimerThread::setScheduleOrder( ScheduleOrder o ) {
         MutexLock lock(mutex);
-        ActivityList::iterator it = find(tasks.begin(), tasks.end(), t);
-        if ( it != tasks.end() ) {
-            *it = 0; // clear task away
-            cleanup = true;
+        order = o;
+        changed = true;
+    }
+
+    TimerThread::ScheduleOrder TimerThread::getScheduleOrder() const {
+        return order;
+    }
+
+    bool TimerThread::precedes( PeriodicActivity* a, PeriodicActivity* b ) const {
+        if ( a == b )
             return true;
-        }
-//         Logger::log() << Logger::Debug << "TimerThread : failed to stop Activity : "<< t->getPeriod() << Logger::endl;
+        for( DependencyList::const_iterator d = dependencies.begin(); d != dependencies.end(); ++d)
+            if ( d->first == a && precedes( d->second, b ) )
+                return true;
         return false;
     }
 
+    bool TimerThread::addDependency( PeriodicActivity* writer, PeriodicActivity* reader ) {
+        MutexLock lock(mutex);
+        // refuse cycles, such that DependencyOrder always exists.
+        if ( precedes( reader, writer ) )
+            return false;
+        dependencies.push_back( std::make_pair(writer, reader) );
+        changed = true;
+        return true;
+    }
+
+    bool TimerThread::removeDependency( PeriodicActivity* writer, PeriodicActivity* reader ) {
+        MutexLock lock(mutex);
+        DependencyList::iterator it = find(dependencies.begin(), dependencies.end(), std::make_pair(writer, reader));
+        if ( it == dependencies.end() )
+            return false;
+        dependencies.erase(it);
+        changed = true;
+        return true;
+    }
+
+    void TimerThread::removeDependencies( PeriodicActivity* t ) {
+        MutexLock lock(mutex);
+        DependencyList::iterator it = dependencies.begin();
+        while ( it != dependencies.end() ) {
+            if ( it->first == t || it->second == t )
+                it = dependencies.erase(it);
+            else
+                ++it;
+        }
+        changed = true;
+    }
+
+    void TimerThread::updateSchedule() {
+        changed = true;
+    }
+
+    bool TimerThread::isStepping() const {
+        return this->isSelf();
+    }
+
     bool TimerThread::initialize() {
     	return true;
     }
@@ -140,57 +229,71 @@ namespace RTT {
     void TimerThread::finalize() {
         MutexLock lock(mutex);
 
-        for( ActivityList::iterator t_iter = tasks.begin(); t_iter != tasks.end(); ++t_iter)
-            if ( *t_iter )
-                (*t_iter)->stop(); // stop() calls us back to removeActivity (recursive mutex).
-        if ( cleanup )
-            this->reorderList();
+        // stop() calls us back to removeActivity (recursive mutex), which erases from tasks.
+        ActivityList copy( tasks );
+        for( ActivityList::iterator t_iter = copy.begin(); t_iter != copy.end(); ++t_iter)
+            (*t_iter)->stop();
     }
 
     void TimerThread::step() {
-        MutexLock lock(mutex);
-
-        // The size of the tasks vector does not change during add/remove, thus
-        // t_iter is never invalidated.
-        for( ActivityList::iterator t_iter = tasks.begin(); t_iter != tasks.end(); ++t_iter)
-        	if ( *t_iter )
-        		(*t_iter)->step();
-
-        if ( cleanup )
+        if ( changed ) {
+            MutexLock lock(mutex);
             this->reorderList();
+        }
+
+        nsecs start = os::TimeService::Instance()->getNSecs();
+        // Only this thread resizes schedule, removeActivity() only clears slots.
+        for( ActivityList::size_type i = 0; i != schedule.size(); ++i) {
+            PeriodicActivity* t = schedule[i];
+            if ( t == 0 )
+                continue;
+            os::CAS(&current, (PeriodicActivity*)0, t);
+            if ( schedule[i] == t ) {
+                t->step();
+                nsecs deadline = t->deadline ? t->deadline : this->getPeriodNS();
+                if ( os::TimeService::Instance()->getNSecs() - start > deadline )
+                    ++t->overruns;
+            }
+            os::CAS(&current, t, (PeriodicActivity*)0);
+            if ( waiting.read() != 0 ) {
+                MutexLock lock(waitlock);
+                stepped.broadcast();
+            }
+        }
     }
 
     void TimerThread::reorderList() {
-        // reorder the list to remove clear'ed tasks
-        ActivityList::iterator begin = tasks.begin();
-        // first zero :
-        PeriodicActivity* nullActivity = 0;
-        ActivityList::iterator it = tasks.begin();
-
-        it = find( tasks.begin(), tasks.end(), nullActivity); // First zero
-        begin = it+1;
-        while ( it != tasks.end() ) {
-            // Look for first non-zero after 'it' :
-            while ( begin != tasks.end() &&  *begin == 0  )
-                ++begin;
-            if ( begin == tasks.end() )  { // if no task found after zero :
-//                 Logger::log() << Logger::Error << "beginBefore resize :"<< tasks.size() << Logger::endl;
-                tasks.resize( it - tasks.begin() ); // cut out the items after 'it'
-//                 Logger::log() << Logger::Error << "beginAfter resize :"<< tasks.size() << Logger::endl;
-                break; // This is our exit condition !
+        changed = false;
+        schedule = tasks;
+        if ( order == DeadlineOrder ) {
+            // stable insertion sort, which does not allocate.
+            for (ActivityList::size_type i = 1; i < schedule.size(); ++i) {
+                PeriodicActivity* t = schedule[i];
+                ActivityList::size_type j = i;
+                for (; j != 0 && schedule[j-1]->getDeadline() > t->getDeadline(); --j)
+                    schedule[j] = schedule[j-1];
+                schedule[j] = t;
             }
-            // first zero after begin :
-            ActivityList::iterator end = find ( begin, tasks.end(), nullActivity);
-            // if end == tasks.end() ==> next while will copy all
-            // if end != tasks.end() ==> next while will copy first zero's
-            while ( begin != end ) {
-                *it = *begin; // copy operation
-                ++begin;
-                ++it; // go to next slot to inspect.
+        } else if ( order == DependencyOrder ) {
+            // repeatedly take the first activity of which all writers were taken.
+            for (ActivityList::size_type done = 0; done != schedule.size(); ++done) {
+                ActivityList::size_type i = done;
+                for (; i != schedule.size(); ++i) {
+                    bool ready = true;
+                    for( DependencyList::const_iterator d = dependencies.begin(); ready && d != dependencies.end(); ++d)
+                        if ( d->second == schedule[i] && find(schedule.begin() + done, schedule.end(), d->first) != schedule.end() )
+                            ready = false;
+                    if ( ready )
+                        break;
+                }
+                // there are no cycles, so some activity is always ready.
+                assert( i != schedule.size() );
+                PeriodicActivity* t = schedule[i];
+                for (; i != done; --i)
+                    schedule[i] = schedule[i-1];
+                schedule[done] = t;
             }
         }
-
-        cleanup = false;
     }
 
 
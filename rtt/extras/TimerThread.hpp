@@ -48,6 +48,8 @@
 
 #include "../os/Thread.hpp"
 #include "../os/Mutex.hpp"
+#include "../os/Condition.hpp"
+#include "../os/Atomic.hpp"
 #include "rtt-extras-fwd.hpp"
 
 namespace RTT
@@ -64,16 +66,43 @@ namespace RTT
      * This Periodic Thread is meant for executing a PeriodicActivity
      * object periodically.
      *
+     * The activities are executed one after the other, in the order
+     * selected with setScheduleOrder(). The order is recomputed in step()
+     * after activities or dependencies were added or removed. Apart from
+     * that, step() does not lock, such that threads that add or remove
+     * activities never delay it.
+     *
      * @see PeriodicActivity
      */
     class RTT_API TimerThread
         : public os::Thread
     {
         typedef std::vector<PeriodicActivity*> ActivityList ;
+        typedef std::vector< std::pair<PeriodicActivity*, PeriodicActivity*> > DependencyList;
+        /**
+         * The added activities, in the order they were added.
+         */
         ActivityList tasks;
-        bool cleanup;
+        /**
+         * The activities in the order step() executes them. Only
+         * the thread executing step() resizes it.
+         */
+        ActivityList schedule;
+        /**
+         * The (writer, reader) pairs of addDependency().
+         */
+        DependencyList dependencies;
     public:
     	static const unsigned int MAX_ACTIVITIES = 64;
+
+        /**
+         * The orders in which step() can execute the activities:
+         * the order in which they were added, writers before readers
+         * (see addDependency()) and otherwise the order in which they were
+         * added, or earliest deadline first (see PeriodicActivity::setDeadline()).
+         */
+        enum ScheduleOrder { InsertionOrder, DependencyOrder, DeadlineOrder };
+
         /**
          * Create a periodic Timer thread.
          *
@@ -96,6 +125,21 @@ namespace RTT
          */
         TimerThread(int scheduler, int priority, const std::string& name, double periodicity, unsigned cpu_affinity = ~0);
 
+        /**
+         * Create a periodic Timer thread with a given scheduler type
+         * and thread profile.
+         *
+         * @param scheduler
+         *        The scheduler in which this thread runs
+         * @param priority
+         *        The priority of this thread within \a scheduler
+         * @param periodicity
+         *        The periodicity of this thread in seconds (e.g. 0.001 = 1000Hz )
+         * @param profile
+         *        The CPU set, memory and deadline scheduling settings of this thread
+         */
+        TimerThread(int scheduler, int priority, const std::string& name, double periodicity, const os::ThreadProfile& profile);
+
         /**
          * Destructor
          */
@@ -107,8 +151,40 @@ namespace RTT
          */
         bool addActivity( PeriodicActivity* t );
 
+        /**
+         * Remove an activity. When this function returns, \a t
+         * is not executed anymore.
+         */
         bool removeActivity( PeriodicActivity* t );
 
+        /**
+         * Select the order in which the activities are executed.
+         * The default is InsertionOrder.
+         */
+        void setScheduleOrder( ScheduleOrder order );
+
+        ScheduleOrder getScheduleOrder() const;
+
+        /**
+         * Declare that \a reader reads data that \a writer writes, such that
+         * \a writer is executed first in DependencyOrder.
+         * @return false if \a writer already depends on \a reader.
+         */
+        bool addDependency( PeriodicActivity* writer, PeriodicActivity* reader );
+
+        bool removeDependency( PeriodicActivity* writer, PeriodicActivity* reader );
+
+        /**
+         * Remove all dependencies of \a t, as a writer and as a reader.
+         */
+        void removeDependencies( PeriodicActivity* t );
+
+        /**
+         * Recompute the order of the activities before the next step,
+         * for example because a deadline changed.
+         */
+        void updateSchedule();
+
         /**
          * Create a TimerThread with a given priority and periodicity,
          * using the default scheduler, ORO_SCHED_RT.
@@ -126,12 +202,41 @@ namespace RTT
         virtual bool initialize();
         virtual void step();
         virtual void finalize();
+        /**
+         * Computes \a schedule from \a tasks. Requires \a mutex.
+         */
         void reorderList();
         /**
+         * Returns true if the calling thread is the thread
+         * that executes step().
+         */
+        virtual bool isStepping() const;
+        /**
+         * Returns true if \a a precedes \a b in \a dependencies.
+         */
+        bool precedes( PeriodicActivity* a, PeriodicActivity* b ) const;
+        /**
+         * Protects \a tasks, \a dependencies and the slots of \a schedule.
          * A Activity can not create a activity of same priority from step().
          * If so a deadlock will occur.
          */
         mutable os::MutexRecursive mutex;
+        ScheduleOrder order;
+        /**
+         * Set when \a schedule must be recomputed.
+         */
+        volatile bool changed;
+        /**
+         * The activity of which step() is being executed.
+         */
+        PeriodicActivity* volatile current;
+        /**
+         * removeActivity() waits on \a stepped while \a current is the
+         * activity it removes.
+         */
+        os::AtomicInt waiting;
+        os::Mutex waitlock;
+        os::Condition stepped;
 
         /**
          * A Boost weak pointer is used to store non-owning pointers
@@ -3,9 +3,11 @@
 
 namespace RTT {
     namespace extras {
+        class ActivityPool;
         class FileDescriptorActivity;
         class IRQActivity;
         class PeriodicActivity;
+        class PooledActivity;
         class SequentialActivity;
         class SimulationActivity;
         class SimulationThread;
@@ -0,0 +1,329 @@
+/***************************************************************************
+  tag: AtomicMPMCQueue.hpp
+
+                        AtomicMPMCQueue.hpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef ORO_CORELIB_ATOMIC_MPMC_QUEUE_HPP
+#define ORO_CORELIB_ATOMIC_MPMC_QUEUE_HPP
+
+#include "../os/CAS.hpp"
+
+namespace RTT
+{
+    namespace internal
+    {
+
+        /**
+         * A bounded, lock-free Multi-Writer, Multi-Reader queue (FIFO),
+         * based on the design of Dmitry Vyukov. Each slot carries a sequence
+         * number which tells if it is free for the writer or filled for the
+         * reader at a given position: 2*position when free and
+         * 2*position + 1 when filled. The write and read positions are
+         * kept on separate cache lines, such that writers and readers
+         * only contend on the slots they actually use, and not on
+         * a shared index word.
+         *
+         * Contrary to AtomicMWSRQueue and AtomicQueue, the order of the
+         * items is strictly kept and the full capacity is always usable.
+         * Items can be enqueued or dequeued in batches, which costs one
+         * CAS on the position for the whole batch. The rtt-queue-bench
+         * program in the tests directory compares its multi-producer
+         * throughput to that of the other queues.
+         *
+         * @param T The type to be stored in the queue, which must be a
+         * pointer or an integral type. Contrary to AtomicMWSRQueue, a null
+         * pointer can be stored.
+         * Example : AtomicMPMCQueue< A* > is a queue of pointers to A.
+         * @ingroup CoreLibBuffers
+         */
+        template<class T>
+        class AtomicMPMCQueue
+        {
+        public:
+            typedef unsigned int size_type;
+
+            /**
+             * The cache line size for which the positions are padded.
+             */
+            enum { CacheLineSize = 64 };
+
+            /**
+             * The largest capacity. The positions wrap at a multiple of the
+             * capacity below 2^29, which must leave room for twice the
+             * capacity to tell full and empty cells apart.
+             */
+            enum { MaxSize = 0x10000000 };
+
+        private:
+            struct Cell
+            {
+                volatile unsigned int seq;
+                T volatile value;
+            };
+
+            Cell* const _cells;
+            const unsigned int _size;
+            /**
+             * The positions wrap at this multiple of _size,
+             * such that a position always maps to the same cell.
+             * The sequence numbers wrap at 2 * _wrap.
+             */
+            const unsigned int _wrap;
+
+            char _pad0[CacheLineSize];
+            /** The next position to enqueue. */
+            volatile unsigned int _head;
+            char _pad1[CacheLineSize - sizeof(unsigned int)];
+            /** The next position to dequeue. */
+            volatile unsigned int _tail;
+            char _pad2[CacheLineSize - sizeof(unsigned int)];
+
+            // non-copyable !
+            AtomicMPMCQueue(const AtomicMPMCQueue<T>&);
+
+            static unsigned int wrap(unsigned int size)
+            {
+                if (size == 0)
+                    size = 1;
+                return size * (0x20000000u / size);
+            }
+
+            unsigned int next(unsigned int pos, unsigned int n = 1) const
+            {
+                pos += n;
+                return pos >= _wrap ? pos - _wrap : pos;
+            }
+
+            /**
+             * Returns a - b, for values which wrap at \a modulus.
+             */
+            static int distance(unsigned int a, unsigned int b, unsigned int modulus)
+            {
+                int d = int(a) - int(b);
+                if (d > int(modulus / 2))
+                    return d - int(modulus);
+                if (d < -int(modulus / 2))
+                    return d + int(modulus);
+                return d;
+            }
+
+            /**
+             * Returns how far the sequence number of the cell of \a pos
+             * is ahead of \a pos, being 0 when free and 1 when filled
+             * for \a pos.
+             */
+            int state(unsigned int pos) const
+            {
+                return distance(cell(pos).seq, 2 * pos, 2 * _wrap);
+            }
+
+            Cell& cell(unsigned int pos) const
+            {
+                return _cells[pos % _size];
+            }
+
+            /**
+             * Claims up to \a n consecutive positions of \a counter, of which
+             * the cells are ready, this is, have the state \a ready.
+             * @param first Stores the first claimed position.
+             * @return The number of positions claimed, zero if the first
+             * cell is not ready (queue full or empty).
+             */
+            size_type claim(volatile unsigned int* counter, int ready, size_type n, unsigned int& first)
+            {
+                if (n == 0)
+                    return 0;
+                if (n > _size)
+                    n = _size;
+                unsigned int pos = *counter;
+                while (true) {
+                    size_type k = 0;
+                    int dif = 0;
+                    while (k != n) {
+                        dif = state(next(pos, k)) - ready;
+                        if (dif != 0)
+                            break;
+                        ++k;
+                    }
+                    if (k == 0 && dif < 0)
+                        return 0;
+                    // dif > 0 means that another thread claimed pos already.
+                    if (k != 0 && os::CAS(counter, pos, next(pos, k))) {
+                        first = pos;
+                        return k;
+                    }
+                    pos = *counter;
+                }
+            }
+
+            /**
+             * Moves the sequence number of a claimed cell forward.
+             * The CAS always succeeds, but orders the access to the
+             * value before the publication on all platforms.
+             */
+            static void publish(Cell& c, unsigned int from, unsigned int to)
+            {
+                os::CAS(&c.seq, from, to);
+            }
+
+        public:
+            /**
+             * Create an AtomicMPMCQueue which can contain \a size items.
+             * @param size The size of the queue, should be 1 or greater
+             * and at most MaxSize.
+             */
+            AtomicMPMCQueue(size_type size) :
+                _cells(new Cell[size ? size : 1]), _size(size ? size : 1), _wrap(wrap(size))
+            {
+                this->clear();
+            }
+
+            ~AtomicMPMCQueue()
+            {
+                delete[] _cells;
+            }
+
+            /**
+             * Return the maximum number of items this queue can contain.
+             */
+            size_type capacity() const
+            {
+                return _size;
+            }
+
+            /**
+             * Return the number of elements in the queue. This is an
+             * estimate when other threads access the queue.
+             */
+            size_type size() const
+            {
+                int c = distance(_head, _tail, _wrap);
+                if (c < 0)
+                    return 0;
+                return size_type(c) > _size ? _size : size_type(c);
+            }
+
+            /**
+             * Inspect if the Queue is empty, this is, if the next
+             * dequeue would fail.
+             */
+            bool isEmpty() const
+            {
+                return state(_tail) < 1;
+            }
+
+            /**
+             * Inspect if the Queue is full, this is, if the next
+             * enqueue would fail.
+             */
+            bool isFull() const
+            {
+                return state(_head) < 0;
+            }
+
+            /**
+             * Enqueue an item.
+             * @param value The value to enqueue.
+             * @return false if queue is full, true if queued.
+             */
+            bool enqueue(const T& value)
+            {
+                return enqueue(&value, 1) == 1;
+            }
+
+            /**
+             * Enqueue the \a n items of the array \a values, in order.
+             * @return The number of items enqueued, which is less than
+             * \a n if the queue got full.
+             */
+            size_type enqueue(const T* values, size_type n)
+            {
+                unsigned int pos;
+                size_type k = claim(&_head, 0, n, pos);
+                for (size_type i = 0; i != k; ++i, pos = next(pos)) {
+                    Cell& c = cell(pos);
+                    c.value = values[i];
+                    publish(c, 2 * pos, 2 * pos + 1);
+                }
+                return k;
+            }
+
+            /**
+             * Dequeue an item.
+             * @param result Stores the dequeued value. It is unchanged when
+             * dequeue returns false and contains the dequeued value
+             * when it returns true.
+             * @return false if queue is empty, true if result was written.
+             */
+            bool dequeue(T& result)
+            {
+                return dequeue(&result, 1) == 1;
+            }
+
+            /**
+             * Dequeue up to \a n items into the array \a results, in order.
+             * @return The number of items written to \a results.
+             */
+            size_type dequeue(T* results, size_type n)
+            {
+                unsigned int pos;
+                size_type k = claim(&_tail, 1, n, pos);
+                for (size_type i = 0; i != k; ++i, pos = next(pos)) {
+                    Cell& c = cell(pos);
+                    results[i] = c.value;
+                    publish(c, 2 * pos + 1, 2 * next(pos, _size));
+                }
+                return k;
+            }
+
+            /**
+             * Clear all contents of the Queue and thus make it empty.
+             * Only call this function when no other thread accesses the queue.
+             */
+            void clear()
+            {
+                for (unsigned int i = 0; i != _size; ++i) {
+                    _cells[i].seq = 2 * i;
+                    _cells[i].value = T();
+                }
+                _head = 0;
+                _tail = 0;
+            }
+        };
+    }
+}
+
+#endif
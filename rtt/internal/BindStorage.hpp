@@ -108,6 +108,15 @@ namespace RTT
                 return executed;
             }
 
+            /**
+             * Forgets the outcome of a previous execution,
+             * such that this storage can be executed again.
+             */
+            void reset() {
+                executed = false;
+                error = false;
+            }
+
             template<class F>
             void exec(F f) {
                 error = false;
@@ -41,6 +41,7 @@
 
 #include "../base/ChannelElement.hpp"
 #include "../base/BufferInterface.hpp"
+#include "../base/Buffer.hpp"
 
 namespace RTT { namespace internal {
 
@@ -58,20 +59,44 @@ namespace RTT { namespace internal {
     template<typename T>
     class ChannelBufferElement : public base::ChannelElement<T>, public ChannelBufferElementBase
     {
-        typename base::BufferInterface<T>::shared_ptr buffer;
-        typename base::ChannelElement<T>::value_t *last_sample_p;
     public:
         typedef typename base::ChannelElement<T>::param_t param_t;
         typedef typename base::ChannelElement<T>::reference_t reference_t;
 	typedef typename base::ChannelElement<T>::value_t value_t;
+        typedef typename base::ChannelElement<T>::shared_sample_t shared_sample_t;
+
+    private:
+        typename base::BufferInterface<T>::shared_ptr buffer;
+        typename base::ChannelElement<T>::value_t *last_sample_p;
+        /// Holds the samples of writeShared(), created with this element.
+        base::BufferInterface<shared_sample_t>* shared_buffer;
+        /// The last sample read from shared_buffer.
+        shared_sample_t last_shared;
+        bool circular;
+
+        void releaseLast()
+        {
+            if(last_sample_p)
+                buffer->Release(last_sample_p);
+            last_sample_p = 0;
+            last_shared.reset();
+        }
 
-        ChannelBufferElement(typename base::BufferInterface<T>::shared_ptr buffer)
-            : buffer(buffer), last_sample_p(0) {}
+    public:
+        /**
+         * @param circular Must be true if \a buffer is circular, such
+         * that shared samples are buffered in the same way.
+         */
+        ChannelBufferElement(typename base::BufferInterface<T>::shared_ptr buffer, bool circular = false)
+            : buffer(buffer), last_sample_p(0),
+              shared_buffer( base::buildBuffer<shared_sample_t>(buffer->capacity(), shared_sample_t(), circular) ),
+              circular(circular) {}
             
 	virtual ~ChannelBufferElement()
 	{
 	    if(last_sample_p)
 		buffer->Release(last_sample_p);
+            delete shared_buffer;
 	}
  
         virtual size_t getBufferSize() const
@@ -100,6 +125,17 @@ namespace RTT { namespace internal {
             return true;
         }
 
+        /** Appends \a samples at the end of the FIFO in one batch.
+         *
+         * @return true, the samples which did not fit in the FIFO are dropped.
+         */
+        virtual bool writeAll(std::vector<T> const& samples)
+        {
+            if (buffer->Push(samples))
+                return this->signal();
+            return true;
+        }
+
         /** Pops and returns the first element of the FIFO
          *
          * @return false if the FIFO was empty, and true otherwise
@@ -108,18 +144,106 @@ namespace RTT { namespace internal {
         {
 	    value_t *new_sample_p;
             if ( (new_sample_p = buffer->PopWithoutRelease()) ) {
-		if(last_sample_p)
-		    buffer->Release(last_sample_p);
+                releaseLast();
 		
 		last_sample_p = new_sample_p;
 		sample = *new_sample_p;
                 return NewData;
             }
+            shared_sample_t new_shared;
+            if ( shared_buffer->Pop(new_shared) ) {
+                releaseLast();
+                last_shared = new_shared;
+                sample = *new_shared;
+                return NewData;
+            }
             if (last_sample_p) {
 		if(copy_old_data)
 		    sample = *(last_sample_p);
                 return OldData;
             }
+            if ( last_shared.valid() ) {
+                if(copy_old_data)
+                    sample = *last_shared;
+                return OldData;
+            }
+            return NoData;
+        }
+
+        /** Pops all elements of the FIFO and appends them to \a samples.
+         * All but the last element are popped in one batch, the last one
+         * is kept such that read() returns it as OldData afterwards.
+         * Shared samples are appended after the others.
+         *
+         * @return NewData if at least one element was appended.
+         */
+        virtual FlowStatus readAll(std::vector<T>& samples)
+        {
+            typename std::vector<T>::size_type start = samples.size();
+            int available = buffer->size();
+            if ( available > 1 )
+                buffer->Pop( samples, available - 1 );
+            value_t *new_sample_p;
+            if ( (new_sample_p = buffer->PopWithoutRelease()) ) {
+                releaseLast();
+                last_sample_p = new_sample_p;
+                samples.push_back( *new_sample_p );
+            }
+            shared_sample_t new_shared;
+            while ( shared_buffer->Pop(new_shared) ) {
+                releaseLast();
+                last_shared = new_shared;
+                samples.push_back( *new_shared );
+            }
+            if ( samples.size() != start )
+                return NewData;
+            if ( last_sample_p || last_shared.valid() )
+                return OldData;
+            return NoData;
+        }
+
+        /** Appends a reference to \a sample at the end of the FIFO.
+         * The order between samples written with write() and writeShared()
+         * is not kept.
+         *
+         * @return true if there was room in the FIFO for the new sample, and false otherwise.
+         */
+        virtual bool writeShared(shared_sample_t const& sample)
+        {
+            if (shared_buffer->Push(sample))
+                return this->signal();
+            return true;
+        }
+
+        /** Pops the first element of the FIFO as a shared sample.
+         * Only a sample written with write() is copied.
+         */
+        virtual FlowStatus readShared(shared_sample_t& sample, bool copy_old_data)
+        {
+	    value_t *new_sample_p;
+            if ( (new_sample_p = buffer->PopWithoutRelease()) ) {
+                releaseLast();
+                last_sample_p = new_sample_p;
+                sample = internal::LoanedSample<T>::create( *new_sample_p ).share();
+                return NewData;
+            }
+            shared_sample_t new_shared;
+            if ( shared_buffer->Pop(new_shared) ) {
+                releaseLast();
+                last_shared = new_shared;
+                sample = new_shared;
+                return NewData;
+            }
+            if (last_sample_p) {
+		if(copy_old_data)
+                    sample = internal::LoanedSample<T>::create( *last_sample_p ).share();
+                return OldData;
+            }
+            if ( last_shared.valid() ) {
+                if(copy_old_data)
+                    sample = last_shared;
+                return OldData;
+            }
             return NoData;
         }
 
@@ -129,10 +253,9 @@ namespace RTT { namespace internal {
          */
         virtual void clear()
         {
-	    if(last_sample_p)
-		buffer->Release(last_sample_p);
-	    last_sample_p = 0;
+            releaseLast();
             buffer->clear();
+            shared_buffer->clear();
             base::ChannelElement<T>::clear();
         }
 
@@ -41,6 +41,7 @@
 
 #include "../base/ChannelElement.hpp"
 #include "../base/DataObjectInterface.hpp"
+#include "../base/DataObject.hpp"
 
 namespace RTT { namespace internal {
 
@@ -49,26 +50,96 @@ namespace RTT { namespace internal {
     template<typename T>
     class ChannelDataElement : public base::ChannelElement<T>
     {
+    public:
+        typedef typename base::ChannelElement<T>::param_t param_t;
+        typedef typename base::ChannelElement<T>::reference_t reference_t;
+        typedef typename base::ChannelElement<T>::shared_sample_t shared_sample_t;
+
+    private:
         bool written, mread;
         typename base::DataObjectInterface<T>::shared_ptr data;
+        /// Holds the samples of writeShared(), created with this element.
+        base::DataObjectInterface<shared_sample_t>* shared_data;
+        /// True if the last sample was written with writeShared().
+        volatile bool mshared;
+
+        void get(reference_t sample)
+        {
+            if (mshared) {
+                shared_sample_t s;
+                shared_data->Get(s);
+                if ( s.valid() )
+                    sample = *s;
+            } else
+                data->Get(sample);
+        }
+
+        void getShared(shared_sample_t& sample)
+        {
+            if (mshared)
+                shared_data->Get(sample);
+            else
+                sample = internal::LoanedSample<T>::create( data->Get() ).share();
+        }
 
     public:
-        typedef typename base::ChannelElement<T>::param_t param_t;
-        typedef typename base::ChannelElement<T>::reference_t reference_t;
+        /**
+         * The number of threads that may read the samples of writeShared()
+         * concurrently. Their storage holds SharedReaders + 2 samples,
+         * see base::buildDataObject().
+         */
+        static const unsigned int SharedReaders = 2;
+
+        /**
+         * The number of shared samples the storage of writeShared() holds.
+         */
+        static const unsigned int SharedSamples = SharedReaders + 2;
 
         ChannelDataElement(typename base::DataObjectInterface<T>::shared_ptr sample)
-            : written(false), mread(false), data(sample) {}
+            : written(false), mread(false), data(sample),
+              shared_data( base::buildDataObject<shared_sample_t>(shared_sample_t(), SharedReaders) ),
+              mshared(false) {}
+
+        ~ChannelDataElement()
+        {
+            delete shared_data;
+        }
 
         /** Update the data sample stored in this element.
          * It always returns true. */
         virtual bool write(param_t sample)
         {
             data->Set(sample);
+            if (mshared) {
+                mshared = false;
+                shared_data->Set( shared_sample_t() );
+            }
             written = true;
             mread = false;
             return this->signal();
         }
 
+        /** Stores a reference to \a sample in this element.
+         * It always returns true. */
+        virtual bool writeShared(shared_sample_t const& sample)
+        {
+            shared_data->Set(sample);
+            mshared = true;
+            written = true;
+            mread = false;
+            return this->signal();
+        }
+
+        /** Only stores the last of \a samples, since this element
+         * holds a single sample.
+         * It always returns true. */
+        virtual bool writeAll(std::vector<T> const& samples)
+        {
+            if ( samples.empty() )
+                return true;
+            return write( samples.back() );
+        }
+
         /** Reads the last sample given to write()
          *
          * @return false if no sample has ever been written, true otherwise
@@ -78,13 +149,34 @@ namespace RTT { namespace internal {
             if (written)
             {
                 if ( !mread ) {
-		    data->Get(sample);
+                    get(sample);
                     mread = true;
                     return NewData;
                 }
 
 		if(copy_old_data)
-		    data->Get(sample);
+                    get(sample);
+
+                return OldData;
+            }
+            return NoData;
+        }
+
+        /** Reads the last sample given to write() or writeShared().
+         * Only a sample written with write() is copied.
+         */
+        virtual FlowStatus readShared(shared_sample_t& sample, bool copy_old_data)
+        {
+            if (written)
+            {
+                if ( !mread ) {
+                    getShared(sample);
+                    mread = true;
+                    return NewData;
+                }
+
+                if(copy_old_data)
+                    getShared(sample);
 
                 return OldData;
             }
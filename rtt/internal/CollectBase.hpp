@@ -71,6 +71,14 @@ namespace RTT
               public ReturnBaseImpl< boost::function_traits<F>::arity, F>
         {
             typedef boost::shared_ptr<CollectBase<F> > shared_ptr;
+
+            /**
+             * Runs \a done in the caller's ExecutionEngine once the
+             * call completed.
+             * @return false if this implementation does not support
+             * completion callbacks.
+             */
+            virtual bool setCompletion(boost::function<void(void)> const& done) { return false; }
         };
 
         template<class Ft>
@@ -145,7 +145,7 @@ namespace RTT
                 {
 #ifndef OROBLD_OS_NO_ASM
                 case ConnPolicy::LOCK_FREE:
-                    data_object.reset( new base::DataObjectLockFree<T>(initial_value) );
+                    data_object.reset( base::buildDataObject<T>(initial_value, policy.max_readers > 0 ? policy.max_readers : 2, policy.seqlock) );
                     break;
 #else
 		case ConnPolicy::LOCK_FREE:
@@ -169,8 +169,17 @@ namespace RTT
                 {
 #ifndef OROBLD_OS_NO_ASM
                 case ConnPolicy::LOCK_FREE:
-                    buffer_object = new base::BufferLockFree<T>(policy.size, initial_value, policy.type == ConnPolicy::CIRCULAR_BUFFER);
+                    if ( policy.size <= base::BufferLockFree<T>::max_capacity() ) {
+                        buffer_object = new base::BufferLockFree<T>(policy.size, initial_value, policy.type == ConnPolicy::CIRCULAR_BUFFER);
+                        break;
+                    }
+#ifdef ORO_HAVE_CAS64
+                    buffer_object = new base::BufferLockFree<T, unsigned int>(policy.size, initial_value, policy.type == ConnPolicy::CIRCULAR_BUFFER);
                     break;
+#else
+                    RTT::log(Warning) << "lock free buffers of more than " << base::BufferLockFree<T>::max_capacity() << " elements are unavailable on this system, defaulting to LOCKED" << RTT::endlog();
+                    // fall through
+#endif
 #else
 		case ConnPolicy::LOCK_FREE:
 		    RTT::log(Warning) << "lock free connection policy is unavailable on this system, defaulting to LOCKED" << RTT::endlog();
@@ -182,7 +191,7 @@ namespace RTT
                     buffer_object = new base::BufferUnSync<T>(policy.size, initial_value, policy.type == ConnPolicy::CIRCULAR_BUFFER);
                     break;
                 }
-                return new ChannelBufferElement<T>(typename base::BufferInterface<T>::shared_ptr(buffer_object));
+                return new ChannelBufferElement<T>(typename base::BufferInterface<T>::shared_ptr(buffer_object), policy.type == ConnPolicy::CIRCULAR_BUFFER);
             }
             return NULL;
         }
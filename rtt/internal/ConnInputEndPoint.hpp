@@ -75,6 +75,28 @@ namespace RTT
             return true;
         }
 
+        /** Passes the shared sample on, such that it is stored
+         * without copying it.
+         */
+        virtual bool writeShared(typename base::ChannelElement<T>::shared_sample_t const& sample)
+        {
+            typename base::ChannelElement<T>::shared_ptr output = this->getOutput();
+            if (output)
+                return output->writeShared(sample);
+            return false;
+        }
+
+        /** Passes the samples on, such that they are stored
+         * in one batch.
+         */
+        virtual bool writeAll(std::vector<T> const& samples)
+        {
+            typename base::ChannelElement<T>::shared_ptr output = this->getOutput();
+            if (output)
+                return output->writeAll(samples);
+            return false;
+        }
+
         virtual void disconnect(bool forward)
         {
             // Call the base class first
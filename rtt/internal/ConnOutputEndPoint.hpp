@@ -97,6 +97,34 @@ namespace RTT
         virtual bool write(typename base::ChannelElement<T>::param_t sample)
         { return false; }
 
+        virtual bool writeShared(typename base::ChannelElement<T>::shared_sample_t const& sample)
+        { return false; }
+
+        virtual bool writeAll(std::vector<T> const& samples)
+        { return false; }
+
+        /** Reads a shared sample from the data storage element, without
+         * copying it.
+         */
+        virtual FlowStatus readShared(typename base::ChannelElement<T>::shared_sample_t& sample, bool copy_old_data)
+        {
+            typename base::ChannelElement<T>::shared_ptr input = this->getInput();
+            if (input)
+                return input->readShared(sample, copy_old_data);
+            return NoData;
+        }
+
+        /** Reads all new samples from the data storage element
+         * in one batch.
+         */
+        virtual FlowStatus readAll(std::vector<T>& samples)
+        {
+            typename base::ChannelElement<T>::shared_ptr input = this->getInput();
+            if (input)
+                return input->readAll(samples);
+            return NoData;
+        }
+
         virtual void disconnect(bool forward)
         {
             // Call the base class: it does the common cleanup
@@ -49,6 +49,7 @@
 #include "../base/PortInterface.hpp"
 #include "../os/MutexLock.hpp"
 #include "../base/InputPortInterface.hpp"
+#include "../os/fosi.h"
 #include <cassert>
 
 namespace RTT
@@ -60,26 +61,29 @@ namespace RTT
 
         ConnectionManager::ConnectionManager(PortInterface* port)
             : mport(port)
-            , cur_channel(NULL)
+            , msnapshot( new Snapshot() )
         {
         }
 
         ConnectionManager::~ConnectionManager()
         {
             this->disconnect();
+            delete msnapshot;
+            for (std::vector<Snapshot*>::iterator it = mretired.begin(); it != mretired.end(); ++it)
+                delete *it;
         }
 
         /**
          * Helper function to clear a connection.
          * @param descriptor
          */
-        void clearChannel(ConnectionManager::ChannelDescriptor& descriptor) {
+        void clearChannel(ConnectionManager::ChannelDescriptor const& descriptor) {
             descriptor.get<1>()->clear();
         }
 
         void ConnectionManager::clear()
-        { RTT::os::MutexLock lock(connection_lock);
-            std::for_each(connections.begin(), connections.end(), &clearChannel);
+        { ReadSection rs(*this);
+            std::for_each(rs.get()->channels.begin(), rs.get()->channels.end(), &clearChannel);
         }
 
         bool ConnectionManager::findMatchingPort(ConnID const* conn_id, ChannelDescriptor const& descriptor)
@@ -87,12 +91,51 @@ namespace RTT
             return ( descriptor.get<0>() && conn_id->isSameID(*descriptor.get<0>()));
         }
 
-        void ConnectionManager::updateCurrentChannel(bool reset_current)
+        void ConnectionManager::publish(Snapshot* s)
         {
-            if (connections.empty())
-                cur_channel = NULL;
-            else if (reset_current)
-                cur_channel = &(connections.front());
+            Snapshot* old = msnapshot;
+            s->invalid.assign( s->channels.size(), false );
+            s->current = s->channels.empty() ? -1 : 0;
+            int current = old->current;
+            if ( current >= 0 ) {
+                for (int i = 0; i != int(s->channels.size()); ++i)
+                    if ( s->channels[i].get<1>() == old->channels[current].get<1>() ) {
+                        s->current = i;
+                        break;
+                    }
+            }
+            msnapshot = s;
+            mretired.push_back( old );
+        }
+
+        void ConnectionManager::synchronize(std::vector<Snapshot*>& retired)
+        {
+            { RTT::os::MutexLock lock(sync_lock);
+                // Readers which entered before the epoch change may still use
+                // a retired snapshot, wait until they all left. Readers of older
+                // epochs were waited for by the previous synchronize().
+                int epoch = mepoch.read();
+                mepoch.set( epoch + 1 );
+                while ( mreaders[epoch & 1].read() != 0 ) {
+                    TIME_SPEC ts;
+                    ts.tv_sec = 0;
+                    ts.tv_nsec = 100000;
+                    rtos_nanosleep( &ts, NULL );
+                }
+            }
+            for (std::vector<Snapshot*>::iterator it = retired.begin(); it != retired.end(); ++it)
+                delete *it;
+            retired.clear();
+        }
+
+        void ConnectionManager::removeInvalid()
+        {
+            Snapshot* old = msnapshot;
+            Snapshot* s = new Snapshot();
+            for (std::size_t i = 0; i != old->channels.size(); ++i)
+                if ( !old->invalid[i] )
+                    s->channels.push_back( old->channels[i] );
+            publish( s );
         }
 
         bool ConnectionManager::disconnect(PortInterface* port)
@@ -114,43 +157,59 @@ namespace RTT
 
         void ConnectionManager::disconnect()
         {
-            std::list<ChannelDescriptor> all_connections;
+            std::vector<ChannelDescriptor> all_connections;
+            std::vector<Snapshot*> retired;
             { RTT::os::MutexLock lock(connection_lock);
-                all_connections.splice(all_connections.end(), connections);
-                cur_channel = NULL;
+                all_connections = msnapshot->channels;
+                publish( new Snapshot() );
+                retired.swap( mretired );
             }
+            synchronize( retired );
             std::for_each(all_connections.begin(), all_connections.end(),
                     boost::bind(&ConnectionManager::eraseConnection, this, _1));
         }
 
         bool ConnectionManager::connected() const
-        { return !connections.empty(); }
+        { ReadSection rs(*this);
+            return !rs.get()->channels.empty();
+        }
 
 
         void ConnectionManager::addConnection(ConnID* conn_id, ChannelElementBase::shared_ptr channel, ConnPolicy policy)
-        { RTT::os::MutexLock lock(connection_lock);
-            assert(conn_id);
-            ChannelDescriptor descriptor = boost::make_tuple(conn_id, channel, policy);
-            connections.insert(connections.end(), descriptor);
-            if (connections.size() == 1)
-                cur_channel = &(connections.front());
+        {
+            std::vector<Snapshot*> retired;
+            { RTT::os::MutexLock lock(connection_lock);
+                assert(conn_id);
+                ChannelDescriptor descriptor = boost::make_tuple(conn_id, channel, policy);
+                Snapshot* s = new Snapshot();
+                s->channels.reserve( msnapshot->channels.size() + 1 );
+                s->channels = msnapshot->channels;
+                s->channels.push_back( descriptor );
+                publish( s );
+                retired.swap( mretired );
+            }
+            synchronize( retired );
         }
 
         bool ConnectionManager::removeConnection(ConnID* conn_id)
         {
             ChannelDescriptor descriptor;
+            std::vector<Snapshot*> retired;
             { RTT::os::MutexLock lock(connection_lock);
-                std::list<ChannelDescriptor>::iterator conn_it =
-                    std::find_if(connections.begin(), connections.end(), boost::bind(&ConnectionManager::findMatchingPort, this, conn_id, _1));
-                if (conn_it == connections.end())
+                const std::vector<ChannelDescriptor>& channels = msnapshot->channels;
+                std::vector<ChannelDescriptor>::const_iterator conn_it =
+                    std::find_if(channels.begin(), channels.end(), boost::bind(&ConnectionManager::findMatchingPort, this, conn_id, _1));
+                if (conn_it == channels.end())
                     return false;
                 descriptor = *conn_it;
-                // Verify whether cur_channel is conn_it before we erase, as
-                // cur_channel is a pointer to an element in connections
-                bool reset_current = cur_channel && (cur_channel->get<1>() == descriptor.get<1>());
-                connections.erase(conn_it);
-                updateCurrentChannel(reset_current);
+                Snapshot* s = new Snapshot();
+                s->channels.reserve( channels.size() - 1 );
+                s->channels.insert( s->channels.end(), channels.begin(), conn_it );
+                s->channels.insert( s->channels.end(), conn_it + 1, channels.end() );
+                publish( s );
+                retired.swap( mretired );
             }
+            synchronize( retired );
 
             // disconnect needs to know if we're from Out->In (forward) or from In->Out
             bool is_forward = true;
@@ -51,6 +51,7 @@
 #include "List.hpp"
 #include "../ConnPolicy.hpp"
 #include "../os/Mutex.hpp"
+#include "../os/Atomic.hpp"
 #include "../base/rtt-base-fwd.hpp"
 #include "../base/ChannelElementBase.hpp"
 #include <boost/tuple/tuple.hpp>
@@ -60,6 +61,7 @@
 #include <rtt/os/Mutex.hpp>
 #include <rtt/os/MutexLock.hpp>
 #include <list>
+#include <vector>
 
 
 namespace RTT
@@ -71,7 +73,11 @@ namespace RTT
          * Manages connections between ports.
          * This class is used for input and output ports
          * in order to manage their channels.
-         * TODO: use the mutex lock !!!
+         *
+         * The connections are kept in a copy-on-write snapshot. Reading and
+         * writing ports iterate over the snapshot without taking a lock,
+         * connecting and disconnecting publish a new snapshot and delete the old
+         * one once no reader uses it anymore.
          */
         class RTT_API ConnectionManager
         {
@@ -114,21 +120,35 @@ namespace RTT
             /** Removes the channel that connects this port to \c port */
             bool disconnect(base::PortInterface* port);
 
+            /**
+             * Applies \a pred to all connections and removes those for which
+             * \a pred returns true. \a pred is called exactly once for each connection
+             * in the active snapshot, without taking a lock.
+             * @note Removing a connection requires the connection lock.
+             * If another thread holds it, the removal is skipped
+             * and retried during the next invocation, such that this
+             * function never blocks.
+             */
             template<typename Pred>
             bool delete_if(Pred pred) {
-                RTT::os::MutexLock lock(connection_lock);
                 bool result = false;
-                std::list<ChannelDescriptor>::iterator it = connections.begin();
-                while (it != connections.end())
-                {
-                    if (pred(*it))
-                    {
-                        result = true;
-                        it = connections.erase(it);
-                    }
-                    else ++it;
+                { ReadSection rs(*this);
+                    Snapshot* s = rs.get();
+                    for (std::size_t i = 0; i != s->channels.size(); ++i)
+                        if ( pred(s->channels[i]) ) {
+                            s->invalid[i] = true;
+                            result = true;
+                        }
+                    if (!result)
+                        return false;
                 }
-                return result;
+                // If the snapshot was replaced in the meantime, the invalid
+                // channels are found again in the next invocation.
+                if ( connection_lock.trylock() ) {
+                    removeInvalid();
+                    connection_lock.unlock();
+                }
+                return true;
             }
 
             /**
@@ -137,46 +157,49 @@ namespace RTT
              * the current channel ( getCurrentChannel() ), if that
              * does not satisfy pred, iterate over \b all connections.
              * If none satisfy pred, the current channel remains unchanged.
+             * This function does not take a lock.
              * @param pred
              */
             template<typename Pred>
             void select_reader_channel(Pred pred, bool copy_old_data) {
-                RTT::os::MutexLock lock(connection_lock);
-                ChannelDescriptor *new_channel =
-                    find_if(pred, copy_old_data);
-                if (new_channel)
+                ReadSection rs(*this);
+                Snapshot* s = rs.get();
+                int new_channel = find_in(s, pred, copy_old_data);
+                if (new_channel >= 0)
                 {
                     // We don't clear the current channel (to get it to NoData state), because there is a race
                     // between find_if and this line. We have to accept (in other parts of the code) that eventually,
                     // all channels return 'OldData'.
-                    cur_channel = new_channel;
+                    s->current = new_channel;
                 }
             }
 
+            /**
+             * Returns a copy of the descriptor of the first connection
+             * for which pred(copy_old_data, connection) returns true.
+             * The current channel is checked first.
+             * @param result Is set to the matching descriptor.
+             * @return false if no connection matched.
+             */
             template<typename Pred>
-            ChannelDescriptor *find_if(Pred pred, bool copy_old_data) {
-                // We only copy OldData in the initial read of the current channel.
-                // if it has no new data, the search over the other channels starts,
-                // but no old data is needed.
-                ChannelDescriptor *channel = cur_channel;
-                if ( channel )
-                    if ( pred( copy_old_data, *channel ) )
-                        return channel;
-
-                std::list<ChannelDescriptor>::iterator result;
-                for (result = connections.begin(); result != connections.end(); ++result) {
-                    if (cur_channel && (result->get<1>() == cur_channel->get<1>())) continue;
-                    if ( pred(false, *result) == true)
-                        return &(*result);
-                }
-                return NULL;
+            bool find_if(Pred pred, bool copy_old_data, ChannelDescriptor& result) {
+                ReadSection rs(*this);
+                Snapshot* s = rs.get();
+                int channel = find_in(s, pred, copy_old_data);
+                if (channel < 0)
+                    return false;
+                result = s->channels[channel];
+                return true;
             }
 
             /**
              * Returns true if this manager manages only one connection.
              * @return
              */
-            bool isSingleConnection() const { return connections.size() == 1; }
+            bool isSingleConnection() const {
+                ReadSection rs(*this);
+                return rs.get()->channels.size() == 1;
+            }
 
             /**
              * Returns the first added channel or if select_if was called, the selected channel.
@@ -184,14 +207,18 @@ namespace RTT
              * @return
              */
             base::ChannelElementBase* getCurrentChannel() const {
-                return cur_channel ? cur_channel->get<1>().get() : NULL;
+                ReadSection rs(*this);
+                const Snapshot* s = rs.get();
+                return s->current >= 0 ? s->channels[s->current].get<1>().get() : NULL;
             }
 
             /**
              * Returns a list of all channels managed by this object.
              */
             std::list<ChannelDescriptor> getChannels() const {
-                return connections;
+                ReadSection rs(*this);
+                const Snapshot* s = rs.get();
+                return std::list<ChannelDescriptor>( s->channels.begin(), s->channels.end() );
             }
 
             /**
@@ -203,6 +230,8 @@ namespace RTT
 
             /**
              * Locks the mutex protecting the channel element list.
+             * This only serializes the modifications of the list,
+             * readers of the list are never blocked.
              * */
             void lock() const {
                 connection_lock.lock();
@@ -215,8 +244,87 @@ namespace RTT
                 connection_lock.unlock();
             }
         protected:
+            /**
+             * An immutable copy of the connections. Modifications of the
+             * connections publish a new Snapshot, which replaces the
+             * active one. Only the index of the current channel is
+             * modified in a published Snapshot.
+             */
+            struct Snapshot {
+                Snapshot() : current(-1) {}
+                std::vector<ChannelDescriptor> channels;
+                /** Marks the channels to be removed by removeInvalid(). */
+                std::vector<char> invalid;
+                /** Index of the current channel in channels, or -1. */
+                volatile int current;
+            };
 
-            void updateCurrentChannel(bool reset_current);
+            /**
+             * Registers a reader of the active snapshot. Writers do not
+             * delete a snapshot as long as a reader which could have seen
+             * it did not leave its section.
+             */
+            class ReadSection {
+                const ConnectionManager& cm;
+                int epoch;
+            public:
+                ReadSection(const ConnectionManager& c) : cm(c) {
+                    do {
+                        epoch = cm.mepoch.read();
+                        cm.mreaders[epoch & 1].inc();
+                        if ( epoch == cm.mepoch.read() )
+                            break;
+                        cm.mreaders[epoch & 1].dec();
+                    } while (true);
+                }
+                ~ReadSection() {
+                    cm.mreaders[epoch & 1].dec();
+                }
+                Snapshot* get() const { return cm.msnapshot; }
+            };
+
+            template<typename Pred>
+            static int find_in(Snapshot* s, Pred& pred, bool copy_old_data) {
+                // We only copy OldData in the initial read of the current channel.
+                // if it has no new data, the search over the other channels starts,
+                // but no old data is needed.
+                int current = s->current;
+                if ( current >= 0 )
+                    if ( pred( copy_old_data, s->channels[current] ) )
+                        return current;
+
+                for (int i = 0; i != int(s->channels.size()); ++i) {
+                    if ( i == current ) continue;
+                    if ( pred(false, s->channels[i]) == true)
+                        return i;
+                }
+                return -1;
+            }
+
+            /**
+             * Publishes \a s as the new active snapshot and retires
+             * the old one. The current channel is kept if it is in \a s,
+             * otherwise the first channel becomes the current one.
+             * Must be called with connection_lock held.
+             */
+            void publish(Snapshot* s);
+
+            /**
+             * Waits until no reader can use the snapshots in \a retired
+             * anymore and deletes them. The caller takes \a retired from
+             * mretired, with connection_lock held, after it published.
+             * Must be called without connection_lock held, such that
+             * connecting and disconnecting are not blocked while waiting.
+             * @note Not real-time.
+             */
+            void synchronize(std::vector<Snapshot*>& retired);
+
+            /**
+             * Publishes a snapshot without the connections which were
+             * marked invalid by delete_if. Does not wait for the readers
+             * of the old snapshot. Must be called with connection_lock held.
+             */
+            void removeInvalid();
 
             /** Helper method for disconnect(PortInterface*)
              *
@@ -243,21 +351,33 @@ namespace RTT
             base::PortInterface* mport;
 
             /**
-             * A list of all our connections. Only non-null if two or more connections
-             * were added.
+             * The active snapshot of all our connections. Never null.
+             */
+            Snapshot* volatile msnapshot;
+
+            /**
+             * Snapshots which were replaced, but which may still be
+             * used by readers.
              */
-            std::list< ChannelDescriptor > connections;
+            std::vector<Snapshot*> mretired;
 
             /**
-             * Optimisation in case only one channel is to be managed.
+             * The reader epoch and the number of readers
+             * in the even and odd epochs.
              */
-            ChannelDescriptor *cur_channel;
+            mutable os::AtomicInt mepoch;
+            mutable os::AtomicInt mreaders[2];
 
             /**
              * Lock that should be taken before the list of connections is
-             * accessed or modified
+             * modified. Readers do not take this lock.
              */
             mutable RTT::os::Mutex connection_lock;
+
+            /**
+             * Serialises the epoch changes of synchronize().
+             */
+            RTT::os::Mutex sync_lock;
         };
 
     }
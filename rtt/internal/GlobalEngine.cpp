@@ -52,6 +52,12 @@ namespace RTT
             mact->start();
         }
 
+        GlobalEngine::GlobalEngine(int scheduler, int priority, const os::ThreadProfile& profile)
+            : mact( new Activity( scheduler, priority, 0, profile, this, "GlobalEngine") )
+        {
+            mact->start();
+        }
+
         GlobalEngine::~GlobalEngine()
         {
             mact->stop();
@@ -64,6 +70,13 @@ namespace RTT
             }
             return mengine;
         }
+
+        ExecutionEngine* GlobalEngine::Instance(int scheduler, int priority, const os::ThreadProfile& profile) {
+            if (mengine == 0) {
+                mengine = new GlobalEngine(scheduler, priority, profile);
+            }
+            return mengine;
+        }
         void GlobalEngine::Release() {
             delete mengine;
             mengine = 0;
@@ -40,6 +40,7 @@
 #define ORO_GLOBALENGINE_HPP_
 
 #include "../ExecutionEngine.hpp"
+#include "../os/ThreadProfile.hpp"
 #include <boost/shared_ptr.hpp>
 
 namespace RTT
@@ -61,6 +62,7 @@ namespace RTT
         {
             boost::shared_ptr<base::ActivityInterface> mact;
             GlobalEngine(int scheduler, int priority, unsigned cpu_affinity);
+            GlobalEngine(int scheduler, int priority, const os::ThreadProfile& profile);
             virtual ~GlobalEngine();
         public:
             /** @overload
@@ -69,6 +71,11 @@ namespace RTT
              */
             RTT_API static ExecutionEngine* Instance() { return Instance(ORO_SCHED_OTHER); }
             RTT_API static ExecutionEngine* Instance(int scheduler, int priority = os::LowestPriority, unsigned cpu_affinity = 0);
+            /** @overload
+             * Creates the engine's thread with the given thread \a profile.
+             * The arguments are ignored if the engine already exists.
+             */
+            RTT_API static ExecutionEngine* Instance(int scheduler, int priority, const os::ThreadProfile& profile);
             RTT_API static void Release();
         };
 
@@ -1,4 +1,5 @@
 #include "GlobalService.hpp"
+#include "ThreadStatsService.hpp"
 #include "../plugin/PluginLoader.hpp"
 
 #include "../os/StartStopManager.hpp"
@@ -22,6 +23,8 @@ namespace RTT
             addOperation("require", &GlobalService::require, this)
                     .doc("Require that a certain service is loaded in the global service.")
                     .arg("service_name","The name of the service to load globally.");
+            // statistics of the periodic threads:
+            addService( Service::shared_ptr( new ThreadStatsService() ) );
         }
 
         GlobalService::~GlobalService()
@@ -80,6 +80,11 @@ namespace RTT
                 return BaseImpl::send_impl();
             }
 
+            std::vector<SendHandle<F> > sendMany(unsigned int n)
+            {
+                return BaseImpl::sendMany_impl(n);
+            }
+
         };
 
         template<class F, class BaseImpl>
@@ -107,6 +112,12 @@ namespace RTT
             {
                 return BaseImpl::template send_impl<arg1_type>( a1 );
             }
+
+            typedef typename InvokerBaseImpl<1,F>::args1_type args1_type;
+            std::vector<SendHandle<F> > sendMany(args1_type& a1)
+            {
+                return BaseImpl::sendMany_impl(a1);
+            }
         };
 
         template<class F, class BaseImpl>
@@ -139,6 +150,13 @@ namespace RTT
             {
                 return BaseImpl::template send_impl<arg1_type, arg2_type>(t1, t2);
             }
+
+            typedef typename InvokerBaseImpl<2,F>::args1_type args1_type;
+            typedef typename InvokerBaseImpl<2,F>::args2_type args2_type;
+            std::vector<SendHandle<F> > sendMany(args1_type& a1, args2_type& a2)
+            {
+                return BaseImpl::sendMany_impl(a1, a2);
+            }
         };
 
         template<class F, class BaseImpl>
@@ -173,6 +191,14 @@ namespace RTT
                 return BaseImpl::template send_impl<arg1_type, arg2_type, arg3_type>(t1, t2, t3);
             }
 
+            typedef typename InvokerBaseImpl<3,F>::args1_type args1_type;
+            typedef typename InvokerBaseImpl<3,F>::args2_type args2_type;
+            typedef typename InvokerBaseImpl<3,F>::args3_type args3_type;
+            std::vector<SendHandle<F> > sendMany(args1_type& a1, args2_type& a2, args3_type& a3)
+            {
+                return BaseImpl::sendMany_impl(a1, a2, a3);
+            }
+
         };
 
         template<class F, class BaseImpl>
@@ -208,6 +234,15 @@ namespace RTT
                 return BaseImpl::template send_impl<arg1_type, arg2_type, arg3_type, arg4_type>(t1, t2, t3, t4);
             }
 
+            typedef typename InvokerBaseImpl<4,F>::args1_type args1_type;
+            typedef typename InvokerBaseImpl<4,F>::args2_type args2_type;
+            typedef typename InvokerBaseImpl<4,F>::args3_type args3_type;
+            typedef typename InvokerBaseImpl<4,F>::args4_type args4_type;
+            std::vector<SendHandle<F> > sendMany(args1_type& a1, args2_type& a2, args3_type& a3, args4_type& a4)
+            {
+                return BaseImpl::sendMany_impl(a1, a2, a3, a4);
+            }
+
         };
 
         template<class F, class BaseImpl>
@@ -244,6 +279,16 @@ namespace RTT
                 return BaseImpl::template send_impl<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type>(t1, t2, t3, t4, t5);
             }
 
+            typedef typename InvokerBaseImpl<5,F>::args1_type args1_type;
+            typedef typename InvokerBaseImpl<5,F>::args2_type args2_type;
+            typedef typename InvokerBaseImpl<5,F>::args3_type args3_type;
+            typedef typename InvokerBaseImpl<5,F>::args4_type args4_type;
+            typedef typename InvokerBaseImpl<5,F>::args5_type args5_type;
+            std::vector<SendHandle<F> > sendMany(args1_type& a1, args2_type& a2, args3_type& a3, args4_type& a4, args5_type& a5)
+            {
+                return BaseImpl::sendMany_impl(a1, a2, a3, a4, a5);
+            }
+
         };
 
         template<class F, class BaseImpl>
@@ -281,6 +326,17 @@ namespace RTT
                 return BaseImpl::template send_impl<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type>(t1, t2, t3, t4, t5, t6);
             }
 
+            typedef typename InvokerBaseImpl<6,F>::args1_type args1_type;
+            typedef typename InvokerBaseImpl<6,F>::args2_type args2_type;
+            typedef typename InvokerBaseImpl<6,F>::args3_type args3_type;
+            typedef typename InvokerBaseImpl<6,F>::args4_type args4_type;
+            typedef typename InvokerBaseImpl<6,F>::args5_type args5_type;
+            typedef typename InvokerBaseImpl<6,F>::args6_type args6_type;
+            std::vector<SendHandle<F> > sendMany(args1_type& a1, args2_type& a2, args3_type& a3, args4_type& a4, args5_type& a5, args6_type& a6)
+            {
+                return BaseImpl::sendMany_impl(a1, a2, a3, a4, a5, a6);
+            }
+
         };
 
         template<class F, class BaseImpl>
@@ -319,6 +375,18 @@ namespace RTT
                 return BaseImpl::template send_impl<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type>(t1, t2, t3, t4, t5, t6, t7);
             }
 
+            typedef typename InvokerBaseImpl<7,F>::args1_type args1_type;
+            typedef typename InvokerBaseImpl<7,F>::args2_type args2_type;
+            typedef typename InvokerBaseImpl<7,F>::args3_type args3_type;
+            typedef typename InvokerBaseImpl<7,F>::args4_type args4_type;
+            typedef typename InvokerBaseImpl<7,F>::args5_type args5_type;
+            typedef typename InvokerBaseImpl<7,F>::args6_type args6_type;
+            typedef typename InvokerBaseImpl<7,F>::args7_type args7_type;
+            std::vector<SendHandle<F> > sendMany(args1_type& a1, args2_type& a2, args3_type& a3, args4_type& a4, args5_type& a5, args6_type& a6, args7_type& a7)
+            {
+                return BaseImpl::sendMany_impl(a1, a2, a3, a4, a5, a6, a7);
+            }
+
         };
 
    }
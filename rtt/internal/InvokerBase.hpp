@@ -45,6 +45,8 @@
 #include "NA.hpp"
 #include "../SendHandle.hpp"
 #include "../rtt-fwd.hpp"
+#include <vector>
+#include <deque>
 
 namespace RTT
 {
@@ -58,6 +60,35 @@ namespace RTT
         template<int, class F>
         struct InvokerBaseImpl;
 
+        /**
+         * The container type in which sendMany() receives the
+         * values of an argument of value type \a V.
+         */
+        template<class V>
+        struct ArgsContainer
+        {
+            typedef std::vector<V> type;
+        };
+
+        /**
+         * A std::vector<bool> can not refer to its elements,
+         * so bool arguments are received in a std::deque.
+         */
+        template<>
+        struct ArgsContainer<bool>
+        {
+            typedef std::deque<bool> type;
+        };
+
+        /**
+         * The container type in which sendMany() receives the
+         * values of an argument of type \a T.
+         */
+        template<class T>
+        struct ArgsVector
+            : public ArgsContainer<typename boost::remove_const<typename boost::remove_reference<T>::type>::type>
+        {};
+
         /**
          * This is the base class that defines the interface
          * of all invocable method implementations.
@@ -78,6 +109,23 @@ namespace RTT
             virtual ~InvokerBaseImpl() {}
             virtual SendHandle<F> send() = 0;
             virtual result_type call() = 0;
+            /**
+             * Sends \a n calls at once.
+             * @return A SendHandle for each call, or no handles at all
+             * if the calls could not be sent.
+             */
+            virtual std::vector<SendHandle<F> > sendMany(unsigned int n) = 0;
+
+            /**
+             * Implements sendMany() with a send() for each call.
+             */
+            std::vector<SendHandle<F> > sendMany_impl(unsigned int n) {
+                std::vector<SendHandle<F> > handles;
+                handles.reserve(n);
+                for (unsigned int i = 0; i != n; ++i)
+                    handles.push_back( this->send() );
+                return handles;
+            }
         };
 
         template<class F>
@@ -88,6 +136,26 @@ namespace RTT
             virtual ~InvokerBaseImpl() {}
             virtual result_type call(arg1_type a1) = 0;
             virtual SendHandle<F> send(arg1_type a1) = 0;
+            typedef typename ArgsVector<arg1_type>::type args1_type;
+            /**
+             * Sends a call for each element of \a a1 at once. Reference
+             * arguments refer to the elements of the vector, which must
+             * remain in place until the calls are collected.
+             * @return A SendHandle for each call, or no handles at all
+             * if the calls could not be sent.
+             */
+            virtual std::vector<SendHandle<F> > sendMany(args1_type& a1) = 0;
+
+            /**
+             * Implements sendMany() with a send() for each call.
+             */
+            std::vector<SendHandle<F> > sendMany_impl(args1_type& a1) {
+                std::vector<SendHandle<F> > handles;
+                handles.reserve(a1.size());
+                for (typename args1_type::size_type i = 0; i != a1.size(); ++i)
+                    handles.push_back( this->send(a1[i]) );
+                return handles;
+            }
         };
 
         template<class F>
@@ -99,6 +167,29 @@ namespace RTT
             virtual ~InvokerBaseImpl() {}
             virtual result_type call(arg1_type a1, arg2_type a2) = 0;
             virtual SendHandle<F> send(arg1_type a1, arg2_type a2) = 0;
+            typedef typename ArgsVector<arg1_type>::type args1_type;
+            typedef typename ArgsVector<arg2_type>::type args2_type;
+            /**
+             * Sends a call for each index of the argument vectors at once.
+             * All vectors must have the size of \a a1, or no call is sent
+             * and no handles are returned.
+             * @see InvokerBaseImpl<1,F>::sendMany
+             */
+            virtual std::vector<SendHandle<F> > sendMany(args1_type& a1, args2_type& a2) = 0;
+
+            /**
+             * Implements sendMany() with a send() for each call.
+             */
+            std::vector<SendHandle<F> > sendMany_impl(args1_type& a1, args2_type& a2) {
+                // every call needs a value of each argument.
+                if ( a2.size() != a1.size() )
+                    return std::vector<SendHandle<F> >();
+                std::vector<SendHandle<F> > handles;
+                handles.reserve(a1.size());
+                for (typename args1_type::size_type i = 0; i != a1.size(); ++i)
+                    handles.push_back( this->send(a1[i], a2[i]) );
+                return handles;
+            }
         };
 
         template<class F>
@@ -111,6 +202,29 @@ namespace RTT
             virtual ~InvokerBaseImpl() {}
             virtual result_type call(arg1_type a1, arg2_type a2, arg3_type a3) = 0;
             virtual SendHandle<F> send(arg1_type a1, arg2_type a2, arg3_type a3) = 0;
+            typedef typename ArgsVector<arg1_type>::type args1_type;
+            typedef typename ArgsVector<arg2_type>::type args2_type;
+            typedef typename ArgsVector<arg3_type>::type args3_type;
+            /**
+             * Sends a call for each index of the argument vectors at once.
+             * All vectors must have the size of \a a1, or no call is sent
+             * and no handles are returned.
+             * @see InvokerBaseImpl<1,F>::sendMany
+             */
+            virtual std::vector<SendHandle<F> > sendMany(args1_type& a1, args2_type& a2, args3_type& a3) = 0;
+
+            /**
+             * Implements sendMany() with a send() for each call.
+             */
+            std::vector<SendHandle<F> > sendMany_impl(args1_type& a1, args2_type& a2, args3_type& a3) {
+                if ( a2.size() != a1.size() || a3.size() != a1.size() )
+                    return std::vector<SendHandle<F> >();
+                std::vector<SendHandle<F> > handles;
+                handles.reserve(a1.size());
+                for (typename args1_type::size_type i = 0; i != a1.size(); ++i)
+                    handles.push_back( this->send(a1[i], a2[i], a3[i]) );
+                return handles;
+            }
         };
 
         template<class F>
@@ -124,6 +238,30 @@ namespace RTT
             virtual ~InvokerBaseImpl() {}
             virtual result_type call(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4) = 0;
             virtual SendHandle<F> send(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4) = 0;
+            typedef typename ArgsVector<arg1_type>::type args1_type;
+            typedef typename ArgsVector<arg2_type>::type args2_type;
+            typedef typename ArgsVector<arg3_type>::type args3_type;
+            typedef typename ArgsVector<arg4_type>::type args4_type;
+            /**
+             * Sends a call for each index of the argument vectors at once.
+             * All vectors must have the size of \a a1, or no call is sent
+             * and no handles are returned.
+             * @see InvokerBaseImpl<1,F>::sendMany
+             */
+            virtual std::vector<SendHandle<F> > sendMany(args1_type& a1, args2_type& a2, args3_type& a3, args4_type& a4) = 0;
+
+            /**
+             * Implements sendMany() with a send() for each call.
+             */
+            std::vector<SendHandle<F> > sendMany_impl(args1_type& a1, args2_type& a2, args3_type& a3, args4_type& a4) {
+                if ( a2.size() != a1.size() || a3.size() != a1.size() || a4.size() != a1.size() )
+                    return std::vector<SendHandle<F> >();
+                std::vector<SendHandle<F> > handles;
+                handles.reserve(a1.size());
+                for (typename args1_type::size_type i = 0; i != a1.size(); ++i)
+                    handles.push_back( this->send(a1[i], a2[i], a3[i], a4[i]) );
+                return handles;
+            }
         };
 
         template<class F>
@@ -138,6 +276,31 @@ namespace RTT
             virtual ~InvokerBaseImpl() {}
             virtual result_type call(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5) = 0;
             virtual SendHandle<F> send(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5) = 0;
+            typedef typename ArgsVector<arg1_type>::type args1_type;
+            typedef typename ArgsVector<arg2_type>::type args2_type;
+            typedef typename ArgsVector<arg3_type>::type args3_type;
+            typedef typename ArgsVector<arg4_type>::type args4_type;
+            typedef typename ArgsVector<arg5_type>::type args5_type;
+            /**
+             * Sends a call for each index of the argument vectors at once.
+             * All vectors must have the size of \a a1, or no call is sent
+             * and no handles are returned.
+             * @see InvokerBaseImpl<1,F>::sendMany
+             */
+            virtual std::vector<SendHandle<F> > sendMany(args1_type& a1, args2_type& a2, args3_type& a3, args4_type& a4, args5_type& a5) = 0;
+
+            /**
+             * Implements sendMany() with a send() for each call.
+             */
+            std::vector<SendHandle<F> > sendMany_impl(args1_type& a1, args2_type& a2, args3_type& a3, args4_type& a4, args5_type& a5) {
+                if ( a2.size() != a1.size() || a3.size() != a1.size() || a4.size() != a1.size() || a5.size() != a1.size() )
+                    return std::vector<SendHandle<F> >();
+                std::vector<SendHandle<F> > handles;
+                handles.reserve(a1.size());
+                for (typename args1_type::size_type i = 0; i != a1.size(); ++i)
+                    handles.push_back( this->send(a1[i], a2[i], a3[i], a4[i], a5[i]) );
+                return handles;
+            }
         };
 
         template<class F>
@@ -153,6 +316,32 @@ namespace RTT
             virtual ~InvokerBaseImpl() {}
             virtual result_type call(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6) = 0;
             virtual SendHandle<F> send(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6) = 0;
+            typedef typename ArgsVector<arg1_type>::type args1_type;
+            typedef typename ArgsVector<arg2_type>::type args2_type;
+            typedef typename ArgsVector<arg3_type>::type args3_type;
+            typedef typename ArgsVector<arg4_type>::type args4_type;
+            typedef typename ArgsVector<arg5_type>::type args5_type;
+            typedef typename ArgsVector<arg6_type>::type args6_type;
+            /**
+             * Sends a call for each index of the argument vectors at once.
+             * All vectors must have the size of \a a1, or no call is sent
+             * and no handles are returned.
+             * @see InvokerBaseImpl<1,F>::sendMany
+             */
+            virtual std::vector<SendHandle<F> > sendMany(args1_type& a1, args2_type& a2, args3_type& a3, args4_type& a4, args5_type& a5, args6_type& a6) = 0;
+
+            /**
+             * Implements sendMany() with a send() for each call.
+             */
+            std::vector<SendHandle<F> > sendMany_impl(args1_type& a1, args2_type& a2, args3_type& a3, args4_type& a4, args5_type& a5, args6_type& a6) {
+                if ( a2.size() != a1.size() || a3.size() != a1.size() || a4.size() != a1.size() || a5.size() != a1.size() || a6.size() != a1.size() )
+                    return std::vector<SendHandle<F> >();
+                std::vector<SendHandle<F> > handles;
+                handles.reserve(a1.size());
+                for (typename args1_type::size_type i = 0; i != a1.size(); ++i)
+                    handles.push_back( this->send(a1[i], a2[i], a3[i], a4[i], a5[i], a6[i]) );
+                return handles;
+            }
         };
 
         template<class F>
@@ -169,6 +358,33 @@ namespace RTT
             virtual ~InvokerBaseImpl() {}
             virtual result_type call(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7) = 0;
             virtual SendHandle<F> send(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7) = 0;
+            typedef typename ArgsVector<arg1_type>::type args1_type;
+            typedef typename ArgsVector<arg2_type>::type args2_type;
+            typedef typename ArgsVector<arg3_type>::type args3_type;
+            typedef typename ArgsVector<arg4_type>::type args4_type;
+            typedef typename ArgsVector<arg5_type>::type args5_type;
+            typedef typename ArgsVector<arg6_type>::type args6_type;
+            typedef typename ArgsVector<arg7_type>::type args7_type;
+            /**
+             * Sends a call for each index of the argument vectors at once.
+             * All vectors must have the size of \a a1, or no call is sent
+             * and no handles are returned.
+             * @see InvokerBaseImpl<1,F>::sendMany
+             */
+            virtual std::vector<SendHandle<F> > sendMany(args1_type& a1, args2_type& a2, args3_type& a3, args4_type& a4, args5_type& a5, args6_type& a6, args7_type& a7) = 0;
+
+            /**
+             * Implements sendMany() with a send() for each call.
+             */
+            std::vector<SendHandle<F> > sendMany_impl(args1_type& a1, args2_type& a2, args3_type& a3, args4_type& a4, args5_type& a5, args6_type& a6, args7_type& a7) {
+                if ( a2.size() != a1.size() || a3.size() != a1.size() || a4.size() != a1.size() || a5.size() != a1.size() || a6.size() != a1.size() || a7.size() != a1.size() )
+                    return std::vector<SendHandle<F> >();
+                std::vector<SendHandle<F> > handles;
+                handles.reserve(a1.size());
+                for (typename args1_type::size_type i = 0; i != a1.size(); ++i)
+                    handles.push_back( this->send(a1[i], a2[i], a3[i], a4[i], a5[i], a6[i], a7[i]) );
+                return handles;
+            }
         };
    }
 }
@@ -41,6 +41,7 @@
 
 #include <boost/type_traits.hpp>
 #include "NA.hpp"
+#include "InvokerBase.hpp"
 #include "../rtt-fwd.hpp"
 
 namespace RTT
@@ -87,6 +88,19 @@ namespace RTT
                 return SendHandle<F>();
             }
 
+            /**
+             * Sends \a n calls in one message to the receiving
+             * ExecutionEngine.
+             * @return A SendHandle for each call, or no handles at all
+             * if the calls could not be sent.
+             */
+            std::vector<SendHandle<F> > sendMany(unsigned int n)
+            {
+                if (impl)
+                    return impl->sendMany(n);
+                return std::vector<SendHandle<F> >();
+            }
+
         protected:
             ToInvoke impl;
         };
@@ -121,6 +135,22 @@ namespace RTT
                 return SendHandle<F>();
             }
 
+            typedef typename ArgsVector<arg1_type>::type args1_type;
+            /**
+             * Sends a call for each element of \a a1 in one message
+             * to the receiving ExecutionEngine. Reference arguments refer
+             * to the elements of the vector, which must remain in place
+             * until the calls are collected.
+             * @return A SendHandle for each call, or no handles at all
+             * if the calls could not be sent.
+             */
+            std::vector<SendHandle<F> > sendMany(args1_type& a1)
+            {
+                if (impl)
+                    return impl->sendMany(a1);
+                return std::vector<SendHandle<F> >();
+            }
+
         protected:
             ToInvoke impl;
         };
@@ -156,6 +186,22 @@ namespace RTT
                     return impl->send(a1,a2);
                 return SendHandle<F>();
             }
+
+            typedef typename ArgsVector<arg1_type>::type args1_type;
+            typedef typename ArgsVector<arg2_type>::type args2_type;
+            /**
+             * Sends a call for each index of the argument vectors in one
+             * message to the receiving ExecutionEngine. All vectors must
+             * have the size of \a a1.
+             * @return A SendHandle for each call, or no handles at all
+             * if the calls could not be sent.
+             */
+            std::vector<SendHandle<F> > sendMany(args1_type& a1, args2_type& a2)
+            {
+                if (impl)
+                    return impl->sendMany(a1,a2);
+                return std::vector<SendHandle<F> >();
+            }
         protected:
             ToInvoke impl;
         };
@@ -192,6 +238,23 @@ namespace RTT
                     return impl->send(a1,a2,a3);
                 return SendHandle<F>();
             }
+
+            typedef typename ArgsVector<arg1_type>::type args1_type;
+            typedef typename ArgsVector<arg2_type>::type args2_type;
+            typedef typename ArgsVector<arg3_type>::type args3_type;
+            /**
+             * Sends a call for each index of the argument vectors in one
+             * message to the receiving ExecutionEngine. All vectors must
+             * have the size of \a a1.
+             * @return A SendHandle for each call, or no handles at all
+             * if the calls could not be sent.
+             */
+            std::vector<SendHandle<F> > sendMany(args1_type& a1, args2_type& a2, args3_type& a3)
+            {
+                if (impl)
+                    return impl->sendMany(a1,a2,a3);
+                return std::vector<SendHandle<F> >();
+            }
         protected:
             ToInvoke impl;
         };
@@ -230,6 +293,24 @@ namespace RTT
                 return SendHandle<F>();
             }
 
+            typedef typename ArgsVector<arg1_type>::type args1_type;
+            typedef typename ArgsVector<arg2_type>::type args2_type;
+            typedef typename ArgsVector<arg3_type>::type args3_type;
+            typedef typename ArgsVector<arg4_type>::type args4_type;
+            /**
+             * Sends a call for each index of the argument vectors in one
+             * message to the receiving ExecutionEngine. All vectors must
+             * have the size of \a a1.
+             * @return A SendHandle for each call, or no handles at all
+             * if the calls could not be sent.
+             */
+            std::vector<SendHandle<F> > sendMany(args1_type& a1, args2_type& a2, args3_type& a3, args4_type& a4)
+            {
+                if (impl)
+                    return impl->sendMany(a1,a2,a3,a4);
+                return std::vector<SendHandle<F> >();
+            }
+
         protected:
             ToInvoke impl;
         };
@@ -269,6 +350,25 @@ namespace RTT
                 return SendHandle<F>();
             }
 
+            typedef typename ArgsVector<arg1_type>::type args1_type;
+            typedef typename ArgsVector<arg2_type>::type args2_type;
+            typedef typename ArgsVector<arg3_type>::type args3_type;
+            typedef typename ArgsVector<arg4_type>::type args4_type;
+            typedef typename ArgsVector<arg5_type>::type args5_type;
+            /**
+             * Sends a call for each index of the argument vectors in one
+             * message to the receiving ExecutionEngine. All vectors must
+             * have the size of \a a1.
+             * @return A SendHandle for each call, or no handles at all
+             * if the calls could not be sent.
+             */
+            std::vector<SendHandle<F> > sendMany(args1_type& a1, args2_type& a2, args3_type& a3, args4_type& a4, args5_type& a5)
+            {
+                if (impl)
+                    return impl->sendMany(a1,a2,a3,a4,a5);
+                return std::vector<SendHandle<F> >();
+            }
+
         protected:
             ToInvoke impl;
         };
@@ -309,6 +409,26 @@ namespace RTT
                 return SendHandle<F>();
             }
 
+            typedef typename ArgsVector<arg1_type>::type args1_type;
+            typedef typename ArgsVector<arg2_type>::type args2_type;
+            typedef typename ArgsVector<arg3_type>::type args3_type;
+            typedef typename ArgsVector<arg4_type>::type args4_type;
+            typedef typename ArgsVector<arg5_type>::type args5_type;
+            typedef typename ArgsVector<arg6_type>::type args6_type;
+            /**
+             * Sends a call for each index of the argument vectors in one
+             * message to the receiving ExecutionEngine. All vectors must
+             * have the size of \a a1.
+             * @return A SendHandle for each call, or no handles at all
+             * if the calls could not be sent.
+             */
+            std::vector<SendHandle<F> > sendMany(args1_type& a1, args2_type& a2, args3_type& a3, args4_type& a4, args5_type& a5, args6_type& a6)
+            {
+                if (impl)
+                    return impl->sendMany(a1,a2,a3,a4,a5,a6);
+                return std::vector<SendHandle<F> >();
+            }
+
         protected:
             ToInvoke impl;
         };
@@ -350,6 +470,27 @@ namespace RTT
                 return SendHandle<F>();
             }
 
+            typedef typename ArgsVector<arg1_type>::type args1_type;
+            typedef typename ArgsVector<arg2_type>::type args2_type;
+            typedef typename ArgsVector<arg3_type>::type args3_type;
+            typedef typename ArgsVector<arg4_type>::type args4_type;
+            typedef typename ArgsVector<arg5_type>::type args5_type;
+            typedef typename ArgsVector<arg6_type>::type args6_type;
+            typedef typename ArgsVector<arg7_type>::type args7_type;
+            /**
+             * Sends a call for each index of the argument vectors in one
+             * message to the receiving ExecutionEngine. All vectors must
+             * have the size of \a a1.
+             * @return A SendHandle for each call, or no handles at all
+             * if the calls could not be sent.
+             */
+            std::vector<SendHandle<F> > sendMany(args1_type& a1, args2_type& a2, args3_type& a3, args4_type& a4, args5_type& a5, args6_type& a6, args7_type& a7)
+            {
+                if (impl)
+                    return impl->sendMany(a1,a2,a3,a4,a5,a6,a7);
+                return std::vector<SendHandle<F> >();
+            }
+
         protected:
             ToInvoke impl;
         };
@@ -42,6 +42,7 @@
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
+#include <boost/enable_shared_from_this.hpp>
 #include <string>
 #include "Invoker.hpp"
 #include "../base/OperationCallerBase.hpp"
@@ -51,8 +52,11 @@
 #include "../SendHandle.hpp"
 #include "../ExecutionEngine.hpp"
 #include "OperationCallerBinder.hpp"
+#include "SendBatch.hpp"
 #include <boost/fusion/include/vector_tie.hpp>
 #include "../os/oro_allocator.hpp"
+#include "../os/CAS.hpp"
+#include <vector>
 
 #include <iostream>
 // For doing I/O
@@ -77,7 +81,8 @@ namespace RTT
         class LocalOperationCallerImpl
             : public base::OperationCallerBase<FunctionT>,
               public internal::CollectBase<FunctionT>,
-              protected BindStorage<FunctionT>
+              protected BindStorage<FunctionT>,
+              public boost::enable_shared_from_this<LocalOperationCallerImpl<FunctionT> >
         {
         public:
             LocalOperationCallerImpl() {}
@@ -106,19 +111,61 @@ namespace RTT
                     if ( this->caller){
                         result = this->caller->process(this);
                     }
-                    if (!result)
+                    if (!result) {
+                        // a completion set from now on is posted once more, and fails too.
+                        if ( !os::CAS(&mcompletion.state, int(Pending), int(Returned)) )
+                            mcompletion.done.clear();
                         dispose();
+                    }
                 } else {
                     //cout << "received method done msg."<<endl;
                     // Already executed, are in caller.
                     // nop, we will check ret in collect()
                     // This is the place to call call-back functions,
                     // since we're in the caller's (or proxy's) EE.
-                    dispose();
+                    // Release self first, such that a completion set after
+                    // the Returned state may post this object again.
+                    typename base::OperationCallerBase<FunctionT>::shared_ptr keep;
+                    keep.swap(self);
+                    if ( !os::CAS(&mcompletion.state, int(Pending), int(Returned)) )
+                        runCompletion();
                 }
                 return;
             }
 
+            virtual bool setCompletion(boost::function<void(void)> const& done) {
+                if ( !this->caller || mcompletion.state == Callback )
+                    return false;
+                mcompletion.done = done;
+                if ( os::CAS(&mcompletion.state, int(Pending), int(Callback)) )
+                    return true;
+                // the call already returned to the caller: return it once more.
+                mcompletion.state = Callback;
+                self = this->shared_from_this();
+                if ( this->caller->process(this) )
+                    return true;
+                mcompletion.done.clear();
+                mcompletion.state = Returned;
+                dispose();
+                return false;
+            }
+
+            /**
+             * Runs the completion set by setCompletion() in the caller's EE.
+             */
+            void runCompletion() {
+                boost::function<void(void)> done;
+                done.swap(mcompletion.done);
+                mcompletion.state = Returned;
+                try {
+                    done();
+                } catch (std::exception& e) {
+                    log(Error) << "Exception raised while running the completion of an operation : " << e.what() << endlog();
+                } catch (...) {
+                    log(Error) << "Unknown exception raised while running the completion of an operation." << endlog();
+                }
+            }
+
             /**
              * As long as dispose (or executeAndDispose() ) is
              * not called, this object will not be destroyed.
@@ -127,6 +174,42 @@ namespace RTT
                 self.reset();
             }
 
+            /**
+             * Sets the caller and preallocates getSendPoolSize() call
+             * records for send(). A record is recycled once its SendHandle
+             * was dropped and its message was processed.
+             */
+            virtual void setCaller(ExecutionEngine* ee) {
+                base::OperationCallerInterface::setCaller(ee);
+                mpool.records.clear();
+                // a caller under construction has no function to clone yet.
+                if ( !this->mmeth )
+                    return;
+                for (unsigned int i = 0; i != this->getSendPoolSize(); ++i)
+                    mpool.records.push_back( this->cloneRT() );
+            }
+
+            /**
+             * Returns a free call record of the pool, or a new clone
+             * if all records are in use or another thread is sending.
+             */
+            shared_ptr getRecord() {
+                if ( os::CAS(&mpool.busy, 0, 1) ) {
+                    for (typename std::vector<shared_ptr>::iterator it = mpool.records.begin(); it != mpool.records.end(); ++it) {
+                        // only the pool refers to a record that is not in use.
+                        if ( it->use_count() == 1 ) {
+                            shared_ptr cl = *it;
+                            mpool.busy = 0;
+                            cl->retv.reset();
+                            cl->mcompletion.state = Pending;
+                            return cl;
+                        }
+                    }
+                    mpool.busy = 0;
+                }
+                return this->cloneRT();
+            }
+
             SendHandle<Signature> do_send(shared_ptr cl) {
                 //std::cout << "Sending clone..."<<std::endl;
                 ExecutionEngine* receiver = this->getMessageProcessor();
@@ -141,13 +224,13 @@ namespace RTT
             }
             // We need a handle object !
             SendHandle<Signature> send_impl() {
-                return do_send( this->cloneRT() );
+                return do_send( this->getRecord() );
             }
 
             template<class T1>
             SendHandle<Signature> send_impl( T1 a1 ) {
                 // bind types from Storage<Function>
-                shared_ptr cl = this->cloneRT();
+                shared_ptr cl = this->getRecord();
                 cl->store( a1 );
                 return do_send(cl);
             }
@@ -155,7 +238,7 @@ namespace RTT
             template<class T1, class T2>
             SendHandle<Signature> send_impl( T1 a1, T2 a2 ) {
                 // bind types from Storage<Function>
-                shared_ptr cl = this->cloneRT();
+                shared_ptr cl = this->getRecord();
                 cl->store( a1,a2 );
                 return do_send(cl);
             }
@@ -163,7 +246,7 @@ namespace RTT
             template<class T1, class T2, class T3>
             SendHandle<Signature> send_impl( T1 a1, T2 a2, T3 a3 ) {
                 // bind types from Storage<Function>
-                shared_ptr cl = this->cloneRT();
+                shared_ptr cl = this->getRecord();
                 cl->store( a1,a2,a3 );
                 return do_send(cl);
             }
@@ -171,7 +254,7 @@ namespace RTT
             template<class T1, class T2, class T3, class T4>
             SendHandle<Signature> send_impl( T1 a1, T2 a2, T3 a3, T4 a4 ) {
                 // bind types from Storage<Function>
-                shared_ptr cl = this->cloneRT();
+                shared_ptr cl = this->getRecord();
                 cl->store( a1,a2,a3,a4 );
                 return do_send(cl);
             }
@@ -179,7 +262,7 @@ namespace RTT
             template<class T1, class T2, class T3, class T4, class T5>
             SendHandle<Signature> send_impl( T1 a1, T2 a2, T3 a3, T4 a4, T5 a5 ) {
                 // bind types from Storage<Function>
-                shared_ptr cl = this->cloneRT();
+                shared_ptr cl = this->getRecord();
                 cl->store( a1,a2,a3,a4,a5 );
                 return do_send(cl);
             }
@@ -187,7 +270,7 @@ namespace RTT
             template<class T1, class T2, class T3, class T4, class T5, class T6>
             SendHandle<Signature> send_impl( T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6 ) {
                 // bind types from Storage<Function>
-                shared_ptr cl = this->cloneRT();
+                shared_ptr cl = this->getRecord();
                 cl->store( a1,a2,a3,a4,a5,a6 );
                 return do_send(cl);
             }
@@ -195,11 +278,172 @@ namespace RTT
             template<class T1, class T2, class T3, class T4, class T5, class T6, class T7>
             SendHandle<Signature> send_impl( T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7 ) {
                 // bind types from Storage<Function>
-                shared_ptr cl = this->cloneRT();
+                shared_ptr cl = this->getRecord();
                 cl->store( a1,a2,a3,a4,a5,a6,a7 );
                 return do_send(cl);
             }
 
+            /**
+             * Adds the call record \a cl to \a batch.
+             */
+            SendHandle<Signature> batch_send(SendBatch::shared_ptr const& batch, shared_ptr cl) {
+                cl->self = cl;
+                batch->add( cl.get() );
+                return SendHandle<Signature>( cl );
+            }
+
+            /**
+             * Sends all calls of \a batch in one message.
+             * @return false if the receiver rejected the message.
+             */
+            bool do_sendMany(SendBatch::shared_ptr batch) {
+                if ( batch->size() == 0 )
+                    return true;
+                ExecutionEngine* receiver = this->getMessageProcessor();
+                batch->self = batch;
+                if ( receiver && receiver->process( batch.get() ) )
+                    return true;
+                batch->dispose();
+                return false;
+            }
+
+            std::vector<SendHandle<Signature> > sendMany_impl(unsigned int n) {
+                SendBatch::shared_ptr batch = boost::make_shared<SendBatch>();
+                batch->reserve(n);
+                std::vector<SendHandle<Signature> > handles;
+                handles.reserve(n);
+                for (unsigned int i = 0; i != n; ++i)
+                    handles.push_back( batch_send(batch, this->getRecord()) );
+                if ( !do_sendMany(batch) )
+                    handles.clear();
+                return handles;
+            }
+
+            template<class A1>
+            std::vector<SendHandle<Signature> > sendMany_impl( A1& a1 ) {
+                SendBatch::shared_ptr batch = boost::make_shared<SendBatch>();
+                batch->reserve( a1.size() );
+                std::vector<SendHandle<Signature> > handles;
+                handles.reserve( a1.size() );
+                for (typename A1::size_type i = 0; i != a1.size(); ++i) {
+                    shared_ptr cl = this->getRecord();
+                    cl->store( a1[i] );
+                    handles.push_back( batch_send(batch, cl) );
+                }
+                if ( !do_sendMany(batch) )
+                    handles.clear();
+                return handles;
+            }
+
+            template<class A1, class A2>
+            std::vector<SendHandle<Signature> > sendMany_impl( A1& a1, A2& a2 ) {
+                // every call needs a value of each argument.
+                if ( a2.size() != a1.size() )
+                    return std::vector<SendHandle<Signature> >();
+                SendBatch::shared_ptr batch = boost::make_shared<SendBatch>();
+                batch->reserve( a1.size() );
+                std::vector<SendHandle<Signature> > handles;
+                handles.reserve( a1.size() );
+                for (typename A1::size_type i = 0; i != a1.size(); ++i) {
+                    shared_ptr cl = this->getRecord();
+                    cl->store( a1[i],a2[i] );
+                    handles.push_back( batch_send(batch, cl) );
+                }
+                if ( !do_sendMany(batch) )
+                    handles.clear();
+                return handles;
+            }
+
+            template<class A1, class A2, class A3>
+            std::vector<SendHandle<Signature> > sendMany_impl( A1& a1, A2& a2, A3& a3 ) {
+                if ( a2.size() != a1.size() || a3.size() != a1.size() )
+                    return std::vector<SendHandle<Signature> >();
+                SendBatch::shared_ptr batch = boost::make_shared<SendBatch>();
+                batch->reserve( a1.size() );
+                std::vector<SendHandle<Signature> > handles;
+                handles.reserve( a1.size() );
+                for (typename A1::size_type i = 0; i != a1.size(); ++i) {
+                    shared_ptr cl = this->getRecord();
+                    cl->store( a1[i],a2[i],a3[i] );
+                    handles.push_back( batch_send(batch, cl) );
+                }
+                if ( !do_sendMany(batch) )
+                    handles.clear();
+                return handles;
+            }
+
+            template<class A1, class A2, class A3, class A4>
+            std::vector<SendHandle<Signature> > sendMany_impl( A1& a1, A2& a2, A3& a3, A4& a4 ) {
+                if ( a2.size() != a1.size() || a3.size() != a1.size() || a4.size() != a1.size() )
+                    return std::vector<SendHandle<Signature> >();
+                SendBatch::shared_ptr batch = boost::make_shared<SendBatch>();
+                batch->reserve( a1.size() );
+                std::vector<SendHandle<Signature> > handles;
+                handles.reserve( a1.size() );
+                for (typename A1::size_type i = 0; i != a1.size(); ++i) {
+                    shared_ptr cl = this->getRecord();
+                    cl->store( a1[i],a2[i],a3[i],a4[i] );
+                    handles.push_back( batch_send(batch, cl) );
+                }
+                if ( !do_sendMany(batch) )
+                    handles.clear();
+                return handles;
+            }
+
+            template<class A1, class A2, class A3, class A4, class A5>
+            std::vector<SendHandle<Signature> > sendMany_impl( A1& a1, A2& a2, A3& a3, A4& a4, A5& a5 ) {
+                if ( a2.size() != a1.size() || a3.size() != a1.size() || a4.size() != a1.size() || a5.size() != a1.size() )
+                    return std::vector<SendHandle<Signature> >();
+                SendBatch::shared_ptr batch = boost::make_shared<SendBatch>();
+                batch->reserve( a1.size() );
+                std::vector<SendHandle<Signature> > handles;
+                handles.reserve( a1.size() );
+                for (typename A1::size_type i = 0; i != a1.size(); ++i) {
+                    shared_ptr cl = this->getRecord();
+                    cl->store( a1[i],a2[i],a3[i],a4[i],a5[i] );
+                    handles.push_back( batch_send(batch, cl) );
+                }
+                if ( !do_sendMany(batch) )
+                    handles.clear();
+                return handles;
+            }
+
+            template<class A1, class A2, class A3, class A4, class A5, class A6>
+            std::vector<SendHandle<Signature> > sendMany_impl( A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6 ) {
+                if ( a2.size() != a1.size() || a3.size() != a1.size() || a4.size() != a1.size() || a5.size() != a1.size() || a6.size() != a1.size() )
+                    return std::vector<SendHandle<Signature> >();
+                SendBatch::shared_ptr batch = boost::make_shared<SendBatch>();
+                batch->reserve( a1.size() );
+                std::vector<SendHandle<Signature> > handles;
+                handles.reserve( a1.size() );
+                for (typename A1::size_type i = 0; i != a1.size(); ++i) {
+                    shared_ptr cl = this->getRecord();
+                    cl->store( a1[i],a2[i],a3[i],a4[i],a5[i],a6[i] );
+                    handles.push_back( batch_send(batch, cl) );
+                }
+                if ( !do_sendMany(batch) )
+                    handles.clear();
+                return handles;
+            }
+
+            template<class A1, class A2, class A3, class A4, class A5, class A6, class A7>
+            std::vector<SendHandle<Signature> > sendMany_impl( A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7 ) {
+                if ( a2.size() != a1.size() || a3.size() != a1.size() || a4.size() != a1.size() || a5.size() != a1.size() || a6.size() != a1.size() || a7.size() != a1.size() )
+                    return std::vector<SendHandle<Signature> >();
+                SendBatch::shared_ptr batch = boost::make_shared<SendBatch>();
+                batch->reserve( a1.size() );
+                std::vector<SendHandle<Signature> > handles;
+                handles.reserve( a1.size() );
+                for (typename A1::size_type i = 0; i != a1.size(); ++i) {
+                    shared_ptr cl = this->getRecord();
+                    cl->store( a1[i],a2[i],a3[i],a4[i],a5[i],a6[i],a7[i] );
+                    handles.push_back( batch_send(batch, cl) );
+                }
+                if ( !do_sendMany(batch) )
+                    handles.clear();
+                return handles;
+            }
+
 
             SendStatus collectIfDone_impl() {
                 if ( this->retv.isExecuted()) {
@@ -292,55 +536,55 @@ namespace RTT
 
             SendStatus collect_impl() {
                 if (!checkCaller()) return CollectFailure;
-                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)) );
+                this->caller->waitForMessages( isExecuted() );
                 return this->collectIfDone_impl();
             }
             template<class T1>
             SendStatus collect_impl( T1& a1 ) {
                 if (!checkCaller()) return CollectFailure;
-                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)) );
+                this->caller->waitForMessages( isExecuted() );
                 return this->collectIfDone_impl(a1);
             }
 
             template<class T1, class T2>
             SendStatus collect_impl( T1& a1, T2& a2 ) {
                 if (!checkCaller()) return CollectFailure;
-                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)) );
+                this->caller->waitForMessages( isExecuted() );
                 return this->collectIfDone_impl(a1,a2);
             }
 
             template<class T1, class T2, class T3>
             SendStatus collect_impl( T1& a1, T2& a2, T3& a3 ) {
                 if (!checkCaller()) return CollectFailure;
-                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)) );
+                this->caller->waitForMessages( isExecuted() );
                 return this->collectIfDone_impl(a1,a2,a3);
             }
 
 	    template<class T1, class T2, class T3, class T4>
             SendStatus collect_impl( T1& a1, T2& a2, T3& a3, T4& a4) {
                 if (!checkCaller()) return CollectFailure;
-                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)) );
+                this->caller->waitForMessages( isExecuted() );
                 return this->collectIfDone_impl(a1,a2,a3,a4);
             }
 
 	    template<class T1, class T2, class T3, class T4, class T5>
 	    SendStatus collect_impl( T1& a1, T2& a2, T3& a3, T4& a4, T5& a5) {
                 if (!checkCaller()) return CollectFailure;
-                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)) );
+                this->caller->waitForMessages( isExecuted() );
                 return this->collectIfDone_impl(a1,a2,a3,a4, a5);
             }
 
 	    template<class T1, class T2, class T3, class T4, class T5, class T6>
 	    SendStatus collect_impl( T1& a1, T2& a2, T3& a3, T4& a4, T5& a5, T6& a6) {
                 if (!checkCaller()) return CollectFailure;
-                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)) );
+                this->caller->waitForMessages( isExecuted() );
                 return this->collectIfDone_impl(a1,a2,a3,a4,a5,a6);
             }
 
 	    template<class T1, class T2, class T3, class T4, class T5, class T6, class T7>
 	    SendStatus collect_impl( T1& a1, T2& a2, T3& a3, T4& a4, T5& a5, T6& a6, T7& a7) {
                 if (!checkCaller()) return CollectFailure;
-                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)) );
+                this->caller->waitForMessages( isExecuted() );
                 return this->collectIfDone_impl(a1,a2,a3,a4,a5,a6,a7);
             }
 
@@ -624,6 +868,51 @@ namespace RTT
              * were allocated with the rt_allocator class.
              */
             typename base::OperationCallerBase<FunctionT>::shared_ptr self;
+
+            /**
+             * The call records filled in by setCaller(). A copy of this
+             * object starts without records, such that a record is never
+             * shared with a clone.
+             */
+            struct SendPool {
+                std::vector<shared_ptr> records;
+                volatile int busy;
+                SendPool() : busy(0) {}
+                SendPool(const SendPool&) : busy(0) {}
+                SendPool& operator=(const SendPool&) { records.clear(); return *this; }
+            };
+            SendPool mpool;
+
+            enum { Pending, Callback, Returned };
+
+            /**
+             * The completion callback of a sent call. The state goes from
+             * Pending to Callback when setCompletion() comes first, or
+             * to Returned when the call returned to the caller first.
+             */
+            struct Completion {
+                boost::function<void(void)> done;
+                volatile int state;
+                Completion() : state(Pending) {}
+                Completion(const Completion&) : state(Pending) {}
+                Completion& operator=(const Completion&) { return *this; }
+            };
+            Completion mcompletion;
+
+            /**
+             * The predicate collect() waits for. Contrary to a bind
+             * expression, it fits in a boost::function without
+             * allocating memory.
+             */
+            struct IsExecuted {
+                const typename Store::RStoreType* retv;
+                bool operator()() const { return retv->isExecuted(); }
+            };
+
+            IsExecuted isExecuted() const {
+                IsExecuted pred = { &this->retv };
+                return pred;
+            }
         };
 
         /**
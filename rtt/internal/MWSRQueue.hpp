@@ -50,7 +50,7 @@
 #if defined(OROBLD_OS_NO_ASM)
 #include "LockedQueue.hpp"
 #else
-#include "AtomicMWSRQueue.hpp"
+#include "AtomicMPMCQueue.hpp"
 #endif
 
 namespace RTT
@@ -67,7 +67,7 @@ namespace RTT
 #if defined(OROBLD_OS_NO_ASM)
                 : public LockedQueue<T>
 #else
-                : public AtomicMWSRQueue<T>
+                : public AtomicMPMCQueue<T>
 #endif
         {
         public:
@@ -78,7 +78,7 @@ namespace RTT
 #if defined(OROBLD_OS_NO_ASM)
             : LockedQueue<T>(qsize)
 #else
-            : AtomicMWSRQueue<T> (qsize)
+            : AtomicMPMCQueue<T> (qsize)
 #endif
             {
             }
@@ -86,6 +86,22 @@ namespace RTT
             static std::vector<ArgumentDescription> getArgumentList(base::OperationBase* ob, const int arity, std::vector<std::string> const& types);
         };
 
+        /**
+         * Installs \a done as completion callback of the SendHandle
+         * held by \a handle.
+         * @return false if \a handle holds no SendHandle<Signature>
+         * or if the SendHandle refused the callback.
+         */
+        template<typename Signature>
+        bool setSendHandleCompletion(base::DataSourceBase::shared_ptr handle, boost::function<void(void)> const& done)
+        {
+            typename DataSource<SendHandle<Signature> >::shared_ptr h = boost::dynamic_pointer_cast< DataSource<SendHandle<Signature> > >(handle);
+            if ( !h )
+                return false;
+            SendHandle<Signature> sh = h->value();
+            return sh.onCompletion(done);
+        }
+
         /**
          * OperationInterfacePart implementation that uses boost::fusion
          * to produce items.
@@ -171,6 +187,10 @@ namespace RTT
                 return new FusedMCollectDataSource<Signature>( create_sequence<typename FusedMCollectDataSource<Signature>::handle_and_arg_types >::assignable(args.begin()), blocking );
             }
 
+            virtual bool setCompletion(base::DataSourceBase::shared_ptr handle, boost::function<void(void)> const& done) const {
+                return setSendHandleCompletion<Signature>(handle, done);
+            }
+
 #ifdef ORO_SIGNALLING_OPERATIONS
             virtual Handle produceSignal( base::ActionInterface* func, const std::vector<base::DataSourceBase::shared_ptr>& args, ExecutionEngine* subscriber) const
             {
@@ -422,6 +442,10 @@ namespace RTT
                     // we need to ask FusedMCollectDataSource what the arg types are, based on the collect signature.
                     return new FusedMCollectDataSource<Signature>( create_sequence<typename FusedMCollectDataSource<Signature>::handle_and_arg_types >::assignable(args.begin()), blocking );
                 }
+
+                virtual bool setCompletion(base::DataSourceBase::shared_ptr handle, boost::function<void(void)> const& done) const {
+                    return setSendHandleCompletion<Signature>(handle, done);
+                }
 #ifdef ORO_SIGNALLING_OPERATIONS
                 virtual Handle produceSignal( base::ActionInterface* func, const std::vector<base::DataSourceBase::shared_ptr>& args, ExecutionEngine* subscriber) const {
                     if ( args.size() != arity() ) throw wrong_number_of_args_exception(arity(), args.size() );
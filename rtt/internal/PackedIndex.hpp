@@ -0,0 +1,66 @@
+/***************************************************************************
+  tag: PackedIndex.hpp
+
+                        PackedIndex.hpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_PACKED_INDEX_HPP
+#define ORO_PACKED_INDEX_HPP
+
+namespace RTT
+{ namespace internal {
+
+    /**
+     * Selects the integer type in which two indexes of
+     * type \a Index are packed, such that both can be
+     * modified with one CAS. Used by TsPool for its
+     * index and ABA tag.
+     */
+    template<typename Index>
+    struct PackedIndex;
+
+    template<>
+    struct PackedIndex<unsigned short>
+    {
+        typedef unsigned int type;
+    };
+
+    template<>
+    struct PackedIndex<unsigned int>
+    {
+        typedef unsigned long long type;
+    };
+}}
+
+#endif
@@ -49,7 +49,7 @@
 #if defined(OROBLD_OS_NO_ASM)
 #include "LockedQueue.hpp"
 #else
-#include "AtomicQueue.hpp"
+#include "AtomicMPMCQueue.hpp"
 #endif
 
 namespace RTT
@@ -66,7 +66,7 @@ namespace RTT
 #if defined(OROBLD_OS_NO_ASM)
                 : public LockedQueue<T>
 #else
-                : public AtomicQueue<T>
+                : public AtomicMPMCQueue<T>
 #endif
         {
         public:
@@ -77,7 +77,7 @@ namespace RTT
 #if defined(OROBLD_OS_NO_ASM)
             : LockedQueue<T>(qsize)
 #else
-            : AtomicQueue<T> (qsize)
+            : AtomicMPMCQueue<T> (qsize)
 #endif
             {
             }
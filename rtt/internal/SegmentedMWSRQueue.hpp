@@ -0,0 +1,363 @@
+/***************************************************************************
+  tag: SegmentedMWSRQueue.hpp
+
+                        SegmentedMWSRQueue.hpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_SEGMENTED_MWSR_QUEUE_HPP
+#define ORO_SEGMENTED_MWSR_QUEUE_HPP
+
+#include "MWSRQueue.hpp"
+#include "../os/Atomic.hpp"
+#include "../os/CAS.hpp"
+#include "../os/Mutex.hpp"
+#include "../os/MutexLock.hpp"
+#include "../Logger.hpp"
+
+namespace RTT
+{
+    namespace internal
+    {
+
+        /**
+         * A Multi-Writer, Single-Reader queue of pointers which consists
+         * of a chain of fixed size MWSRQueue segments. Writers always
+         * enqueue in the most recently added segment, the reader drains
+         * the segments in the order they were added.
+         *
+         * When the queue is growable and the last segment is full, a writer
+         * adds a new segment of twice the size. Adding a segment is the only
+         * non real-time operation and only happens on overflow or resize().
+         *
+         * The segments are kept in a ring of MaxSegments slots. Writers count
+         * themselves in the slot of the segment they enqueue in. The reader
+         * retires the oldest segment once a newer one was added, it is drained
+         * and no writer uses it anymore. Its slot is then reused by a later
+         * segment, which recycles the retired segment if it has the requested
+         * capacity. As such, MaxSegments limits the number of segments which
+         * hold items at the same time, not the number of resizes.
+         *
+         * The FIFO order is kept for each writer thread, since a writer never
+         * returns to an older segment.
+         *
+         * @param T The pointer type to be stored in the queue.
+         * @warning You can not store null pointers.
+         * @ingroup CoreLibBuffers
+         */
+        template<class T>
+        class SegmentedMWSRQueue
+        {
+        public:
+            typedef unsigned int size_type;
+
+            enum {
+                /** The maximum number of segments which are in use at the same time. */
+                MaxSegments = 8,
+                /** The largest segment, which is the largest AtomicMPMCQueue. */
+                MaxSegmentSize = AtomicMPMCQueue<T>::MaxSize
+            };
+
+        private:
+            typedef MWSRQueue<T> Segment;
+
+            /**
+             * A segment and the number of writers which are using it.
+             */
+            struct Slot
+            {
+                Segment* volatile seg;
+                os::AtomicInt users;
+            };
+
+            Slot _slots[MaxSegments];
+            /**
+             * The number of the oldest segment in use. Only the reader changes it.
+             */
+            volatile int _first;
+            /**
+             * The number of the segment writers enqueue in.
+             */
+            volatile int _last;
+            /**
+             * The number of items in all segments. It is incremented before
+             * an enqueue, such that it never underestimates the contents.
+             */
+            os::AtomicInt _count;
+            volatile size_type _capacity;
+            bool _growable;
+            /**
+             * Serialises adding segments.
+             */
+            os::Mutex _lock;
+
+            // non-copyable !
+            SegmentedMWSRQueue(const SegmentedMWSRQueue<T>&);
+
+            /**
+             * Returns the segment size to use for a requested \a size,
+             * and logs a warning if \a size is too large.
+             */
+            static size_type clip(size_type size) {
+                if (size == 0)
+                    return 1;
+                if (size > size_type(MaxSegmentSize)) {
+                    RTT::log(Warning) << "SegmentedMWSRQueue: a segment holds at most " << size_type(MaxSegmentSize)
+                                      << " elements, using that instead of " << size << "." << RTT::endlog();
+                    return size_type(MaxSegmentSize);
+                }
+                return size;
+            }
+
+            Slot& slot(int n) { return _slots[n % MaxSegments]; }
+            const Slot& slot(int n) const { return _slots[n % MaxSegments]; }
+
+            /**
+             * Counts the caller in as a writer of segment \a last, which is
+             * the segment writers use now. The segment can not be retired
+             * before leave() is called.
+             */
+            Segment* enter(int& last) {
+                while (true) {
+                    last = _last;
+                    Slot& s = slot(last);
+                    s.users.inc();
+                    // the reader only retires segments older than _last.
+                    if ( _last == last )
+                        return s.seg;
+                    s.users.dec();
+                }
+            }
+
+            void leave(int last) {
+                slot(last).users.dec();
+            }
+
+            /**
+             * Adds a segment of \a size elements after the last one.
+             * @pre _lock is held.
+             * @return false if all slots are in use.
+             */
+            bool append(size_type size) {
+                int n = _last + 1;
+                if ( n - _first >= MaxSegments )
+                    return false;
+                // the slot holds null or segment n - MaxSegments, which was retired.
+                Slot& s = slot(n);
+                if ( s.seg == 0 || s.seg->capacity() != size ) {
+                    delete s.seg;
+                    s.seg = new Segment( size );
+                }
+                _capacity = size;
+                // a locked instruction publishes the segment before _last.
+                os::CAS(&_last, n - 1, n);
+                return true;
+            }
+
+            /**
+             * Adds a segment of \a size elements after segment \a last,
+             * unless another thread did so already.
+             * @return false if all slots are in use.
+             */
+            bool grow(int last, size_type size) {
+                os::MutexLock lock(_lock);
+                if ( _last != last )
+                    return true;
+                return append(size);
+            }
+        public:
+            /**
+             * Create a queue with an initial capacity of \a size.
+             * @param size The capacity of the first segment.
+             * @param growable Set to true to allocate a new segment when
+             * the queue overflows, instead of rejecting the item.
+             */
+            SegmentedMWSRQueue(size_type size, bool growable = false)
+                : _first(0), _last(0), _count(0), _capacity( clip(size) ), _growable(growable)
+            {
+                for (int i = 0; i != MaxSegments; ++i)
+                    _slots[i].seg = 0;
+                _slots[0].seg = new Segment( _capacity );
+            }
+
+            ~SegmentedMWSRQueue()
+            {
+                for (int i = 0; i != MaxSegments; ++i)
+                    delete _slots[i].seg;
+            }
+
+            /**
+             * Allow or disallow growing the queue on overflow.
+             */
+            void setGrowable(bool growable) { _growable = growable; }
+
+            /**
+             * Returns true if this queue grows on overflow.
+             */
+            bool isGrowable() const { return _growable; }
+
+            /**
+             * Returns true if resize() can add a segment now. This remains
+             * true until another thread resizes or grows the queue.
+             */
+            bool canResize() const
+            {
+                return _last + 1 - _first < MaxSegments;
+            }
+
+            /**
+             * Makes all subsequent enqueues go to a new segment of \a size
+             * elements. Items in the older segments remain in the queue.
+             * This function may be called while other threads use the queue.
+             * @return The capacity writers use after this call, which differs
+             * from \a size if \a size was clipped or a writer grew the queue
+             * in the meantime, or 0 if all segments are in use.
+             */
+            size_type resize(size_type size)
+            {
+                {
+                    os::MutexLock lock(_lock);
+                    if ( !append( clip(size) ) )
+                        return 0;
+                }
+                return capacity();
+            }
+
+            /**
+             * Returns the number of segments in use.
+             */
+            int segments() const { return _last - _first + 1; }
+
+            /**
+             * Returns the capacity of the segment writers currently use.
+             */
+            size_type capacity() const
+            {
+                return _capacity;
+            }
+
+            /**
+             * Returns the number of elements in all segments.
+             */
+            size_type size() const
+            {
+                int count = _count.read();
+                return count < 0 ? 0 : size_type(count);
+            }
+
+            /**
+             * Inspect if the queue is empty.
+             */
+            bool isEmpty() const
+            {
+                return _count.read() <= 0;
+            }
+
+            /**
+             * Inspect if the queue is full, this is, if the next
+             * enqueue would be rejected.
+             */
+            bool isFull()
+            {
+                int last;
+                bool full = enter(last)->isFull();
+                leave(last);
+                return full && (!_growable || !canResize());
+            }
+
+            /**
+             * Enqueue an item.
+             * @param value The value to enqueue, may not be null.
+             * @return false if queue is full and can not grow, true if queued.
+             */
+            bool enqueue(const T& value)
+            {
+                if ( value == 0 )
+                    return false;
+                _count.inc();
+                while (true) {
+                    int last;
+                    Segment* seg = enter(last);
+                    bool queued = seg->enqueue( value );
+                    size_type cap = seg->capacity();
+                    leave(last);
+                    if ( queued )
+                        return true;
+                    // growing stops at the largest segment, without logging from the writer.
+                    size_type next = cap > size_type(MaxSegmentSize) / 2 ? size_type(MaxSegmentSize) : cap * 2;
+                    if ( !_growable || !grow(last, next) ) {
+                        _count.dec();
+                        return false;
+                    }
+                }
+            }
+
+            /**
+             * Dequeue an item. Only one thread may call this function.
+             * @param result Stores the dequeued value.
+             * @return false if queue is empty, true if result was written.
+             */
+            bool dequeue(T& result)
+            {
+                int last = _last;
+                for (int i = _first; i <= last; ++i) {
+                    Slot& s = slot(i);
+                    if ( s.seg->dequeue( result ) ) {
+                        _count.dec();
+                        return true;
+                    }
+                    // A writer which enters segment i from now on sees that _last moved
+                    // and leaves it again, so once it has no users and is empty,
+                    // it stays empty.
+                    if ( i == _first && i < last && s.users.read() == 0 && s.seg->isEmpty() )
+                        os::CAS(&_first, i, i + 1);
+                }
+                return false;
+            }
+
+            /**
+             * Clear all contents of the queue. Only call this function
+             * when no other thread accesses the queue.
+             */
+            void clear()
+            {
+                for (int i = _first; i <= _last; ++i)
+                    slot(i).seg->clear();
+                _first = _last;
+                _count.set(0);
+            }
+        };
+    }
+}
+
+#endif
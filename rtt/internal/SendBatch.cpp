@@ -0,0 +1,77 @@
+/***************************************************************************
+  tag: SendBatch.cpp
+
+                        SendBatch.cpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "SendBatch.hpp"
+
+namespace RTT
+{ namespace internal {
+
+    void SendBatch::reserve(unsigned int n)
+    {
+        mcalls.reserve(n);
+    }
+
+    void SendBatch::add(base::DisposableInterface* call)
+    {
+        mcalls.push_back(call);
+    }
+
+    unsigned int SendBatch::size() const
+    {
+        return mcalls.size();
+    }
+
+    void SendBatch::executeAndDispose()
+    {
+        for (std::vector<base::DisposableInterface*>::iterator it = mcalls.begin(); it != mcalls.end(); ++it)
+            (*it)->executeAndDispose();
+        mcalls.clear();
+        // may delete this.
+        shared_ptr keep;
+        keep.swap(self);
+    }
+
+    void SendBatch::dispose()
+    {
+        for (std::vector<base::DisposableInterface*>::iterator it = mcalls.begin(); it != mcalls.end(); ++it)
+            (*it)->dispose();
+        mcalls.clear();
+        shared_ptr keep;
+        keep.swap(self);
+    }
+}}
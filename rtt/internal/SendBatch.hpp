@@ -0,0 +1,98 @@
+/***************************************************************************
+  tag: SendBatch.hpp
+
+                        SendBatch.hpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef ORO_SEND_BATCH_HPP
+#define ORO_SEND_BATCH_HPP
+
+#include "../base/DisposableInterface.hpp"
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace RTT
+{ namespace internal {
+
+    /**
+     * A message that carries a number of operation calls to an
+     * ExecutionEngine, which executes them in order in one pass
+     * of its message processing.
+     *
+     * The batch keeps itself alive with \a self until it
+     * is executed or disposed.
+     */
+    class RTT_API SendBatch
+        : public base::DisposableInterface
+    {
+    public:
+        typedef boost::shared_ptr<SendBatch> shared_ptr;
+
+        /**
+         * Reserves place for \a n calls.
+         */
+        void reserve(unsigned int n);
+
+        /**
+         * Adds a call to this batch. The batch executes or disposes
+         * it, but does not own it.
+         */
+        void add(base::DisposableInterface* call);
+
+        /**
+         * Returns the number of calls in this batch.
+         */
+        unsigned int size() const;
+
+        /**
+         * Executes all calls, in the order they were added.
+         */
+        void executeAndDispose();
+
+        /**
+         * Disposes all calls without executing them.
+         */
+        void dispose();
+
+        /**
+         * Refers to this batch while it is in a message queue.
+         */
+        shared_ptr self;
+    private:
+        std::vector<base::DisposableInterface*> mcalls;
+    };
+}}
+
+#endif
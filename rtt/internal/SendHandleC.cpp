@@ -51,7 +51,7 @@ namespace RTT {
     class SendHandleC::E
     {
     public:
-        E(base::DataSourceBase::shared_ptr op) : s(), b(), mop(op), orp(0) {}
+        E(base::DataSourceBase::shared_ptr op) : s(), b(), mop(op), msh(), orp(0) {}
 
         ~E() {
             // force synchronisation in case we are the last SendHandleC. We may not cleanup mop (holds data!), until the op
@@ -73,6 +73,10 @@ namespace RTT {
          * Stores the operation in order to avoid its premature destruction.
          */
         base::DataSourceBase::shared_ptr mop;
+        /**
+         * Stores the SendHandle data source, for installing completion callbacks.
+         */
+        base::DataSourceBase::shared_ptr msh;
 
     /**
      * This is a custom deleter that blocks on an asynchronous
@@ -173,6 +177,7 @@ namespace RTT {
             d = 0;
         }
         this->e->orp = ofp;
+        this->e->msh = sh;
     }
 
     SendHandleC::SendHandleC(const SendHandleC& other)
@@ -190,6 +195,7 @@ namespace RTT {
         e->b = other.e->b;
         e->mop = other.e->mop;
         e->mopkeeper = other.e->mopkeeper;
+        e->msh = other.e->msh;
         e->orp = other.e->orp;
         return *this;
     }
@@ -256,6 +262,12 @@ namespace RTT {
         return SendFailure;
     }
 
+    bool SendHandleC::onCompletion(boost::function<void(void)> const& done) {
+        if ( !e->orp || !e->msh )
+            return false;
+        return e->orp->setCompletion( e->msh, done );
+    }
+
     bool SendHandleC::ready() const
     {
         return e->s != 0;
@@ -41,6 +41,7 @@
 
 #include <string>
 #include <boost/make_shared.hpp>
+#include <boost/function.hpp>
 #include "DataSources.hpp"
 #include "../Attribute.hpp"
 #include "../rtt-fwd.hpp"
@@ -127,6 +128,15 @@ namespace RTT
          */
         SendStatus collectIfDone();
 
+        /**
+         * Run \a done in the caller's ExecutionEngine once the
+         * sent operation completed.
+         * @return false if this handle was not sent or if the operation
+         * does not support completion callbacks.
+         * @see SendHandle::onCompletion
+         */
+        bool onCompletion(boost::function<void(void)> const& done);
+
         /**
          * Checks if this handle is ready for collecting, will throw
          * if not so. Otherwise, does nothing.
@@ -0,0 +1,290 @@
+/***************************************************************************
+  tag: SharedSample.hpp
+
+                        SharedSample.hpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_SHARED_SAMPLE_HPP
+#define ORO_SHARED_SAMPLE_HPP
+
+#include "TsPool.hpp"
+#include "../os/Atomic.hpp"
+#include <algorithm>
+
+namespace RTT
+{ namespace internal {
+
+    template<class T>
+    class SamplePool;
+
+    /**
+     * The storage of a SharedSample: the value and its reference count.
+     * A node belongs to a SamplePool or, if pool is null, was
+     * allocated on the heap.
+     */
+    template<class T>
+    struct SharedSampleNode
+    {
+        T value;
+        os::AtomicInt refcount;
+        SamplePool<T>* pool;
+
+        SharedSampleNode() : value(), refcount(0), pool(0) {}
+        explicit SharedSampleNode(const T& v) : value(v), refcount(0), pool(0) {}
+        // Only the value is copied, a node is never copied while in use.
+        SharedSampleNode(const SharedSampleNode& orig) : value(orig.value), refcount(0), pool(0) {}
+        SharedSampleNode& operator=(const SharedSampleNode& orig) { value = orig.value; return *this; }
+    };
+
+    /**
+     * A fixed size, lock-free pool of samples for OutputPort::loan().
+     * The pool is reference counted by its owner and by every sample
+     * that was allocated from it, such that it outlives the samples
+     * which are still held by connections or readers.
+     * @ingroup Ports
+     */
+    template<class T>
+    class SamplePool
+    {
+        typedef SharedSampleNode<T> Node;
+#ifdef ORO_HAVE_CAS64
+        TsPool<Node, unsigned int> mpool;
+#else
+        TsPool<Node> mpool;
+#endif
+        os::AtomicInt mrefs;
+
+        ~SamplePool() {}
+    public:
+        /**
+         * Creates a pool of \a size samples, which are all initialized
+         * with \a sample. The caller owns one reference, which it
+         * must give up with release().
+         * @note Not real-time.
+         */
+        SamplePool(unsigned int size, const T& sample = T())
+            : mpool(size, Node(sample)), mrefs(1) {}
+
+        /**
+         * Returns a node with a reference count of one, or null
+         * if all samples are in use.
+         * @note Real-time and lock-free.
+         */
+        Node* allocate() {
+            Node* n = mpool.allocate();
+            if (n) {
+                mrefs.inc();
+                n->refcount.set(1);
+                n->pool = this;
+            }
+            return n;
+        }
+
+        /**
+         * Returns a node to this pool.
+         */
+        void deallocate(Node* n) {
+            mpool.deallocate(n);
+            release();
+        }
+
+        /**
+         * Gives up one reference to this pool.
+         */
+        void release() {
+            if ( mrefs.dec_and_test() )
+                delete this;
+        }
+
+        unsigned int capacity() { return mpool.capacity(); }
+    };
+
+    /**
+     * A reference counted, read-only handle to a sample which is
+     * shared between an OutputPort, its connections and its InputPorts.
+     * Copying a SharedSample does not copy the sample and does not allocate.
+     * When the last handle is destroyed, the sample returns to its pool.
+     * @see OutputPort::loan(), InputPort::readShared()
+     * @ingroup Ports
+     */
+    template<class T>
+    class SharedSample
+    {
+    protected:
+        typedef SharedSampleNode<T> Node;
+        Node* mnode;
+    public:
+        /**
+         * Creates an empty handle.
+         */
+        SharedSample() : mnode(0) {}
+
+        /**
+         * Takes over the reference of node \a n.
+         */
+        explicit SharedSample(Node* n) : mnode(n) {}
+
+        SharedSample(const SharedSample& orig) : mnode(orig.mnode) {
+            if (mnode)
+                mnode->refcount.inc();
+        }
+
+        ~SharedSample() { reset(); }
+
+        SharedSample& operator=(const SharedSample& orig) {
+            SharedSample tmp(orig);
+            swap(tmp);
+            return *this;
+        }
+
+        void swap(SharedSample& other) { std::swap(mnode, other.mnode); }
+
+        /**
+         * Releases the sample, this handle becomes empty.
+         */
+        void reset() {
+            Node* n = mnode;
+            mnode = 0;
+            if ( n && n->refcount.dec_and_test() ) {
+                if (n->pool)
+                    n->pool->deallocate(n);
+                else
+                    delete n;
+            }
+        }
+
+        /**
+         * Returns true if this handle refers to a sample.
+         */
+        bool valid() const { return mnode != 0; }
+
+        /**
+         * Returns the number of handles to this sample.
+         */
+        int use_count() const { return mnode ? mnode->refcount.read() : 0; }
+
+        const T& operator*() const { return mnode->value; }
+        const T* operator->() const { return &mnode->value; }
+        const T* get() const { return mnode ? &mnode->value : 0; }
+
+        bool operator==(const SharedSample& other) const { return mnode == other.mnode; }
+        bool operator!=(const SharedSample& other) const { return mnode != other.mnode; }
+    };
+
+    /**
+     * A writable sample, obtained with OutputPort::loan() and handed
+     * over to the connections with OutputPort::publish().
+     *
+     * Only one LoanedSample refers to a writable sample. Like std::auto_ptr,
+     * copying or assigning a LoanedSample moves the sample to the
+     * destination and leaves the source empty, such that no writable
+     * alias remains once the sample is published.
+     * @ingroup Ports
+     */
+    template<class T>
+    class LoanedSample : public SharedSample<T>
+    {
+        typedef typename SharedSample<T>::Node Node;
+
+        /**
+         * Carries the sample out of a temporary LoanedSample.
+         */
+        struct Ref
+        {
+            Node* node;
+            explicit Ref(Node* n) : node(n) {}
+        };
+
+        Node* take() {
+            Node* n = this->mnode;
+            this->mnode = 0;
+            return n;
+        }
+    public:
+        LoanedSample() {}
+
+        explicit LoanedSample(Node* n) : SharedSample<T>(n) {}
+
+        /**
+         * Moves the sample of \a orig to this handle, \a orig becomes empty.
+         */
+        LoanedSample(LoanedSample& orig) : SharedSample<T>( orig.take() ) {}
+
+        LoanedSample(Ref r) : SharedSample<T>( r.node ) {}
+
+        /**
+         * Releases the sample of this handle and moves the sample of
+         * \a orig to it, \a orig becomes empty.
+         */
+        LoanedSample& operator=(LoanedSample& orig) {
+            if ( &orig != this ) {
+                this->reset();
+                this->mnode = orig.take();
+            }
+            return *this;
+        }
+
+        LoanedSample& operator=(Ref r) {
+            this->reset();
+            this->mnode = r.node;
+            return *this;
+        }
+
+        operator Ref() { return Ref( take() ); }
+
+        /**
+         * Creates a sample on the heap, which holds a copy of \a value.
+         * @note Not real-time.
+         */
+        static LoanedSample create(const T& value) {
+            Node* n = new Node(value);
+            n->refcount.set(1);
+            return LoanedSample(n);
+        }
+
+        /**
+         * Gives up write access to the sample.
+         * @return A read-only handle to the sample. This handle becomes empty.
+         */
+        SharedSample<T> share() {
+            return SharedSample<T>( take() );
+        }
+
+        T& operator*() const { return this->mnode->value; }
+        T* operator->() const { return &this->mnode->value; }
+        T* get() const { return this->mnode ? &this->mnode->value : 0; }
+    };
+}}
+
+#endif
@@ -37,9 +37,8 @@
 
 
 #include "SignalBase.hpp"
-#include <boost/bind.hpp>
 
-#ifdef ORO_SIGNAL_USE_LIST_LOCK_FREE
+#ifdef ORO_SIGNAL_USE_SLOT_ARRAY
 #else
 #include "../os/MutexLock.hpp"
 #endif
@@ -87,8 +86,9 @@ namespace RTT {
 
         void SignalBase::conn_setup( connection_t conn ) {
             // allocate empty slot in list.
-#ifdef ORO_SIGNAL_USE_LIST_LOCK_FREE
-            mconnections.grow(1);
+#ifdef ORO_SIGNAL_USE_SLOT_ARRAY
+            // conn_connect() grows the slots if none is free.
+            this->reclaim();
 #else
 #ifdef ORO_SIGNAL_USE_RT_LIST
             mconnections.rt_grow(1);
@@ -103,8 +103,27 @@ namespace RTT {
         void SignalBase::conn_connect( connection_t conn ) {
             assert( conn.get() && "virtually impossible ! only connection base should call this function !" );
 
-#ifdef ORO_SIGNAL_USE_LIST_LOCK_FREE
-            mconnections.append( conn );
+#ifdef ORO_SIGNAL_USE_SLOT_ARRAY
+            ConnectionBase* c = conn.get();
+            intrusive_ptr_add_ref( c ); // released by reclaim().
+            Segment* seg = &mslots;
+            unsigned int capacity = 0;
+            while (true) {
+                for (unsigned int i = 0; i != seg->size; ++i) {
+                    Slot& slot = seg->slots[i];
+                    if ( slot.conn == 0 && slot.retired == 0 && os::CAS( &slot.conn, (ConnectionBase*)0, c) ) {
+                        // the previous connection may have been retired
+                        // between our check and the CAS.
+                        if ( slot.retired == 0 )
+                            return;
+                        slot.conn = 0;
+                    }
+                }
+                capacity += seg->size;
+                if ( seg->next == 0 )
+                    this->grow( seg, capacity );
+                seg = seg->next;
+            }
 #else
             // derived class must make sure that list contained enough list items !
             //assert( itend != mconnections.end() );
@@ -130,9 +149,8 @@ namespace RTT {
         void SignalBase::conn_destroy( connection_t conn ) {
             this->conn_disconnect(conn);
             // increase number of connections destroyed.
-#ifdef ORO_SIGNAL_USE_LIST_LOCK_FREE
-            // free memory
-            mconnections.shrink(1);
+#ifdef ORO_SIGNAL_USE_SLOT_ARRAY
+            this->reclaim();
 #else
 #ifdef ORO_SIGNAL_USE_RT_LIST
             // free memory
@@ -146,8 +164,19 @@ namespace RTT {
         void SignalBase::conn_disconnect( connection_t conn ) {
             assert( conn.get() && "virtually impossible ! only connection base should call this function !" );
 
-#ifdef ORO_SIGNAL_USE_LIST_LOCK_FREE
-            mconnections.erase( conn );
+#ifdef ORO_SIGNAL_USE_SLOT_ARRAY
+            // retire conn before its slot is cleared, such that the slot
+            // is not reused before reclaim() released conn.
+            ConnectionBase* c = conn.get();
+            for (Segment* seg = &mslots; seg; seg = seg->next)
+                for (unsigned int i = 0; i != seg->size; ++i) {
+                    Slot& slot = seg->slots[i];
+                    if ( slot.conn == c ) {
+                        os::CAS( &slot.retired, (ConnectionBase*)0, c);
+                        os::CAS( &slot.conn, c, (ConnectionBase*)0);
+                        return;
+                    }
+                }
 #else
             iterator tgt;
             // avoid invalidating iterator of emit() upon self or cross removal of conn.
@@ -170,8 +199,38 @@ namespace RTT {
 #endif
         }
 
-#ifdef ORO_SIGNAL_USE_LIST_LOCK_FREE
-            // NOP
+#ifdef ORO_SIGNAL_USE_SLOT_ARRAY
+        void SignalBase::grow( Segment* last, unsigned int n ) {
+            Segment* seg = new Segment(n);
+            while ( !os::CAS( &last->next, (Segment*)0, seg) )
+                last = last->next;
+        }
+
+        void SignalBase::reclaim() {
+            if ( !os::CAS( &mreclaiming, 0, 1) )
+                return;
+            // walks which start from now on count in the other epoch,
+            // such that the current one drains.
+            mepoch = mepoch + 1;
+            for (Segment* seg = &mslots; seg; seg = seg->next)
+                for (unsigned int i = 0; i != seg->size; ++i) {
+                    Slot& slot = seg->slots[i];
+                    ConnectionBase* c = slot.retired;
+                    // walks which start after c left its slot can not see c.
+                    if ( c == 0 || slot.conn == c )
+                        continue;
+                    if ( mwalks[0].read() == 0 )
+                        slot.quiet |= 1;
+                    if ( mwalks[1].read() == 0 )
+                        slot.quiet |= 2;
+                    if ( slot.quiet == 3 ) {
+                        slot.quiet = 0;
+                        os::CAS( &slot.retired, c, (ConnectionBase*)0);
+                        intrusive_ptr_release( c );
+                    }
+                }
+            mreclaiming = 0;
+        }
 #else
         void SignalBase::cleanup() {
             // this is called from within emit().
@@ -208,18 +267,19 @@ namespace RTT {
 #endif
 
         SignalBase::SignalBase() :
-#ifdef ORO_SIGNAL_USE_LIST_LOCK_FREE
-            mconnections(4) // this is a 'sane' starting point, this number will be grown if required.
+#ifdef ORO_SIGNAL_USE_SLOT_ARRAY
+            mslots(4), // this is a 'sane' starting point, this number will be grown if required.
+            mepoch(0), mreclaiming(0)
 #else
 #ifdef ORO_SIGNAL_USE_RT_LIST
             disconcount(0)
 #else
             concount(0)
-#endif
 #endif
             ,emitting(false)
+#endif
     {
-#ifdef ORO_SIGNAL_USE_LIST_LOCK_FREE
+#ifdef ORO_SIGNAL_USE_SLOT_ARRAY
         // NOP
 #else
         itend = mconnections.end();
@@ -229,17 +289,30 @@ namespace RTT {
         SignalBase::~SignalBase(){
             // call destroy on all connections.
             destroy();
-        }
-
-#ifdef ORO_SIGNAL_USE_LIST_LOCK_FREE
-        static void disconnectImpl( const ConnectionBase::shared_ptr& c ) {
-            c->disconnect();
-        }
+#ifdef ORO_SIGNAL_USE_SLOT_ARRAY
+            // no walk may run anymore, so all retired connections can go.
+            for (Segment* seg = &mslots; seg; seg = seg->next)
+                for (unsigned int i = 0; i != seg->size; ++i)
+                    if ( seg->slots[i].retired )
+                        intrusive_ptr_release( seg->slots[i].retired );
+            Segment* seg = mslots.next;
+            while ( seg ) {
+                Segment* next = seg->next;
+                delete seg;
+                seg = next;
+            }
 #endif
+        }
 
         void SignalBase::disconnect() {
-#ifdef ORO_SIGNAL_USE_LIST_LOCK_FREE
-            mconnections.apply( boost::bind(&disconnectImpl, _1 ) );
+#ifdef ORO_SIGNAL_USE_SLOT_ARRAY
+            Walk walk(this);
+            for (Segment* seg = &mslots; seg; seg = seg->next)
+                for (unsigned int i = 0; i != seg->size; ++i) {
+                    ConnectionBase* c = seg->slots[i].conn;
+                    if ( c )
+                        c->disconnect();
+                }
 #else
             // avoid invalidating iterator
             os::MutexLock lock(m);
@@ -249,24 +322,37 @@ namespace RTT {
         }
 
         void SignalBase::destroy() {
+#ifdef ORO_SIGNAL_USE_SLOT_ARRAY
+            for (Segment* seg = &mslots; seg; seg = seg->next)
+                for (unsigned int i = 0; i != seg->size; ++i) {
+                    // the slot's reference keeps c alive until it is reclaimed.
+                    ConnectionBase* c = seg->slots[i].conn;
+                    if ( c )
+                        c->destroy(); // this calls-back conn_disconnect.
+                }
+#else
             while ( !mconnections.empty() ) {
                 if ( mconnections.front() )
                     mconnections.front()->destroy(); // this calls-back conn_disconnect.
-#ifdef ORO_SIGNAL_USE_LIST_LOCK_FREE
-                // NOP
-#else
 #ifdef ORO_SIGNAL_USE_RT_LIST
                 // NOP
 #else
                 mconnections.erase( mconnections.begin() );
-#endif
 #endif
             }
+#endif
         }
 
         void SignalBase::reserve( size_t conns ) {
-#ifdef ORO_SIGNAL_USE_LIST_LOCK_FREE
-            mconnections.reserve( conns );
+#ifdef ORO_SIGNAL_USE_SLOT_ARRAY
+            Segment* seg = &mslots;
+            size_t capacity = seg->size;
+            while ( seg->next ) {
+                seg = seg->next;
+                capacity += seg->size;
+            }
+            if ( capacity < conns )
+                this->grow( seg, conns - capacity );
 #endif
         }
 
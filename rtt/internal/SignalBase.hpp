@@ -47,13 +47,12 @@
 #if defined(OROBLD_OS_NO_ASM)
 #define ORO_SIGNAL_USE_RT_LIST
 #else
-#define ORO_SIGNAL_USE_LIST_LOCK_FREE
+#define ORO_SIGNAL_USE_SLOT_ARRAY
 #endif
 
 #include "../os/Atomic.hpp"
-#ifdef ORO_SIGNAL_USE_LIST_LOCK_FREE
-#include "ListLockFree.hpp"
-#include <boost/shared_ptr.hpp>
+#ifdef ORO_SIGNAL_USE_SLOT_ARRAY
+#include "../os/CAS.hpp"
 #else
 #ifdef ORO_SIGNAL_USE_RT_LIST
 #include "../os/Mutex.hpp"
@@ -124,14 +123,20 @@ namespace RTT
          * It implements real-time management of connections, such that
          * connection/disconnetion of a handler is always thread-safe
          * and real-time.
+         *
+         * With ORO_SIGNAL_USE_SLOT_ARRAY, the connections are stored in
+         * an array of slots which only grows. Emitting walks the slots
+         * without locks or retries, also from several threads at once.
+         * A destroyed connection is released once every walk which may have
+         * seen it has finished, which is detected with two counters of
+         * running walks, one per epoch. Connecting is real-time as long as
+         * a slot is free, see reserve().
          */
         class RTT_API SignalBase
         {
         public:
             typedef ConnectionBase::shared_ptr        connection_t;
-#ifdef ORO_SIGNAL_USE_LIST_LOCK_FREE
-            typedef ListLockFree<connection_t> connections_list;
-#else
+#ifndef ORO_SIGNAL_USE_SLOT_ARRAY
 #ifdef ORO_SIGNAL_USE_RT_LIST
             typedef RTT::os::rt_list< connection_t >    connections_list;
 #else
@@ -151,10 +156,74 @@ namespace RTT
 
             void conn_destroy( connection_t conn );
         protected:
-            connections_list mconnections;
-#ifdef ORO_SIGNAL_USE_LIST_LOCK_FREE
-            // no mutexes involved
+#ifdef ORO_SIGNAL_USE_SLOT_ARRAY
+            /**
+             * Holds the connection emit() calls and a destroyed connection
+             * which is not released yet. A slot is only reused when both
+             * are empty.
+             */
+            struct Slot
+            {
+                ConnectionBase* volatile conn;
+                ConnectionBase* volatile retired;
+                /**
+                 * The epochs seen without walks since \a retired left
+                 * \a conn, one bit per epoch.
+                 */
+                int quiet;
+                Slot() : conn(0), retired(0), quiet(0) {}
+            };
+
+            /**
+             * A fixed size array of slots. Segments are only appended
+             * and deleted by ~SignalBase(), such that a walk never
+             * loses the slot it is reading.
+             */
+            struct Segment
+            {
+                Slot* slots;
+                unsigned int size;
+                Segment* volatile next;
+                Segment(unsigned int n) : slots( new Slot[n] ), size(n), next(0) {}
+                ~Segment() { delete[] slots; }
+            private:
+                Segment(const Segment&);
+                Segment& operator=(const Segment&);
+            };
+
+            /**
+             * Counts a walk over the slots in the epoch in which it
+             * started, for as long as it lives.
+             */
+            class Walk
+            {
+                SignalBase* msig;
+                int mepoch;
+            public:
+                Walk(SignalBase* sig) : msig(sig), mepoch(sig->mepoch & 1) { msig->mwalks[mepoch].inc(); }
+                ~Walk() { msig->mwalks[mepoch].dec(); }
+            };
+            friend class Walk;
+
+            /**
+             * Appends a segment of \a n slots after \a last or,
+             * if another thread appended one first, after that one.
+             */
+            void grow( Segment* last, unsigned int n );
+
+            /**
+             * Releases the destroyed connections which no walk can
+             * still be using. Only one thread at a time reclaims,
+             * a concurrent call returns immediately.
+             */
+            void reclaim();
+
+            Segment mslots;
+            volatile int mepoch;
+            os::AtomicInt mwalks[2];
+            volatile int mreclaiming;
 #else
+            connections_list mconnections;
             /**
              * Erase all empty list items after emit().
              */
@@ -166,9 +235,9 @@ namespace RTT
             int disconcount;
 #else
             int concount;
-#endif
 #endif
             bool emitting;
+#endif
             SignalBase();
         public:
             /**
@@ -197,8 +266,8 @@ namespace RTT
              * Use this method to efficiently reserve memory for
              * possible connections. If not used, the event will
              * reserve memory in batch, depending upon demand.
-             * This does not impair/influence real-time performance, only
-             * memory efficiency.
+             * With ORO_SIGNAL_USE_SLOT_ARRAY, setting up a connection
+             * only allocates the connection itself when a slot is free.
              * @param conns The number of connections to reserve memory for.
              */
             void reserve(size_t conns);
@@ -0,0 +1,137 @@
+/***************************************************************************
+  tag: StatsService.cpp
+
+                        StatsService.cpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "StatsService.hpp"
+#include "../TaskContext.hpp"
+#include "../Logger.hpp"
+
+namespace RTT
+{
+
+    namespace internal
+    {
+
+        StatsService::StatsService(TaskContext* owner)
+            : Service( "stats", owner )
+        {
+            this->doc("Execution time statistics of this TaskContext.");
+            addOperation("getCount", &StatsService::getCount, this, ClientThread)
+                    .doc("The number of times a timer was recorded.")
+                    .arg("timer","One of processMessages, processFunctions, prepareUpdateHook, updateHook or errorHook.");
+            addOperation("getMin", &StatsService::getMin, this, ClientThread)
+                    .doc("The shortest duration of a timer, in seconds.")
+                    .arg("timer","The name of the timer.");
+            addOperation("getMax", &StatsService::getMax, this, ClientThread)
+                    .doc("The longest duration of a timer, in seconds.")
+                    .arg("timer","The name of the timer.");
+            addOperation("getMean", &StatsService::getMean, this, ClientThread)
+                    .doc("The mean duration of a timer, in seconds.")
+                    .arg("timer","The name of the timer.");
+            addOperation("getPercentile", &StatsService::getPercentile, this, ClientThread)
+                    .doc("The duration below which a fraction of the durations of a timer are found, in seconds.")
+                    .arg("timer","The name of the timer.")
+                    .arg("p","The fraction, for example 0.99.");
+            addOperation("reset", &StatsService::reset, this, ClientThread)
+                    .doc("Clears all timers.");
+        }
+
+        StatsService::~StatsService()
+        {
+        }
+
+        os::TimingHistogram* StatsService::find(const std::string& timer)
+        {
+            TaskContext* tc = this->getOwner();
+            if ( !tc )
+                return 0;
+            if ( timer == "processMessages" )
+                return &tc->engine()->getMessagesTiming();
+            if ( timer == "processFunctions" )
+                return &tc->engine()->getFunctionsTiming();
+            if ( timer == "prepareUpdateHook" )
+                return &tc->getHookStatistics().prepareUpdateHook;
+            if ( timer == "updateHook" )
+                return &tc->getHookStatistics().updateHook;
+            if ( timer == "errorHook" )
+                return &tc->getHookStatistics().errorHook;
+            log(Error) << "No such timer in stats service: " << timer << endlog();
+            return 0;
+        }
+
+        unsigned int StatsService::getCount(const std::string& timer)
+        {
+            os::TimingHistogram* h = find(timer);
+            return h ? h->count() : 0;
+        }
+
+        Seconds StatsService::getMin(const std::string& timer)
+        {
+            os::TimingHistogram* h = find(timer);
+            return h ? nsecs_to_Seconds( h->minimum() ) : 0.0;
+        }
+
+        Seconds StatsService::getMax(const std::string& timer)
+        {
+            os::TimingHistogram* h = find(timer);
+            return h ? nsecs_to_Seconds( h->maximum() ) : 0.0;
+        }
+
+        Seconds StatsService::getMean(const std::string& timer)
+        {
+            os::TimingHistogram* h = find(timer);
+            return h ? h->mean() / NSECS_IN_SECS : 0.0;
+        }
+
+        Seconds StatsService::getPercentile(const std::string& timer, double p)
+        {
+            os::TimingHistogram* h = find(timer);
+            return h ? nsecs_to_Seconds( h->percentile(p) ) : 0.0;
+        }
+
+        void StatsService::reset()
+        {
+            TaskContext* tc = this->getOwner();
+            if ( !tc )
+                return;
+            tc->engine()->getMessagesTiming().reset();
+            tc->engine()->getFunctionsTiming().reset();
+            tc->getHookStatistics().prepareUpdateHook.reset();
+            tc->getHookStatistics().updateHook.reset();
+            tc->getHookStatistics().errorHook.reset();
+        }
+    }
+
+}
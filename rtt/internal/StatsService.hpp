@@ -0,0 +1,104 @@
+/***************************************************************************
+  tag: StatsService.hpp
+
+                        StatsService.hpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef ORO_STATSSERVICE_HPP_
+#define ORO_STATSSERVICE_HPP_
+
+#include "../Service.hpp"
+#include "../os/TimingHistogram.hpp"
+
+namespace RTT
+{
+
+    namespace internal
+    {
+
+        /**
+         * The 'stats' service of a TaskContext, which reports the execution
+         * times recorded by its ExecutionEngine. The timers are
+         * 'processMessages', 'processFunctions', 'prepareUpdateHook',
+         * 'updateHook' and 'errorHook'. All operations execute in the
+         * ClientThread and never block the component.
+         */
+        class StatsService: public RTT::Service
+        {
+        public:
+            StatsService(TaskContext* owner);
+            virtual ~StatsService();
+
+            /**
+             * The number of times \a timer was recorded.
+             */
+            unsigned int getCount(const std::string& timer);
+
+            /**
+             * The shortest duration of \a timer, in seconds.
+             */
+            Seconds getMin(const std::string& timer);
+
+            /**
+             * The longest duration of \a timer, in seconds.
+             */
+            Seconds getMax(const std::string& timer);
+
+            /**
+             * The mean duration of \a timer, in seconds.
+             */
+            Seconds getMean(const std::string& timer);
+
+            /**
+             * The duration below which a fraction \a p of the
+             * durations of \a timer are found, in seconds.
+             */
+            Seconds getPercentile(const std::string& timer, double p);
+
+            /**
+             * Clears all timers of the owner of this service.
+             */
+            void reset();
+
+        private:
+            /**
+             * Returns the histogram of \a timer or null if unknown.
+             */
+            os::TimingHistogram* find(const std::string& timer);
+        };
+
+    }
+
+}
+
+#endif /* ORO_STATSSERVICE_HPP_ */
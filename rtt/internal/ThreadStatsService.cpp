@@ -0,0 +1,160 @@
+/***************************************************************************
+  tag: ThreadStatsService.cpp
+
+                        ThreadStatsService.cpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "ThreadStatsService.hpp"
+#include "../os/Thread.hpp"
+#include "../Logger.hpp"
+
+#include <sstream>
+
+namespace RTT
+{
+
+    namespace internal
+    {
+
+        ThreadStatsService::ThreadStatsService()
+            : Service( "threads" )
+        {
+            this->doc("Wake-up latency, execution time and overrun statistics of the periodic threads.");
+            addOperation("getThreads", &ThreadStatsService::getThreads, this, ClientThread)
+                    .doc("The number and name of all threads, as 'number: name'.");
+            addOperation("getOverruns", &ThreadStatsService::getOverruns, this, ClientThread)
+                    .doc("The number of periods in which a thread did not finish its step in time.")
+                    .arg("thread","The number of the thread, as listed by getThreads.");
+            addOperation("getCount", &ThreadStatsService::getCount, this, ClientThread)
+                    .doc("The number of times a timer was recorded.")
+                    .arg("thread","The number of the thread, as listed by getThreads.")
+                    .arg("timer","One of wakeLatency or execution.");
+            addOperation("getMin", &ThreadStatsService::getMin, this, ClientThread)
+                    .doc("The shortest duration of a timer, in seconds.")
+                    .arg("thread","The number of the thread, as listed by getThreads.")
+                    .arg("timer","The name of the timer.");
+            addOperation("getMax", &ThreadStatsService::getMax, this, ClientThread)
+                    .doc("The longest duration of a timer, in seconds.")
+                    .arg("thread","The number of the thread, as listed by getThreads.")
+                    .arg("timer","The name of the timer.");
+            addOperation("getMean", &ThreadStatsService::getMean, this, ClientThread)
+                    .doc("The mean duration of a timer, in seconds.")
+                    .arg("thread","The number of the thread, as listed by getThreads.")
+                    .arg("timer","The name of the timer.");
+            addOperation("getPercentile", &ThreadStatsService::getPercentile, this, ClientThread)
+                    .doc("The duration below which a fraction of the durations of a timer are found, in seconds.")
+                    .arg("thread","The number of the thread, as listed by getThreads.")
+                    .arg("timer","The name of the timer.")
+                    .arg("p","The fraction, for example 0.99.");
+            addOperation("reset", &ThreadStatsService::reset, this, ClientThread)
+                    .doc("Clears all statistics of a thread.")
+                    .arg("thread","The number of the thread, as listed by getThreads.");
+        }
+
+        ThreadStatsService::~ThreadStatsService()
+        {
+        }
+
+        bool ThreadStatsService::find(unsigned int thread, const std::string& timer, os::TimingHistogram& h)
+        {
+            os::ThreadStatistics stats;
+            if ( !os::Thread::copyThreadStatistics(thread, stats) ) {
+                log(Error) << "No such thread in threads service: " << thread << endlog();
+                return false;
+            }
+            if ( timer == "wakeLatency" )
+                h = stats.wakeLatency;
+            else if ( timer == "execution" )
+                h = stats.execution;
+            else {
+                log(Error) << "No such timer in threads service: " << timer << endlog();
+                return false;
+            }
+            return true;
+        }
+
+        std::vector<std::string> ThreadStatsService::getThreads()
+        {
+            std::vector< std::pair<unsigned int, std::string> > threads = os::Thread::getThreads();
+            std::vector<std::string> result;
+            for (unsigned int i = 0; i != threads.size(); ++i) {
+                std::ostringstream label;
+                label << threads[i].first << ": " << threads[i].second;
+                result.push_back( label.str() );
+            }
+            return result;
+        }
+
+        unsigned int ThreadStatsService::getOverruns(unsigned int thread)
+        {
+            os::ThreadStatistics stats;
+            return os::Thread::copyThreadStatistics(thread, stats) ? stats.overruns() : 0;
+        }
+
+        unsigned int ThreadStatsService::getCount(unsigned int thread, const std::string& timer)
+        {
+            os::TimingHistogram h;
+            return find(thread, timer, h) ? h.count() : 0;
+        }
+
+        Seconds ThreadStatsService::getMin(unsigned int thread, const std::string& timer)
+        {
+            os::TimingHistogram h;
+            return find(thread, timer, h) ? nsecs_to_Seconds( h.minimum() ) : 0.0;
+        }
+
+        Seconds ThreadStatsService::getMax(unsigned int thread, const std::string& timer)
+        {
+            os::TimingHistogram h;
+            return find(thread, timer, h) ? nsecs_to_Seconds( h.maximum() ) : 0.0;
+        }
+
+        Seconds ThreadStatsService::getMean(unsigned int thread, const std::string& timer)
+        {
+            os::TimingHistogram h;
+            return find(thread, timer, h) ? h.mean() / NSECS_IN_SECS : 0.0;
+        }
+
+        Seconds ThreadStatsService::getPercentile(unsigned int thread, const std::string& timer, double p)
+        {
+            os::TimingHistogram h;
+            return find(thread, timer, h) ? nsecs_to_Seconds( h.percentile(p) ) : 0.0;
+        }
+
+        bool ThreadStatsService::reset(unsigned int thread)
+        {
+            return os::Thread::resetThreadStatistics(thread);
+        }
+    }
+
+}
@@ -0,0 +1,119 @@
+/***************************************************************************
+  tag: ThreadStatsService.hpp
+
+                        ThreadStatsService.hpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef ORO_THREADSTATSSERVICE_HPP_
+#define ORO_THREADSTATSSERVICE_HPP_
+
+#include "../Service.hpp"
+#include "../os/ThreadStatistics.hpp"
+
+#include <vector>
+#include <string>
+
+namespace RTT
+{
+
+    namespace internal
+    {
+
+        /**
+         * The 'threads' service of the GlobalService, which reports the
+         * statistics recorded by each periodic os::Thread. The timers are
+         * 'wakeLatency' and 'execution'. Threads are looked up by their
+         * os::ThreadInterface::threadNumber(), since names need not be unique.
+         * All operations execute in the ClientThread and never block the
+         * threads they report on.
+         */
+        class ThreadStatsService: public RTT::Service
+        {
+        public:
+            ThreadStatsService();
+            virtual ~ThreadStatsService();
+
+            /**
+             * The number and name of all threads, each as "<number>: <name>".
+             */
+            std::vector<std::string> getThreads();
+
+            /**
+             * The number of overruns of \a thread.
+             */
+            unsigned int getOverruns(unsigned int thread);
+
+            /**
+             * The number of times \a timer of \a thread was recorded.
+             */
+            unsigned int getCount(unsigned int thread, const std::string& timer);
+
+            /**
+             * The shortest duration of \a timer of \a thread, in seconds.
+             */
+            Seconds getMin(unsigned int thread, const std::string& timer);
+
+            /**
+             * The longest duration of \a timer of \a thread, in seconds.
+             */
+            Seconds getMax(unsigned int thread, const std::string& timer);
+
+            /**
+             * The mean duration of \a timer of \a thread, in seconds.
+             */
+            Seconds getMean(unsigned int thread, const std::string& timer);
+
+            /**
+             * The duration below which a fraction \a p of the
+             * durations of \a timer of \a thread are found, in seconds.
+             */
+            Seconds getPercentile(unsigned int thread, const std::string& timer, double p);
+
+            /**
+             * Clears all statistics of \a thread.
+             */
+            bool reset(unsigned int thread);
+
+        private:
+            /**
+             * Copies the histogram of \a timer of \a thread into \a h.
+             * @return false if the thread or timer is unknown.
+             */
+            bool find(unsigned int thread, const std::string& timer, os::TimingHistogram& h);
+        };
+
+    }
+
+}
+
+#endif /* ORO_THREADSTATSSERVICE_HPP_ */
@@ -47,6 +47,7 @@
 #define RTT_TSPOOL_HPP_
 
 #include "../os/CAS.hpp"
+#include "PackedIndex.hpp"
 #include <assert.h>
 
 namespace RTT
@@ -56,9 +57,12 @@ namespace RTT
 
         /**
          * A multi-reader multi-writer MemoryPool implementation.
-         * It can hold max 65535 elements of type T.
+         * It can hold max 65535 elements of type T with the default
+         * \a Index type. Use an unsigned int \a Index for larger pools,
+         * which packs a 32-bit index and a 32-bit ABA tag in a 64-bit word
+         * and requires ORO_HAVE_CAS64.
          */
-        template<typename T>
+        template<typename T, typename Index = unsigned short>
         class TsPool
         {
         public:
@@ -66,11 +70,11 @@ namespace RTT
         private:
             union Pointer_t
             {
-                unsigned int value;
+                typename PackedIndex<Index>::type value;
                 struct _ptr_type
                 {
-                    unsigned short tag;
-                    unsigned short index;
+                    Index tag;
+                    Index index;
                 } ptr;
             };
 
@@ -116,7 +120,7 @@ namespace RTT
                 unsigned int i = 0, endseen = 0;
                 for (; i < pool_capacity; i++)
                 {
-                    if (pool[i].next.ptr.index == (unsigned short) -1)
+                    if (pool[i].next.ptr.index == (Index) -1)
                     {
                         ++endseen;
                     }
@@ -138,9 +142,9 @@ namespace RTT
             {
                 for (unsigned int i = 0; i < pool_capacity; i++)
                 {
-                    pool[i].next.ptr.index = i + 1;
+                    pool[i].next.ptr.index = Index(i + 1);
                 }
-                pool[pool_capacity - 1].next.ptr.index = (unsigned short) -1;
+                pool[pool_capacity - 1].next.ptr.index = (Index) -1;
                 head.next.ptr.index = 0;
             }
 
@@ -165,7 +169,7 @@ namespace RTT
                 {
                     oldval.value = head.next.value;
                     //List empty?
-                    if (oldval.ptr.index == (unsigned short) -1)
+                    if (oldval.ptr.index == (Index) -1)
                     {
                         return 0;
                     }
@@ -190,12 +194,71 @@ namespace RTT
                 {
                     oldval.value = head.next.value;
                     item->next.value = oldval.value;
-                    head_next.ptr.index = (item - pool);
+                    head_next.ptr.index = Index(item - pool);
                     head_next.ptr.tag = oldval.ptr.tag + 1;
                 } while (!os::CAS(&head.next.value, oldval.value, head_next.value));
                 return true;
             }
 
+            /**
+             * Allocates up to \a n elements with one CAS.
+             * @param items Receives the allocated elements.
+             * @return The number of elements stored in \a items,
+             * which is less than \a n if the pool runs empty.
+             */
+            size_type allocate(value_t** items, size_type n)
+            {
+                volatile Pointer_t oldval;
+                Pointer_t newval;
+                size_type k;
+                do
+                {
+                    oldval.value = head.next.value;
+                    Index next = oldval.ptr.index;
+                    // the chain is only used if the head did not change in the meantime,
+                    // but a concurrent allocate() may invalidate the indexes we follow.
+                    for (k = 0; k != n && next != (Index) -1 && next < pool_capacity; ++k)
+                    {
+                        items[k] = &pool[next].value;
+                        next = pool[next].next.ptr.index;
+                    }
+                    if (k == 0)
+                        return 0;
+                    newval.ptr.index = next;
+                    newval.ptr.tag = oldval.ptr.tag + 1;
+                } while (!os::CAS(&head.next.value, oldval.value, newval.value));
+                return k;
+            }
+
+            /**
+             * Returns \a n elements to the pool with one CAS.
+             * @param items The elements to release, which were all
+             * allocated from this pool.
+             */
+            void deallocate(value_t** items, size_type n)
+            {
+                if (n == 0)
+                    return;
+                Item* first = reinterpret_cast<Item*> (items[0]);
+                Item* last = first;
+                for (size_type i = 1; i != n; ++i)
+                {
+                    Item* item = reinterpret_cast<Item*> (items[i]);
+                    assert(item >= &pool[0] && item < &pool[pool_capacity]);
+                    last->next.ptr.index = Index(item - pool);
+                    last = item;
+                }
+                volatile Pointer_t oldval;
+                Pointer_t head_next;
+                do
+                {
+                    oldval.value = head.next.value;
+                    last->next.value = oldval.value;
+                    head_next.ptr.index = Index(first - pool);
+                    head_next.ptr.tag = oldval.ptr.tag + 1;
+                } while (!os::CAS(&head.next.value, oldval.value, head_next.value));
+            }
+
             /**
              * Return the number of elements that are available to be allocated.
              * This function is not thread-safe and should not be used when concurrent
@@ -207,7 +270,7 @@ namespace RTT
                 unsigned int ret = 0;
                 volatile Item* oldval;
                 oldval = &head;
-                while ( oldval->next.ptr.index != (unsigned short) -1) {
+                while ( oldval->next.ptr.index != (Index) -1) {
                     ++ret;
                     oldval = &pool[oldval->next.ptr.index];
                     assert(ret <= pool_capacity); // abort on corruption due to concurrency.
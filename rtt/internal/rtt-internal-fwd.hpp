@@ -87,12 +87,22 @@ namespace RTT {
         template<class T>
         class AtomicMWSRQueue;
         template<class T>
+        class AtomicMPMCQueue;
+        template<class T>
         class AtomicQueue;
         template<class T>
         class MWSRQueue;
         template<class T>
         class Queue;
         template<class T>
+        class SegmentedMWSRQueue;
+        template<class T>
+        class SamplePool;
+        template<class T>
+        class SharedSample;
+        template<class T>
+        class LoanedSample;
+        template<class T>
         struct AStore;
         template<class T>
         struct DSRStore;
@@ -158,7 +168,7 @@ namespace RTT {
         class PartDataSource;
         template<typename T>
         class ReferenceDataSource;
-        template<typename T>
+        template<typename T, typename Index>
         class TsPool;
         template<typename T>
         class ValueDataSource;
@@ -42,9 +42,7 @@
 #include "SignalBase.hpp"
 #include "NA.hpp"
 
-#ifdef ORO_SIGNAL_USE_LIST_LOCK_FREE
-#include <boost/bind.hpp>
-#else
+#ifndef ORO_SIGNAL_USE_SLOT_ARRAY
 #include "../os/MutexLock.hpp"
 #endif
 #endif // !OROCOS_SIGNAL_TEMPLATE_HEADER_INCLUDED
@@ -121,32 +119,18 @@ namespace RTT {
             return Handle(conn);
 		}
 
-    private:
-        static void emitImpl(const connection_t& c
-#if OROCOS_SIGNATURE_NUM_ARGS != 0
-                                        , OROCOS_SIGNATURE_PARMS
-#endif
-                         )
-        {
-            static_cast<connection_impl*>(c.get())->emit(OROCOS_SIGNATURE_ARGS);
-        }
-
-    public:
 		R emit(OROCOS_SIGNATURE_PARMS)
 		{
-#ifdef ORO_SIGNAL_USE_LIST_LOCK_FREE
-            this->emitting = true;
-
-            // this code did initially not work under gcc 4.0/ubuntu breezy.
-            // connection_t::get() const becomes an undefined symbol.
-            // works under gcc 3.4
-            mconnections.apply( boost::bind(&OROCOS_SIGNAL_N::emitImpl,
-                                                    _1
-#if OROCOS_SIGNATURE_NUM_ARGS != 0
-                                                    ,OROCOS_SIGNATURE_ARGS
-#endif
-                                                    ) );
-            this->emitting = false;
+#ifdef ORO_SIGNAL_USE_SLOT_ARRAY
+            // handlers may emit, connect and destroy connections, which
+            // does not affect the slots we are walking.
+            Walk walk(this);
+            for (Segment* seg = &this->mslots; seg; seg = seg->next)
+                for (unsigned int i = 0; i != seg->size; ++i) {
+                    ConnectionBase* c = seg->slots[i].conn;
+                    if (c)
+                        static_cast<connection_impl*>(c)->emit(OROCOS_SIGNATURE_ARGS);
+                }
 #else
             os::MutexLock lock(m);
             if (this->emitting)
@@ -41,6 +41,13 @@
 
 #include "oro_arch.h"
 
+/**
+ * Defined if CAS() can be used on 64-bit values on this platform.
+ */
+#if !defined(OROBLD_OS_NO_ASM) && ( defined(_MSC_VER) || defined(OROBLD_OS_ARCH_x86_64) || defined(OROBLD_OS_ARCH_aarch64) || defined(OROBLD_OS_ARCH_ia64) )
+# define ORO_HAVE_CAS64
+#endif
+
 namespace RTT
 { namespace os {
     /**
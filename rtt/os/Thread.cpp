@@ -43,8 +43,11 @@
 #include "MutexLock.hpp"
 #include "MainThread.hpp"
 
+#include <algorithm>
+
 #include "../rtt-config.h"
 #include "../internal/CatchConfig.hpp"
+#include "CAS.hpp"
 
 #ifdef OROPKG_OS_THREAD_SCOPE
 # include "../extras/dev/DigitalOutInterface.hpp"
@@ -72,6 +75,63 @@ namespace RTT {
        
         void Thread::setLockTimeoutPeriodFactor(double factor) { lock_timeout_period_factor = factor; }
 
+        namespace {
+            /**
+             * All Thread objects, such that their statistics
+             * can be looked up by name.
+             */
+            Mutex& registryLock() { static Mutex lock; return lock; }
+            std::vector<Thread*>& registry() { static std::vector<Thread*> threads; return threads; }
+
+            /**
+             * Sets the next period mark of \a task to the first multiple
+             * of \a period, plus \a phase, after now.
+             * @return the new period mark.
+             */
+            NANO_TIME alignPeriod(RTOS_TASK* task, NANO_TIME period, NANO_TIME phase)
+            {
+                phase %= period;
+                if (phase < 0)
+                    phase += period;
+                NANO_TIME now = rtos_get_time_ns();
+                NANO_TIME mark = ((now - phase) / period + 1) * period + phase;
+                rtos_task_set_period_at(task, period, mark);
+                return mark;
+            }
+
+            /**
+             * Touches \a bytes of stack below the caller, one page at a time.
+             * The write after the recursive call prevents a tail call.
+             */
+            void prefaultStack(unsigned int bytes)
+            {
+                volatile char page[4096];
+                page[0] = 0;
+                if ( bytes > sizeof(page) )
+                    prefaultStack( bytes - sizeof(page) );
+                page[sizeof(page) - 1] = 0;
+            }
+
+            /**
+             * Returns the stack size of the calling thread, or \a configured
+             * if the OS can not tell. Zero means unknown.
+             */
+            unsigned int stackSize(unsigned int configured)
+            {
+#ifdef OROPKG_OS_GNULINUX
+                pthread_attr_t attr;
+                size_t size = 0;
+                if ( pthread_getattr_np(pthread_self(), &attr) == 0 ) {
+                    pthread_attr_getstacksize(&attr, &size);
+                    pthread_attr_destroy(&attr);
+                }
+                if ( size != 0 )
+                    return size;
+#endif
+                return configured;
+            }
+        }
+
         void *thread_function(void* t)
         {
             /**
@@ -95,6 +155,11 @@ namespace RTT {
 
             int overruns = 0, cur_sched = task->msched_type;
             NANO_TIME cur_period = task->period;
+            // the moment the current and the next step() are due,
+            // following the period mark kept by rtos_task_wait_period().
+            NANO_TIME due = 0, next_due = 0;
+            bool cur_aligned = false;
+            NANO_TIME cur_phase = 0;
 
             while (!task->prepareForExit)
             {
@@ -113,6 +178,9 @@ namespace RTT {
                                 rtos_task_set_period(task->getTask(), 0);
                             }
                             rtos_sem_wait(&(task->sem)); // wait for command.
+                            // start() calls from now on need a new wakeup. Unlike a
+                            // plain store, the CAS orders this before loop().
+                            CAS(&task->mtrigger_pending, 1, 0);
                             task->configure();           // check for reconfigure
                             if (task->prepareForExit)    // check for exit
                             {
@@ -126,8 +194,22 @@ namespace RTT {
                             if (task->period != 0) // periodic
                             {
                                 MutexLock lock(task->breaker);
+                                cur_aligned = task->maligned;
+                                cur_phase = task->mphase;
+                                if (cur_aligned) {
+                                    // the first step() is due on the first aligned period mark.
+                                    due = alignPeriod(task->getTask(), task->period, cur_phase);
+                                    rtos_task_wait_period(task->getTask());
+                                    next_due = due + task->period;
+                                } else {
+                                    // the first step() is due now.
+                                    due = rtos_get_time_ns();
+                                    next_due = due + task->period;
+                                }
                                 while(task->running && !task->prepareForExit )
                                 {
+                                    NANO_TIME begin = rtos_get_time_ns();
+                                    task->mstats.recordWakeLatency( begin - due );
                                     TRY
                                     (
                                         SCOPE_ON
@@ -139,16 +221,34 @@ namespace RTT {
                                         SCOPE_OFF
                                         throw;
                                     )
+                                    NANO_TIME end = rtos_get_time_ns();
+                                    task->mstats.recordExecution( end - begin );
 
                                     // Check changes in period
                                     if ( cur_period != task->period) {
                                         // reconfigure period before going to sleep
-                                        rtos_task_set_period(task->getTask(), task->period);
                                         cur_period = task->period;
+                                        if (cur_aligned && cur_period != 0)
+                                            next_due = alignPeriod(task->getTask(), cur_period, cur_phase);
+                                        else {
+                                            rtos_task_set_period(task->getTask(), cur_period);
+                                            next_due = end + cur_period;
+                                        }
                                         if (cur_period == 0)
                                             break; // break while(task->running) if no longer periodic
                                     }
 
+                                    // Check changes in alignment
+                                    if ( cur_aligned != task->maligned || cur_phase != task->mphase ) {
+                                        cur_aligned = task->maligned;
+                                        cur_phase = task->mphase;
+                                        if (cur_aligned)
+                                            next_due = alignPeriod(task->getTask(), cur_period, cur_phase);
+                                    }
+
+                                    if ( task->mprofile_changed )
+                                        task->applyProfile();
+
                                     // Check changes in scheduler
                                     if ( cur_sched != task->msched_type) {
                                         rtos_task_set_scheduler(task->getTask(), task->msched_type);
@@ -159,12 +259,24 @@ namespace RTT {
                                     // return non-zero to indicate overrun.
                                     if (rtos_task_wait_period(task->getTask()) != 0)
                                     {
+                                        task->mstats.overrun();
                                         ++overruns;
                                         if (overruns == task->maxOverRun)
                                             break; // break while(task->running)
                                     }
                                     else if (overruns != 0)
                                         --overruns;
+
+                                    // advance like the period mark: in absolute mode, it skips
+                                    // the periods which were missed by more than 4 periods.
+                                    due = next_due;
+                                    if (task->mwait_policy == ORO_WAIT_ABS) {
+                                        if (end - due > 4 * cur_period)
+                                            next_due = due + cur_period * ((end - due) / cur_period);
+                                        else
+                                            next_due = due + cur_period;
+                                    } else
+                                        next_due = rtos_get_time_ns() + cur_period;
                                 } // while(task->running)
                                 if (overruns == task->maxOverRun || task->prepareForExit)
                                     break; // break while(1) {}
@@ -242,9 +354,30 @@ namespace RTT {
 #ifdef OROPKG_OS_THREAD_SCOPE
         ,d(NULL)
 #endif
-                    , stopTimeout(0)
+                    , stopTimeout(0), mwait_policy(ORO_WAIT_ABS), maligned(false), mphase(0),
+                    mtrigger_pending(0), mcoalesced(0), mprofile_changed(false), mdeadline(false), mstack_size(0)
         {
             this->setup(_priority, cpu_affinity, name);
+            MutexLock lock( registryLock() );
+            registry().push_back(this);
+        }
+
+        Thread::Thread(int scheduler, int _priority,
+                Seconds periods, const ThreadProfile& profile, const std::string & name) :
+                    msched_type(scheduler), active(false), prepareForExit(false),
+                    inloop(false),running(false),
+                    maxOverRun(OROSEM_OS_PERIODIC_THREADS_MAX_OVERRUN),
+                    period(Seconds_to_nsecs(periods))
+#ifdef OROPKG_OS_THREAD_SCOPE
+        ,d(NULL)
+#endif
+                    , stopTimeout(0), mwait_policy(ORO_WAIT_ABS), maligned(false), mphase(0),
+                    mtrigger_pending(0), mcoalesced(0), mprofile(profile), mprofile_changed(true), mdeadline(false), mstack_size(0)
+        {
+            // the profile is applied by the first configure() of the thread.
+            this->setup(_priority, 0, name);
+            MutexLock lock( registryLock() );
+            registry().push_back(this);
         }
 
         void Thread::setup(int _priority, unsigned cpu_affinity, const std::string& name)
@@ -289,8 +422,9 @@ namespace RTT {
                 }
             }
 #endif
+            mstack_size = default_stack_size;
             int rv = rtos_task_create(&rtos_task, _priority, cpu_affinity, name.c_str(),
-                    msched_type, default_stack_size, thread_function, this);
+                    msched_type, mstack_size, thread_function, this);
             if (rv != 0)
             {
                 log(Critical) << "Could not create thread "
@@ -325,6 +459,10 @@ namespace RTT {
         Thread::~Thread()
         {
             Logger::In in("~Thread");
+            {
+                MutexLock lock( registryLock() );
+                registry().erase( std::find(registry().begin(), registry().end(), this) );
+            }
             if (this->isRunning())
                 this->stop();
 
@@ -341,20 +479,15 @@ namespace RTT {
             {
                 // just signal if already active.
                 if ( isActive() ) {
-#ifndef OROPKG_OS_MACOSX
-                    // This is a 'weak' race condition.
-                    // it could be that sem becomes zero
-                    // after this check. Technically, this means
-                    // loop is being executed (preemption) during start().
-                    // For most user code, this is sufficient though, as it
-                    // can not know the difference between executing loop()
-                    // *in* start or *right after* start (the latter is
-                    // guaranteed by the API).
+                    // Only the caller which sets the pending flag signals sem.
+                    // The others are served by that wakeup, since the thread
+                    // clears the flag before it calls loop().
                     // @see ActivityInterface::trigger for how trigger uses this
                     // assumption.
-                    if ( rtos_sem_value(&sem) > 0 )
+                    if ( !CAS(&mtrigger_pending, 0, 1) ) {
+                        mcoalesced.inc();
                         return true;
-#endif
+                    }
                     rtos_sem_signal(&sem);
                     return true;
                 }
@@ -501,8 +634,11 @@ namespace RTT {
             // reconfigure period
             rtos_task_set_period(&rtos_task, period);
 
-            // reconfigure scheduler.
-            if (msched_type != rtos_task_get_scheduler(&rtos_task))
+            if (mprofile_changed)
+                applyProfile();
+
+            // reconfigure scheduler, unless the deadline scheduler runs us.
+            if (!mdeadline && msched_type != rtos_task_get_scheduler(&rtos_task))
             {
                 rtos_task_set_scheduler(&rtos_task, msched_type);
                 msched_type = rtos_task_get_scheduler(&rtos_task);
@@ -647,6 +783,111 @@ namespace RTT {
         void Thread::setWaitPeriodPolicy(int p)
         {
             rtos_task_set_wait_period_policy(&rtos_task, p);  
+            mwait_policy = p;
+        }
+
+        void Thread::setClockAlignment(bool aligned, Seconds phase)
+        {
+            mphase = Seconds_to_nsecs(phase);
+            maligned = aligned;
+        }
+
+        bool Thread::isClockAligned() const
+        {
+            return maligned;
+        }
+
+        Seconds Thread::getClockPhase() const
+        {
+            return nsecs_to_Seconds(mphase);
+        }
+
+        ThreadStatistics* Thread::getThreadStatistics()
+        {
+            return &mstats;
+        }
+
+        void Thread::setProfile(const ThreadProfile& profile)
+        {
+            {
+                MutexLock lock(mprofile_lock);
+                mprofile = profile;
+                mprofile_changed = true;
+            }
+            // wake up a waiting thread, like setScheduler().
+            if ( !isPeriodic() )
+                rtos_sem_signal(&sem);
+        }
+
+        ThreadProfile Thread::getProfile() const
+        {
+            MutexLock lock(mprofile_lock);
+            return mprofile;
+        }
+
+        void Thread::applyProfile()
+        {
+            ThreadProfile profile;
+            {
+                MutexLock lock(mprofile_lock);
+                profile = mprofile;
+                mprofile_changed = false;
+            }
+            if ( rtos_task_set_profile(&rtos_task, profile) != 0 )
+                log(Warning) << "Thread '" << getName() << "' could not apply all settings of its profile." << endlog();
+            mdeadline = profile.dl_runtime > 0.0;
+            if ( profile.stack_prefault != 0 ) {
+                // leave room for the frames above us and for the
+                // bookkeeping of each page prefaultStack() touches.
+                unsigned int stack = stackSize(mstack_size);
+                unsigned int margin = 64 * 1024 + stack / 16;
+                unsigned int bytes = profile.stack_prefault;
+                if ( stack <= margin )
+                    bytes = 0;
+                else if ( bytes > stack - margin )
+                    bytes = stack - margin;
+                if ( bytes != profile.stack_prefault )
+                    log(Warning) << "Thread '" << getName() << "' prefaults " << bytes << " instead of "
+                                 << profile.stack_prefault << " bytes of its " << stack << " bytes stack." << endlog();
+                if ( bytes != 0 )
+                    prefaultStack(bytes);
+            }
+        }
+
+        unsigned int Thread::getCoalescedTriggers() const
+        {
+            return mcoalesced.read();
+        }
+
+        std::vector< std::pair<unsigned int, std::string> > Thread::getThreads()
+        {
+            MutexLock lock( registryLock() );
+            std::vector< std::pair<unsigned int, std::string> > threads;
+            for (std::vector<Thread*>::iterator it = registry().begin(); it != registry().end(); ++it)
+                threads.push_back( std::make_pair( (*it)->threadNumber(), std::string( (*it)->getName() ) ) );
+            return threads;
+        }
+
+        bool Thread::copyThreadStatistics(unsigned int thread, ThreadStatistics& stats)
+        {
+            MutexLock lock( registryLock() );
+            for (std::vector<Thread*>::iterator it = registry().begin(); it != registry().end(); ++it)
+                if ( thread == (*it)->threadNumber() ) {
+                    (*it)->mstats.copy( stats );
+                    return true;
+                }
+            return false;
+        }
+
+        bool Thread::resetThreadStatistics(unsigned int thread)
+        {
+            MutexLock lock( registryLock() );
+            for (std::vector<Thread*>::iterator it = registry().begin(); it != registry().end(); ++it)
+                if ( thread == (*it)->threadNumber() ) {
+                    (*it)->mstats.reset();
+                    return true;
+                }
+            return false;
         }
 
     }
@@ -44,8 +44,12 @@
 
 #include "ThreadInterface.hpp"
 #include "Mutex.hpp"
+#include "Atomic.hpp"
+#include "ThreadProfile.hpp"
 
 #include <string>
+#include <vector>
+#include <utility>
 
 namespace RTT
 {
@@ -73,6 +77,15 @@ namespace RTT
          * Step() overruns are detected and the threshold to 'emergency stop' the thread can be
          * set by \a setMaxOverrun(). Overruns must be accumulated 'on average' to trigger this behavior:
          * one not overrunning step() compensates for one overrunning step().
+         * In addition, every periodic thread records the latency of each wake-up,
+         * the duration of each step() and the total number of overruns in its
+         * ThreadStatistics. See getThreadStatistics().
+         *
+         * By default, the periods start when start() is called. With
+         * setClockAlignment(), each step() is due at a multiple of the period
+         * on the RTOS clock, plus a phase offset. Threads with the same period
+         * then run in a fixed order within each period, for example a sensor
+         * reader at phase 0 and a controller at phase 0.0002 of a 1 kHz cycle.
          *
          * @section Non periodic behaviour
          *
@@ -126,6 +139,20 @@ namespace RTT
             Thread(int scheduler, int priority, double period, unsigned cpu_affinity,
                    const std::string & name);
 
+            /**
+             * Create a Thread with a given scheduler type, priority, placement
+             * and memory settings and a name.
+             *
+             * @param scheduler The scheduler, one of ORO_SCHED_RT or ORO_SCHED_OTHER.
+             * @param priority The priority of the thread, this is interpreted by your RTOS.
+             * @param period   The period in seconds (eg 0.001) of the thread, or zero if not periodic.
+             * @param profile  The CPU set, memory and deadline scheduling settings,
+             *                 which the thread applies before it runs any user code.
+             * @param name     The name of the Thread. May be used by your OS to identify the thread.
+             */
+            Thread(int scheduler, int priority, double period, const ThreadProfile& profile,
+                   const std::string & name);
+
             virtual ~Thread();
 
             /**
@@ -242,6 +269,72 @@ namespace RTT
 
             virtual void setWaitPeriodPolicy(int p);
 
+            /**
+             * Aligns the periods of this thread to the RTOS clock, such that
+             * each step() is due at a multiple of the period plus \a phase.
+             * This takes effect from the next period on and requires the
+             * ORO_WAIT_ABS wait policy, since ORO_WAIT_REL restarts the
+             * period when step() returns.
+             * @param aligned Set to false to start the periods at start() again.
+             * @param phase The offset from the start of each period in seconds.
+             * It is taken modulo the period.
+             */
+            void setClockAlignment(bool aligned, Seconds phase = 0.0);
+
+            /**
+             * Returns true if the periods are aligned to the RTOS clock.
+             */
+            bool isClockAligned() const;
+
+            /**
+             * Returns the phase offset set with setClockAlignment(), in seconds.
+             */
+            Seconds getClockPhase() const;
+
+            /**
+             * Changes the CPU set, memory and deadline scheduling settings
+             * of this thread. The thread applies them itself, before its next
+             * step() or loop(). Settings left at their default in \a profile
+             * keep their current value.
+             */
+            void setProfile(const ThreadProfile& profile);
+
+            /**
+             * Returns the settings last passed to setProfile().
+             */
+            ThreadProfile getProfile() const;
+
+            virtual ThreadStatistics* getThreadStatistics();
+
+            /**
+             * Returns the number of times start() was called on an active,
+             * non periodic thread while a wakeup was still pending. These calls
+             * were served by the pending wakeup instead of by a loop() of their own.
+             */
+            unsigned int getCoalescedTriggers() const;
+
+            /**
+             * Returns the threadNumber() and name of all Thread objects in
+             * this process. Names need not be unique, thread numbers are.
+             * @nrt
+             */
+            static std::vector< std::pair<unsigned int, std::string> > getThreads();
+
+            /**
+             * Copies a consistent snapshot of the statistics of the Thread
+             * with threadNumber() \a thread into \a stats.
+             * @return false if no such Thread exists.
+             * @nrt
+             */
+            static bool copyThreadStatistics(unsigned int thread, ThreadStatistics& stats);
+
+            /**
+             * Clears the statistics of the Thread with threadNumber() \a thread.
+             * @return false if no such Thread exists.
+             * @nrt
+             */
+            static bool resetThreadStatistics(unsigned int thread);
+
         protected:
             /**
              * Exit and destroy the thread
@@ -355,6 +448,45 @@ namespace RTT
              */
             double stopTimeout;
 
+            /**
+             * The wait policy passed to setWaitPeriodPolicy(),
+             * which determines when the next step() is due.
+             */
+            int mwait_policy;
+
+            /**
+             * Set by setClockAlignment() and applied by thread_function().
+             */
+            volatile bool maligned;
+            volatile NANO_TIME mphase;
+
+            /**
+             * Written by thread_function() in each period.
+             */
+            ThreadStatistics mstats;
+
+            /**
+             * Set by start() when it wakes up a non periodic thread and
+             * cleared by thread_function() before it calls loop().
+             */
+            volatile int mtrigger_pending;
+            AtomicInt mcoalesced;
+
+            /**
+             * Set by setProfile() and applied by applyProfile(),
+             * from within the thread.
+             */
+            ThreadProfile mprofile;
+            mutable Mutex mprofile_lock;
+            volatile bool mprofile_changed;
+            bool mdeadline;
+            /**
+             * The stack size passed to rtos_task_create(), 0 for the
+             * default of the OS.
+             */
+            unsigned int mstack_size;
+            void applyProfile();
+
 #ifdef OROPKG_OS_THREAD_SCOPE
             // Pointer to Threadscope device
             dev::DigitalOutInterface * d;
@@ -42,6 +42,7 @@
 #include "fosi.h"
 #include "threads.hpp"
 #include "Time.hpp"
+#include "ThreadStatistics.hpp"
 #include "../rtt-config.h"
 
 namespace RTT
@@ -205,6 +206,14 @@ namespace RTT
              */
             virtual void setWaitPeriodPolicy(int p) = 0;
 
+            /**
+             * Returns the wake-up latency, execution time and overrun
+             * statistics of this thread, which are recorded in each
+             * period of a periodic thread.
+             * @return null if this thread does not record statistics.
+             */
+            virtual ThreadStatistics* getThreadStatistics() { return 0; }
+
             /**
              * Yields (put to the back of the scheduler queue) the calling thread.
              */
@@ -0,0 +1,99 @@
+/***************************************************************************
+  tag: ThreadProfile.hpp
+
+                        ThreadProfile.hpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_OS_THREAD_PROFILE_HPP
+#define ORO_OS_THREAD_PROFILE_HPP
+
+#include "Time.hpp"
+#include <vector>
+
+namespace RTT
+{ namespace os {
+
+    /**
+     * The placement and memory settings of a thread, in addition to its
+     * scheduler and priority. A Thread applies its profile from within
+     * the thread itself, since most of these settings only apply to
+     * the calling thread.
+     * @see Thread::setProfile()
+     */
+    struct ThreadProfile
+    {
+        ThreadProfile()
+            : memory_node(-1), lock_memory(false), stack_prefault(0),
+              dl_runtime(0.0), dl_deadline(0.0), dl_period(0.0) {}
+
+        /**
+         * The CPUs the thread may run on, or any CPU if empty.
+         * Contrary to a cpu_affinity bit mask, CPUs numbered 32 and
+         * higher can be listed.
+         */
+        std::vector<unsigned int> cpus;
+
+        /**
+         * The memory node the thread allocates its memory from, or
+         * -1 to keep the default memory policy.
+         */
+        int memory_node;
+
+        /**
+         * Lock all current and future memory of the process in RAM.
+         */
+        bool lock_memory;
+
+        /**
+         * The number of bytes of stack the thread touches when it
+         * starts, such that it does not page fault on it later on.
+         * It is limited to the stack size of the thread minus a margin.
+         * When the stack size is unknown, the stack is not touched.
+         */
+        unsigned int stack_prefault;
+
+        /**
+         * When dl_runtime is not zero, the thread is scheduled by the
+         * deadline scheduler instead of by its scheduler and priority.
+         * It then gets dl_runtime seconds of CPU time within
+         * dl_deadline seconds of the start of each dl_period.
+         * A zero dl_deadline equals dl_period and vice versa.
+         */
+        Seconds dl_runtime;
+        Seconds dl_deadline;
+        Seconds dl_period;
+    };
+}}
+
+#endif
@@ -0,0 +1,177 @@
+/***************************************************************************
+  tag: ThreadStatistics.hpp
+
+                        ThreadStatistics.hpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_OS_THREAD_STATISTICS_HPP
+#define ORO_OS_THREAD_STATISTICS_HPP
+
+#include "TimingHistogram.hpp"
+#include "CAS.hpp"
+
+namespace RTT
+{ namespace os {
+
+    /**
+     * The timing statistics of a periodic thread, recorded by the
+     * thread itself in each period without allocating memory.
+     * Like a TimingHistogram, it may be read from any thread while
+     * it is being recorded. Use copy() for a consistent snapshot of
+     * all statistics.
+     * @see ThreadInterface::getThreadStatistics()
+     */
+    struct ThreadStatistics
+    {
+        ThreadStatistics()
+            : moverruns(0), mreset(false), mseq(0) {}
+
+        /**
+         * The time between the moment a step() was due and the
+         * moment it started, in nanoseconds.
+         */
+        TimingHistogram wakeLatency;
+
+        /**
+         * The duration of each step(), in nanoseconds.
+         */
+        TimingHistogram execution;
+
+        /**
+         * Records the wake-up latency of one period. Only called by the
+         * recording thread.
+         */
+        void recordWakeLatency(nsecs t)
+        {
+            begin();
+            wakeLatency.record(t);
+            end();
+        }
+
+        /**
+         * Records the duration of one step(). Only called by the
+         * recording thread.
+         */
+        void recordExecution(nsecs t)
+        {
+            begin();
+            execution.record(t);
+            end();
+        }
+
+        /**
+         * Records one period in which step() did not return before
+         * the next period started. Only called by the recording thread.
+         */
+        void overrun()
+        {
+            begin();
+            if ( mreset ) {
+                moverruns = 0;
+                mreset = false;
+            }
+            ++moverruns;
+            end();
+        }
+
+        /**
+         * Copies all statistics into \a to, such that they
+         * all stem from the same moment in the recording thread.
+         */
+        void copy(ThreadStatistics& to) const
+        {
+            unsigned int start;
+            do {
+                start = mseq;
+                barrier();
+                to.wakeLatency = wakeLatency;
+                to.execution = execution;
+                to.moverruns = moverruns;
+                to.mreset = mreset;
+                barrier();
+            } while ( (start & 1) || start != mseq ); // recorded meanwhile
+            to.mseq = 0;
+        }
+
+        /**
+         * The number of overruns recorded. Contrary to the overruns
+         * checked against Thread::setMaxOverrun(), this count never
+         * decreases, except by reset().
+         */
+        unsigned int overruns() const { return mreset ? 0 : moverruns; }
+
+        /**
+         * Requests to clear all statistics. They are cleared
+         * by the recording thread, before it records the next sample.
+         */
+        void reset()
+        {
+            wakeLatency.reset();
+            execution.reset();
+            mreset = true;
+        }
+
+    private:
+        /**
+         * A locked instruction on a private word orders the memory
+         * accesses around it like a full barrier.
+         */
+        static void barrier()
+        {
+            volatile unsigned int word = 0;
+            CAS(&word, 0u, 0u);
+        }
+
+        /**
+         * mseq is odd while the recording thread records.
+         */
+        void begin()
+        {
+            mseq = mseq + 1;
+            barrier();
+        }
+
+        void end()
+        {
+            barrier();
+            mseq = mseq + 1;
+        }
+
+        volatile unsigned int moverruns;
+        volatile bool mreset;
+        volatile unsigned int mseq;
+    };
+}}
+
+#endif
@@ -42,6 +42,7 @@
 #include "../Logger.hpp"
 #include "../os/fosi.h"
 #include <limits>
+#include <algorithm>
 
 namespace RTT {
     using namespace base;
@@ -61,24 +62,19 @@ namespace RTT {
     void Timer::loop()
     {
         // This code is executed from mThread's thread
+        // The timers that expired at the last wake-up.
+        std::vector<TimerId> expired;
         while (!mdo_quit) {
             Time wake_up_time;
-            TimerId next_timer_id = 0;
 
             // Select next timer.
             {// This scope is for MutexLock.
-                // find wake_up_time
-                // check timers queue.
                 MutexLock locker(m);
                 // We can't use infinite as the OS may internally use time_spec, which can not
                 // represent as much in the future (until 2038) // XXX Year-2038 Bug
                 wake_up_time = 1000000000LL * std::numeric_limits<int32_t>::max();
-                for (TimerIds::iterator it = mtimers.begin(); it != mtimers.end(); ++it) {
-                    if ( it->expires != 0 && it->expires < wake_up_time  ) {
-                        wake_up_time = it->expires;
-                        next_timer_id = it - mtimers.begin();
-                    }
-                }
+                if ( !mheap.empty() )
+                    wake_up_time = mtimers[ mheap.front() ].expires;
             }// MutexLock
 
             // Wait
@@ -91,40 +87,54 @@ namespace RTT {
 
             // Timeout handling
             if (ret == -1) {
-                // a timer expired
-                // expires: reset/reprogram the timer that expired:
+                // timers expired
                 {
                     MutexLock locker(m);
-                    // detect corner case for resize:
-                    if ( next_timer_id < int(mtimers.size()) ) {
-                        // now clear or reprogram it.
-                        TimerIds::iterator tim = mtimers.begin() + next_timer_id;
+                    now = rtos_get_time_ns();
+                    // First: collect all timers that expired. These are removed from
+                    // the heap before reprogramming, such that late periodic timers
+                    // do not fire twice in one batch.
+                    expired.clear();
+                    expired.reserve( mtimers.size() );
+                    while ( !mheap.empty() && mtimers[ mheap.front() ].expires <= now ) {
+                        expired.push_back( mheap.front() );
+                        heapRemove( 0 );
+                    }
+                    // Second: clear or reprogram them and notify waiting threads.
+                    for (unsigned int i = 0; i != expired.size(); ++i) {
+                        TimerIds::iterator tim = mtimers.begin() + expired[i];
+                        tim->pending = true;
                         if ( tim->period ) {
                             // periodic timer
                             // if late by more than 4 periods, skip late updates
                             int maxDelayInPeriods = 4;
-                            if (now - tim->expires > tim->period*maxDelayInPeriods) {
-                                tim->expires += tim->period*((now - tim->expires) / tim->period);
+                            Time expires = tim->expires;
+                            if (now - expires > tim->period*maxDelayInPeriods) {
+                                expires += tim->period*((now - expires) / tim->period);
                             }
-                            tim->expires += tim->period;
+                            schedule( expired[i], expires + tim->period, tim->period );
                         } else {
                             // aperiodic timer
                             tim->expires = 0;
                         }
+                        tim->expired.broadcast();
                     }
                 }
 
-                // Second: notify waiting threads
-                {// This scope is for MutexLock.
-                    MutexLock locker(m);
-                    mtimers[next_timer_id].expired.broadcast();
-                }// MutexLock
-
-                // Third: send the timeout signal and allow (within the callback)
-                // to reprogram the timer.
+                // Third: send the timeout signals and allow (within the callback)
+                // to reprogram the timers.
                 // If we would expires call timeout(), the code above would overwrite
-                // user settings.
-                timeout( next_timer_id );
+                // user settings. A callback may kill the other timers of this batch
+                // or resize the timers, so check each one before its timeout().
+                for (unsigned int i = 0; i != expired.size(); ++i) {
+                    {
+                        MutexLock locker(m);
+                        if ( expired[i] >= int(mtimers.size()) || !mtimers[ expired[i] ].pending )
+                            continue;
+                        mtimers[ expired[i] ].pending = false;
+                    }
+                    timeout( expired[i] );
+                }
             }
         }
     }
@@ -144,6 +154,7 @@ namespace RTT {
         : mThread(0), msem(0), mdo_quit(false)
     {
         mtimers.resize(max_timers);
+        mheap.reserve(max_timers);
         if (scheduler != -1) {
             mThread = new Activity(scheduler, priority, 0.0, this, "Timer");
             mThread->start();
@@ -164,7 +175,87 @@ namespace RTT {
     void Timer::setMaxTimers(TimerId max)
     {
         MutexLock locker(m);
+        // remove the timers that go away from the heap.
+        for (TimerId i = max; i < int(mtimers.size()); ++i)
+            unschedule(i);
         mtimers.resize(max, TimerInfo() );
+        mheap.reserve(max);
+    }
+
+    bool Timer::heapLess(TimerId a, TimerId b) const
+    {
+        // equal expiry times fire in the order of their ids.
+        return mtimers[a].expires < mtimers[b].expires
+            || ( mtimers[a].expires == mtimers[b].expires && a < b );
+    }
+
+    void Timer::heapSwap(int a, int b)
+    {
+        std::swap( mheap[a], mheap[b] );
+        mtimers[ mheap[a] ].heap_pos = a;
+        mtimers[ mheap[b] ].heap_pos = b;
+    }
+
+    void Timer::heapUp(int pos)
+    {
+        while ( pos > 0 && heapLess( mheap[pos], mheap[(pos - 1) / 2] ) ) {
+            heapSwap( pos, (pos - 1) / 2 );
+            pos = (pos - 1) / 2;
+        }
+    }
+
+    void Timer::heapDown(int pos)
+    {
+        int size = mheap.size();
+        while ( true ) {
+            int smallest = pos;
+            int left = 2 * pos + 1, right = left + 1;
+            if ( left < size && heapLess( mheap[left], mheap[smallest] ) )
+                smallest = left;
+            if ( right < size && heapLess( mheap[right], mheap[smallest] ) )
+                smallest = right;
+            if ( smallest == pos )
+                return;
+            heapSwap( pos, smallest );
+            pos = smallest;
+        }
+    }
+
+    void Timer::heapRemove(int pos)
+    {
+        mtimers[ mheap[pos] ].heap_pos = -1;
+        TimerId moved = mheap.back();
+        mheap.pop_back();
+        if ( pos == int(mheap.size()) )
+            return;
+        // fill the hole with the last timer and restore the heap order.
+        mheap[pos] = moved;
+        mtimers[moved].heap_pos = pos;
+        heapUp( pos );
+        heapDown( mtimers[moved].heap_pos );
+    }
+
+    void Timer::schedule(TimerId timer_id, Time expires, Time period)
+    {
+        TimerInfo& tim = mtimers[timer_id];
+        tim.expires = expires;
+        tim.period = period;
+        if ( tim.heap_pos == -1 ) {
+            tim.heap_pos = mheap.size();
+            mheap.push_back( timer_id );
+        }
+        heapUp( tim.heap_pos );
+        heapDown( tim.heap_pos );
+    }
+
+    void Timer::unschedule(TimerId timer_id)
+    {
+        TimerInfo& tim = mtimers[timer_id];
+        if ( tim.heap_pos != -1 )
+            heapRemove( tim.heap_pos );
+        tim.expires = 0;
+        tim.period = 0;
+        tim.pending = false;
     }
 
     bool Timer::startTimer(TimerId timer_id, double period)
@@ -179,8 +270,9 @@ namespace RTT {
 
         {
             MutexLock locker(m);
-            mtimers[timer_id].expires = due_time;
-            mtimers[timer_id].period = Seconds_to_nsecs( period );
+            // an expired timer which is restarted is not reported anymore.
+            mtimers[timer_id].pending = false;
+            schedule( timer_id, due_time, Seconds_to_nsecs( period ) );
         }
         msem.signal();
         return true;
@@ -199,8 +291,8 @@ namespace RTT {
 
         {
             MutexLock locker(m);
-            mtimers[timer_id].expires  = due_time;
-            mtimers[timer_id].period = 0;
+            mtimers[timer_id].pending = false;
+            schedule( timer_id, due_time, 0 );
         }
         msem.signal();
         return true;
@@ -241,8 +333,7 @@ namespace RTT {
             log(Error) << "Invalid timer id" << endlog();
             return false;
         }
-        mtimers[timer_id].expires = 0;
-        mtimers[timer_id].period = 0;
+        unschedule( timer_id );
         mtimers[timer_id].expired.broadcast();
         return true;
     }
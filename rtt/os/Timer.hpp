@@ -80,11 +80,13 @@ namespace RTT
 
         struct TimerInfo
         {
-            TimerInfo() : expires(0), period(0) {}
+            TimerInfo() : expires(0), period(0), heap_pos(-1), pending(false) {}
             TimerInfo(const TimerInfo& other) { *this = other; }
-            TimerInfo& operator=(const TimerInfo& other) { this->expires = other.expires; this->period = other.period; return *this; }
+            TimerInfo& operator=(const TimerInfo& other) { this->expires = other.expires; this->period = other.period; this->heap_pos = other.heap_pos; this->pending = other.pending; return *this; }
             Time expires; // was .first
             Time period;  // was .second
+            int heap_pos; // position in mheap, or -1 if not armed.
+            bool pending; // expired, but timeout() not yet called.
             Condition expired;
         };
 
@@ -95,6 +97,12 @@ namespace RTT
          */
         typedef std::vector<TimerInfo> TimerIds;
         TimerIds mtimers;
+        /**
+         * The armed timers, ordered as a binary min-heap on their
+         * expiry time, such that arming, killing and finding the
+         * next timer is O(log N) instead of a scan of mtimers.
+         */
+        std::vector<TimerId> mheap;
         bool mdo_quit;
 
         bool initialize();
@@ -106,6 +114,23 @@ namespace RTT
 
         bool breakLoop();
 
+    private:
+        /**
+         * Sets the expiry time and period of a timer and
+         * updates its position in mheap. Requires the lock on m.
+         */
+        void schedule(TimerId timer_id, Time expires, Time period);
+        /**
+         * Disarms a timer, removes it from mheap and cancels a pending
+         * timeout() call. Requires the lock on m.
+         */
+        void unschedule(TimerId timer_id);
+        bool heapLess(TimerId a, TimerId b) const;
+        void heapSwap(int a, int b);
+        void heapUp(int pos);
+        void heapDown(int pos);
+        void heapRemove(int pos);
+
     public:
         /**
          * Create a timer object which can hold \a max_timers timers.
@@ -126,6 +151,9 @@ namespace RTT
         /**
          * This function is called each time an armed or periodic timer expires.
          * The user must implement this method to catch the time outs.
+         * When several timers expire at once, this is called for each of them
+         * in the order of their expiry times. A timer which an earlier call
+         * in the same batch killed or re-armed is not reported.
          * @param timer_id The number of the timer that expired.
          */
         virtual void timeout(TimerId timer_id);
@@ -0,0 +1,84 @@
+/***************************************************************************
+  tag: TimingHistogram.cpp
+
+                        TimingHistogram.cpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "TimingHistogram.hpp"
+
+namespace RTT
+{ namespace os {
+
+    TimingHistogram::TimingHistogram()
+        : mreset(false)
+    {
+        this->clear();
+    }
+
+    void TimingHistogram::clear()
+    {
+        mcount = 0;
+        mmin = 0;
+        mmax = 0;
+        msum = 0;
+        for (int i = 0; i != Buckets; ++i)
+            mbuckets[i] = 0;
+    }
+
+    double TimingHistogram::mean() const
+    {
+        unsigned int c = this->count();
+        return c ? double(msum) / c : 0.0;
+    }
+
+    nsecs TimingHistogram::percentile(double p) const
+    {
+        unsigned int c = this->count();
+        if ( c == 0 )
+            return 0;
+        // the number of samples which must be at or below the result:
+        unsigned int target = (unsigned int)( p * c );
+        if ( target < p * c )
+            ++target;
+        unsigned int seen = 0;
+        for (int i = 0; i != Buckets; ++i) {
+            seen += mbuckets[i];
+            if ( seen >= target ) {
+                nsecs upper = nsecs(1) << (i + 1);
+                return upper < mmax ? upper : mmax;
+            }
+        }
+        return mmax;
+    }
+}}
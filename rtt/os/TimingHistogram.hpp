@@ -0,0 +1,160 @@
+/***************************************************************************
+  tag: TimingHistogram.hpp
+
+                        TimingHistogram.hpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_OS_TIMING_HISTOGRAM_HPP
+#define ORO_OS_TIMING_HISTOGRAM_HPP
+
+#include "Time.hpp"
+#include "../rtt-config.h"
+
+namespace RTT
+{ namespace os {
+
+    /**
+     * A histogram of durations with a fixed number of logarithmic buckets.
+     * Bucket \a i counts the durations in [2^i, 2^(i+1)) nanoseconds, so
+     * the histogram covers nanoseconds up to minutes without allocating
+     * memory.
+     *
+     * Only one thread may record() durations. Any other thread may read
+     * the statistics at any time, without blocking the recording thread.
+     * A reader may see a sample which is recorded concurrently in one
+     * statistic and not yet in another.
+     * @ingroup CoreLibTime
+     */
+    class RTT_API TimingHistogram
+    {
+    public:
+        /**
+         * The number of buckets.
+         */
+        enum { Buckets = 40 };
+
+        TimingHistogram();
+
+        /**
+         * Records one duration. Does not allocate and does not block.
+         * @param duration The duration in nanoseconds.
+         */
+        void record(nsecs duration)
+        {
+            if ( mreset ) {
+                this->clear();
+                mreset = false;
+            }
+            if ( duration < 0 )
+                duration = 0;
+            if ( mcount == 0 || duration < mmin )
+                mmin = duration;
+            if ( duration > mmax )
+                mmax = duration;
+            msum += duration;
+            ++mbuckets[ bucket(duration) ];
+            ++mcount;
+        }
+
+        /**
+         * Clears all statistics. Readers see an empty histogram from
+         * now on. The recording thread clears the storage before it
+         * records the next duration.
+         */
+        void reset() { mreset = true; }
+
+        /**
+         * The number of durations recorded.
+         */
+        unsigned int count() const { return mreset ? 0 : mcount; }
+
+        /**
+         * The shortest duration recorded, in nanoseconds.
+         */
+        nsecs minimum() const { return (mreset || mcount == 0) ? 0 : mmin; }
+
+        /**
+         * The longest duration recorded, in nanoseconds.
+         */
+        nsecs maximum() const { return mreset ? 0 : mmax; }
+
+        /**
+         * The mean of the durations recorded, in nanoseconds.
+         */
+        double mean() const;
+
+        /**
+         * Returns the duration below which \a p of the durations are found.
+         * The result is the upper bound of the matching bucket, limited to maximum().
+         * @param p The requested fraction, for example 0.99.
+         */
+        nsecs percentile(double p) const;
+
+        /**
+         * The number of durations recorded in bucket \a i.
+         */
+        unsigned int bucketCount(int i) const { return (!mreset && i >= 0 && i < Buckets) ? mbuckets[i] : 0; }
+
+        /**
+         * Returns the bucket in which \a duration is counted.
+         */
+        static int bucket(nsecs duration)
+        {
+            int b = 0;
+            if ( duration >> 32 ) { duration >>= 32; b += 32; }
+            if ( duration >> 16 ) { duration >>= 16; b += 16; }
+            if ( duration >> 8 ) { duration >>= 8; b += 8; }
+            if ( duration >> 4 ) { duration >>= 4; b += 4; }
+            if ( duration >> 2 ) { duration >>= 2; b += 2; }
+            if ( duration >> 1 ) { b += 1; }
+            return b < Buckets ? b : Buckets - 1;
+        }
+
+    private:
+        void clear();
+
+        /**
+         * Set by reset() until the recording thread cleared the storage.
+         * The readers report an empty histogram while it is set.
+         */
+        volatile bool mreset;
+        volatile unsigned int mcount;
+        volatile nsecs mmin;
+        volatile nsecs mmax;
+        volatile nsecs msum;
+        volatile unsigned int mbuckets[Buckets];
+    };
+}}
+
+#endif
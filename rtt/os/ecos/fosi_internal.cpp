@@ -163,6 +163,15 @@ namespace RTT
       }
     }
 
+    INTERNAL_QUAL void rtos_task_set_period_at( RTOS_TASK* mytask, NANO_TIME nanosecs, NANO_TIME mark )
+    {
+      // creates the alarm if needed.
+      rtos_task_set_period(mytask, nanosecs);
+      cyg_alarm_initialize(mytask->alarm_hdl,
+			   nano2ticks(mark),
+			   nano2ticks(nanosecs));
+    }
+
     INTERNAL_QUAL void rtos_task_set_wait_period_policy( RTOS_TASK* task, int policy )
     {
       // Do nothing
@@ -220,6 +229,14 @@ namespace RTT
     return ~0;
     }
 
+	INTERNAL_QUAL int rtos_task_set_profile(RTOS_TASK * task, const ThreadProfile& profile)
+	{
+        // none of these settings is supported on this target.
+        if ( !profile.cpus.empty() || profile.memory_node >= 0 || profile.lock_memory || profile.dl_runtime > 0.0 )
+            return -1;
+        return 0;
+	}
+
 	INTERNAL_QUAL unsigned int rtos_task_get_pid(const RTOS_TASK* task)
 	{
 		return 0;
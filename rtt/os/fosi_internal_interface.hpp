@@ -48,6 +48,7 @@
 #define OS_FOSI_INTERNAL_INTERFACE_HPP
 
 #include "ThreadInterface.hpp"
+#include "ThreadProfile.hpp"
 #include "fosi.h"
 
 namespace RTT {
@@ -163,6 +164,19 @@ namespace RTT {
              */
             void rtos_task_set_period( RTOS_TASK* mytask, NANO_TIME nanosecs );
 
+            /**
+             * Change the period of a periodic RTOS task and the moment of its
+             * next wake-up. Like rtos_task_set_period(), but the next period
+             * ends at \a mark instead of one period from now, such that the
+             * periods can be aligned to the RTOS clock.
+             *
+             * @param mytask The RTOS task to change the period.
+             * @param nanosecs the new period, which must not be zero.
+             * @param mark the time of the next wake-up, as returned
+             * by rtos_get_time_ns().
+             */
+            void rtos_task_set_period_at( RTOS_TASK* mytask, NANO_TIME nanosecs, NANO_TIME mark );
+
             /**
              * Set the wait policy of a thread.
              * @param task The RTOS task to change.
@@ -241,6 +255,17 @@ namespace RTT {
              */
             unsigned rtos_task_get_cpu_affinity(const RTOS_TASK * task);
 
+            /**
+             * Apply the CPU set, memory and deadline scheduling settings
+             * of a profile to a thread. Settings which are left at their
+             * default in \a profile are not changed. The stack is prefaulted
+             * by the Thread itself.
+             * @param task This must be the RTOS_TASK struct of the calling thread.
+             * @param profile The settings to apply.
+             * @return 0 if all settings could be applied, -1 otherwise.
+             */
+            int rtos_task_set_profile(RTOS_TASK * task, const ThreadProfile& profile);
+
             /**
              * Returns the name by which a task is known in the RTOS.
              * @param task The task to query.
@@ -50,6 +50,10 @@
 #include <sys/types.h>
 #include <unistd.h>
 #include <sys/syscall.h>
+#include <sys/mman.h>
+#include <boost/cstdint.hpp>
+#include <vector>
+#include <algorithm>
 
 using namespace std;
 
@@ -259,6 +263,12 @@ namespace RTT
         rtos_task_make_periodic(mytask, nanosecs);
 	}
 
+	INTERNAL_QUAL void rtos_task_set_period_at( RTOS_TASK* mytask, NANO_TIME nanosecs, NANO_TIME mark )
+	{
+	    mytask->period = nanosecs;
+	    mytask->periodMark = ticks2timespec( nano2ticks( mark ) );
+	}
+
   INTERNAL_QUAL void rtos_task_set_wait_period_policy( RTOS_TASK* task, int policy )
   {
     task->wait_policy = policy;
@@ -463,6 +473,74 @@ namespace RTT
         return ~0;
         }
 
+    namespace {
+        // the sched_setattr() argument, which glibc does not declare.
+        struct oro_sched_attr {
+            boost::uint32_t size;
+            boost::uint32_t sched_policy;
+            boost::uint64_t sched_flags;
+            boost::int32_t  sched_nice;
+            boost::uint32_t sched_priority;
+            boost::uint64_t sched_runtime;
+            boost::uint64_t sched_deadline;
+            boost::uint64_t sched_period;
+        };
+        const int ORO_SCHED_DEADLINE = 6;
+        const int ORO_MPOL_BIND = 2;
+    }
+
+	INTERNAL_QUAL int rtos_task_set_profile(RTOS_TASK * task, const ThreadProfile& profile)
+	{
+        int result = 0;
+        if ( !profile.cpus.empty() ) {
+            unsigned int ncpus = *std::max_element(profile.cpus.begin(), profile.cpus.end()) + 1;
+            cpu_set_t* cs = CPU_ALLOC(ncpus);
+            size_t size = CPU_ALLOC_SIZE(ncpus);
+            CPU_ZERO_S(size, cs);
+            for (unsigned int i = 0; i != profile.cpus.size(); ++i)
+                CPU_SET_S(profile.cpus[i], size, cs);
+            if ( pthread_setaffinity_np(pthread_self(), size, cs) != 0 ) {
+                log(Error) << "Failed to set the CPU set of " << task->name << endlog();
+                result = -1;
+            }
+            CPU_FREE(cs);
+        }
+        if ( profile.memory_node >= 0 ) {
+            const unsigned int bits = 8 * sizeof(unsigned long);
+            std::vector<unsigned long> nodes( profile.memory_node / bits + 1, 0 );
+            nodes[ profile.memory_node / bits ] = 1UL << (profile.memory_node % bits);
+            if ( syscall(SYS_set_mempolicy, ORO_MPOL_BIND, &nodes[0], nodes.size() * bits + 1) != 0 ) {
+                log(Error) << "Failed to bind " << task->name << " to memory node " << profile.memory_node
+                           << ": " << strerror(errno) << endlog();
+                result = -1;
+            }
+        }
+        if ( profile.lock_memory && mlockall(MCL_CURRENT | MCL_FUTURE) != 0 ) {
+            log(Error) << "Failed to lock memory for " << task->name << ": " << strerror(errno) << endlog();
+            result = -1;
+        }
+        if ( profile.dl_runtime > 0.0 ) {
+            oro_sched_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.sched_policy = ORO_SCHED_DEADLINE;
+            attr.sched_runtime  = Seconds_to_nsecs(profile.dl_runtime);
+            attr.sched_deadline = Seconds_to_nsecs(profile.dl_deadline > 0.0 ? profile.dl_deadline : profile.dl_period);
+            attr.sched_period   = Seconds_to_nsecs(profile.dl_period > 0.0 ? profile.dl_period : profile.dl_deadline);
+            long ret = -1;
+#ifdef SYS_sched_setattr
+            ret = syscall(SYS_sched_setattr, 0, &attr, 0);
+#else
+            errno = ENOSYS;
+#endif
+            if ( ret != 0 ) {
+                log(Error) << "Failed to run " << task->name << " in the deadline scheduler: " << strerror(errno) << endlog();
+                result = -1;
+            }
+        }
+        return result;
+	}
+
 	INTERNAL_QUAL const char * rtos_task_get_name(const RTOS_TASK* task)
 	{
         return task->name ? task->name : "(destroyed)";
@@ -321,6 +321,13 @@ namespace RTT
                 rt_set_period(mytask->rtaitask, nano2count( nanosecs ));
         }
 
+        INTERNAL_QUAL void rtos_task_set_period_at( RTOS_TASK* mytask, NANO_TIME nanosecs, NANO_TIME mark )
+        {
+            if (mytask->rtaitask == 0)
+                return;
+            rt_task_make_periodic(mytask->rtaitask, nano2count( mark ), nano2count( nanosecs ));
+        }
+
         INTERNAL_QUAL void rtos_task_set_wait_period_policy( RTOS_TASK* task, int policy )
         {
           // Do nothing
@@ -401,6 +408,14 @@ namespace RTT
 	{
         return ~0;
         }
+
+	INTERNAL_QUAL int rtos_task_set_profile(RTOS_TASK * task, const ThreadProfile& profile)
+	{
+        // memory is locked by rtos_task_create_main(), the other settings are not supported.
+        if ( !profile.cpus.empty() || profile.memory_node >= 0 || profile.dl_runtime > 0.0 )
+            return -1;
+        return 0;
+	}
     }
 }
 #undef INTERNAL_QUAL
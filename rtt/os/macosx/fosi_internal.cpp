@@ -166,6 +166,12 @@ namespace RTT
 	    mytask->periodMark = rtos_get_time_ns() + nanosecs;
 	}
 
+	INTERNAL_QUAL void rtos_task_set_period_at( RTOS_TASK* mytask, NANO_TIME nanosecs, NANO_TIME mark )
+	{
+	    mytask->period = nanosecs;
+	    mytask->periodMark = mark;
+	}
+
   INTERNAL_QUAL void rtos_task_set_wait_period_policy( RTOS_TASK* task, int policy )
   {
     task->wait_policy = policy;
@@ -281,6 +287,14 @@ namespace RTT
         return ~0;
         }
 
+	INTERNAL_QUAL int rtos_task_set_profile(RTOS_TASK * task, const ThreadProfile& profile)
+	{
+        // none of these settings is supported on this target.
+        if ( !profile.cpus.empty() || profile.memory_node >= 0 || profile.lock_memory || profile.dl_runtime > 0.0 )
+            return -1;
+        return 0;
+	}
+
 	INTERNAL_QUAL const char * rtos_task_get_name(const RTOS_TASK* task)
 	{
         return task->name ? task->name : "(destroyed)";
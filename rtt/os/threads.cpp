@@ -39,6 +39,10 @@
 #include "os/threads.hpp"
 #include "os/fosi_internal_interface.hpp"
 
+#ifndef WIN32
+#include <unistd.h>
+#endif
+
 namespace RTT
 { namespace os {
     AtomicInt threads(0);
@@ -53,4 +57,14 @@ namespace RTT
         return rtos_task_check_priority(&sched_type, &priority) == 0;
     }
 
+    unsigned int OnlineProcessors()
+    {
+#ifdef _SC_NPROCESSORS_ONLN
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+        if (n > 0)
+            return n;
+#endif
+        return 1;
+    }
+
 }}
@@ -89,5 +89,11 @@ namespace RTT
      */ 
     bool RTT_API CheckPriority(int& sched_type, int& priority);
 
+    /**
+     * Returns the number of processors that are online, or
+     * one if the OS can not tell.
+     */
+    unsigned int RTT_API OnlineProcessors();
+
 }}
 #endif
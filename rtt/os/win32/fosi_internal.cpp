@@ -227,6 +227,12 @@ void ErrorHandler(LPTSTR lpszFunction)
       mytask->periodMark = rtos_get_time_ns() + nanosecs;
     }
 
+    INTERNAL_QUAL void rtos_task_set_period_at( RTOS_TASK* mytask, NANO_TIME nanosecs, NANO_TIME mark )
+    {
+      mytask->period = nanosecs;
+      mytask->periodMark = mark;
+    }
+
     INTERNAL_QUAL NANO_TIME rtos_task_get_period(const RTOS_TASK* t) {
       return t->period;
     }
@@ -341,6 +347,14 @@ void ErrorHandler(LPTSTR lpszFunction)
     return ~0;
     }
 
+	INTERNAL_QUAL int rtos_task_set_profile(RTOS_TASK * task, const ThreadProfile& profile)
+	{
+        // none of these settings is supported on this target.
+        if ( !profile.cpus.empty() || profile.memory_node >= 0 || profile.lock_memory || profile.dl_runtime > 0.0 )
+            return -1;
+        return 0;
+	}
+
     INTERNAL_QUAL const char * rtos_task_get_name(const RTOS_TASK* t)
     {
     	/* printf("Get Name: ");
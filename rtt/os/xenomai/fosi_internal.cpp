@@ -389,6 +389,11 @@ namespace RTT
             //rt_task_set_period(&(mytask->xenotask), rt_timer_ns2ticks( nanosecs ));
         }
 
+        INTERNAL_QUAL void rtos_task_set_period_at( RTOS_TASK* mytask, NANO_TIME nanosecs, NANO_TIME mark )
+        {
+            rt_task_set_periodic( &(mytask->xenotask), rt_timer_ns2ticks(mark), rt_timer_ns2ticks(nanosecs) );
+        }
+
         INTERNAL_QUAL void rtos_task_set_wait_period_policy( RTOS_TASK* task, int policy )
         {
           // Do nothing
@@ -427,6 +432,14 @@ namespace RTT
             return ~0;
         }
 
+	INTERNAL_QUAL int rtos_task_set_profile(RTOS_TASK * task, const ThreadProfile& profile)
+	{
+        // memory is locked by rtos_task_create_main(), the other settings are not supported.
+        if ( !profile.cpus.empty() || profile.memory_node >= 0 || profile.dl_runtime > 0.0 )
+            return -1;
+        return 0;
+	}
+
         INTERNAL_QUAL const char* rtos_task_get_name(const RTOS_TASK* mytask) {
             return mytask->name ? mytask->name : "(destroyed)";
         }
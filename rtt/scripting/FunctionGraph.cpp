@@ -89,6 +89,8 @@ namespace RTT {
         if (orig.retn)
             retn = orig.retn->clone();
         this->finish();
+        if ( orig.isCompiled() )
+            this->compile();
     }
 
     void FunctionGraph::finish()
@@ -108,9 +110,46 @@ namespace RTT {
         graph_traits<Graph>::vertices_size_type cnt = 0;
         for(tie(vi,vend) = vertices(program); vi != vend; ++vi)
             put(index, *vi, cnt++);
+        if ( this->isCompiled() )
+            this->compile();
         this->reset();
     }
 
+    bool FunctionGraph::compile()
+    {
+        graph_traits<Graph>::vertex_iterator vi, vend;
+        graph_traits<Graph>::out_edge_iterator ei, ei_end;
+        boost::property_map<Graph, vertex_index_t>::type
+            index = get(vertex_index, program);
+        boost::property_map<Graph, vertex_command_t>::type
+            cmap = get(vertex_command, program);
+        boost::property_map<Graph, edge_condition_t>::type
+            emap = get(edge_condition, program);
+
+        mcode.resize( num_vertices(program) );
+        mbranches.clear();
+        for(tie(vi,vend) = vertices(program); vi != vend; ++vi) {
+            // finish() numbered the vertices, which gives the instruction order.
+            Instruction& in = mcode[ get(index, *vi) ];
+            ActionInterface* action = cmap[*vi].getCommand();
+            in.action = dynamic_cast<CommandNOP*>( action ) ? 0 : action;
+            in.vertex = *vi;
+            in.branches = mbranches.size();
+            for ( tie(ei, ei_end) = boost::out_edges( *vi, program ); ei != ei_end; ++ei) {
+                Branch br;
+                ConditionInterface* cond = emap[*ei].getCondition();
+                br.condition = dynamic_cast<ConditionTrue*>( cond ) ? 0 : cond;
+                br.target = get(index, boost::target(*ei, program));
+                mbranches.push_back( br );
+                // the edges after an unconditional one are never taken.
+                if ( br.condition == 0 )
+                    break;
+            }
+            in.branches_end = mbranches.size();
+        }
+        return true;
+    }
+
     FunctionGraph::~FunctionGraph()
     {
         //log(Debug) << "Destroying program '" << getName() << "'" <<endlog();
@@ -205,6 +244,8 @@ namespace RTT {
         }
         switch (pStatus) {
         case Status::running:
+            if ( this->isCompiled() )
+                return this->executeCode();
             return this->executeUntil();
             break;
         case Status::paused:
@@ -287,6 +328,56 @@ namespace RTT {
         return true; // we need to wait.
     }
 
+    bool FunctionGraph::executeCode()
+    {
+        boost::property_map<Graph, vertex_index_t>::type
+            index = get(vertex_index, program);
+        unsigned int pc = get(index, current);
+        unsigned int prev = get(index, previous);
+
+        try {
+            do {
+                const Instruction& in = mcode[pc];
+                // same logic as executeUntil(), on instruction indexes.
+                if ( prev != pc ) {
+                    for (unsigned int b = in.branches; b != in.branches_end; ++b)
+                        if ( mbranches[b].condition )
+                            mbranches[b].condition->reset();
+                    if ( in.action ) {
+                        in.action->reset();
+                        in.action->readArguments();
+                    }
+                }
+
+                prev = pc;
+                if ( in.action )
+                    in.action->execute();
+
+                if ( in.action == 0 || in.action->valid() ) {
+                    for (unsigned int b = in.branches; b != in.branches_end; ++b)
+                        if ( mbranches[b].condition == 0 || mbranches[b].condition->evaluate() ) {
+                            pc = mbranches[b].target;
+                            break;
+                        }
+                }
+            } while ( prev != pc && pStatus == Status::running && !pausing);
+        } catch(...) {
+            current = mcode[pc].vertex;
+            previous = mcode[prev].vertex;
+            pStatus = Status::error;
+            return false;
+        }
+        current = mcode[pc].vertex;
+        previous = mcode[prev].vertex;
+
+        // check finished state
+        if (current == exitv) {
+            this->stop();
+            return !munload_on_stop;
+        }
+        return true; // we need to wait.
+    }
+
     bool FunctionGraph::executeStep()
     {
         graph_traits<Graph>::out_edge_iterator ei, ei_end;
@@ -422,6 +513,8 @@ namespace RTT {
 
         // so that ret itself can be copied again :
         ret->finish();
+        if ( this->isCompiled() )
+            ret->compile();
 
 //         std::cerr << "Resulted in :" <<std::endl;
 //         ret->debugPrintout();
@@ -82,6 +82,51 @@ namespace RTT
          */
         Vertex previous;
 
+        /**
+         * One vertex of the compiled program. Instruction \a i is
+         * the vertex with vertex_index \a i, see finish().
+         */
+        struct Instruction
+        {
+            /**
+             * The action of the vertex, or null for a CommandNOP.
+             */
+            base::ActionInterface* action;
+            /**
+             * The out edges of this vertex are the Branches
+             * [branches, branches_end) of mbranches.
+             */
+            unsigned int branches;
+            unsigned int branches_end;
+            Vertex vertex;
+        };
+
+        /**
+         * One out edge of the compiled program.
+         */
+        struct Branch
+        {
+            /**
+             * The condition of the edge, or null for a ConditionTrue.
+             */
+            ConditionInterface* condition;
+            /**
+             * The index of the target Instruction.
+             */
+            unsigned int target;
+        };
+
+        /**
+         * The compiled program, empty if not compiled.
+         */
+        std::vector<Instruction> mcode;
+        std::vector<Branch> mbranches;
+
+        /**
+         * executeUntil() for a compiled program.
+         */
+        bool executeCode();
+
     protected:
         /**
          * The graph containing this function.
@@ -157,9 +202,28 @@ namespace RTT
 
         /**
          * To be called after a function is constructed.
+         * Recompiles the function if it was compiled.
          */
         void finish();
 
+        /**
+         * Flatten the graph into an array of instructions, which are
+         * executed without looking up the vertex and edge properties and
+         * without executing CommandNOP actions and ConditionTrue conditions.
+         * The graph remains available for stepping, copying and inspection.
+         * Call finish() or compile() again when the graph is modified
+         * afterwards.
+         * @return true
+         * @nrt
+         */
+        virtual bool compile();
+
+        /**
+         * Returns true if compile() was called on this function
+         * or on the function this one was copied from.
+         */
+        bool isCompiled() const { return !mcode.empty(); }
+
         virtual bool start();
 
         virtual bool execute();
@@ -48,4 +48,9 @@ namespace RTT {
     ProgramInterface::~ProgramInterface()
     {}
 
+    bool ProgramInterface::compile()
+    {
+        return false;
+    }
+
 }
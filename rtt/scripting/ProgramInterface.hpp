@@ -196,6 +196,14 @@ namespace RTT
          */
         virtual bool needsStart() const = 0;
 
+        /**
+         * Translate this program into a form which is cheaper to execute.
+         * The default implementation does nothing.
+         * @return true if this program is executed in compiled form from now on.
+         * @nrt
+         */
+        virtual bool compile();
+
 	};
 
 
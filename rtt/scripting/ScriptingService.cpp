@@ -79,6 +79,10 @@ namespace RTT {
 			.doc("If this is set to false, the warning log when loading a program or a state machine into a Component"
 					" with a null period will not be printed. Be sure you have something else triggering periodically"
 					" your Component activity unless your script may not work.");
+        CompileScripts = false;
+        this->addProperty("CompileScripts",CompileScripts)
+            .doc("If this is set to true, programs and state machines are compiled into a flat instruction array"
+                    " when they are loaded, which lowers the cost of executing them.");
     }
 
     ScriptingService::~ScriptingService()
@@ -233,6 +237,8 @@ namespace RTT {
 
         // first load parent.
         states[sc->getName()] = sc;
+        if ( CompileScripts )
+            sc->compile();
         mowner->engine()->runFunction( sc.get() );
 
         // then load children.
@@ -371,6 +377,8 @@ namespace RTT {
 			   << endlog();
        }
        programs[pi->getName()] = pi;
+       if ( CompileScripts )
+           pi->compile();
        pi->reset();
        if ( mowner->engine()->runFunction( pi.get() ) == false) {
            programs.erase(pi->getName());
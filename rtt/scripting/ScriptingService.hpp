@@ -582,6 +582,13 @@ namespace RTT
          */
         bool ZeroPeriodWarning;
 
+        /** This is a property of the Scripting service
+         * It is false by default
+         * If this is set to true, programs and state machines are compiled
+         * when they are loaded, see ProgramInterface::compile().
+         */
+        bool CompileScripts;
+
     };
 }}
 
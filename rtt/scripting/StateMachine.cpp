@@ -758,6 +758,30 @@ namespace RTT {
         return result;
     }
 
+    void StateMachine::compile()
+    {
+        for ( TransitionMap::iterator it = stateMap.begin(); it != stateMap.end(); ++it ) {
+            // the null state holds the global transitions.
+            if ( it->first ) {
+                ProgramInterface* progs[] = { it->first->getEntryProgram(), it->first->getRunProgram(),
+                                              it->first->getHandleProgram(), it->first->getExitProgram() };
+                for (unsigned int i = 0; i != sizeof(progs)/sizeof(progs[0]); ++i)
+                    if ( progs[i] )
+                        progs[i]->compile();
+            }
+            for ( TransList::iterator tit = it->second.begin(); tit != it->second.end(); ++tit )
+                if ( get<4>(*tit) )
+                    get<4>(*tit)->compile();
+        }
+        for ( EventMap::iterator it = eventMap.begin(); it != eventMap.end(); ++it )
+            for ( EventList::iterator eit = it->second.begin(); eit != it->second.end(); ++eit ) {
+                if ( get<5>(*eit) )
+                    get<5>(*eit)->compile();
+                if ( get<8>(*eit) )
+                    get<8>(*eit)->compile();
+            }
+    }
+
     void StateMachine::addState( StateInterface* s )
     {
         stateMap[s];
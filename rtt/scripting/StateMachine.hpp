@@ -345,6 +345,14 @@ namespace RTT
          */
         std::vector<std::string> getStateList() const;
 
+        /**
+         * Compile the entry, run, handle and exit programs of all states
+         * and all transition programs of this StateMachine, see
+         * ProgramInterface::compile(). The child StateMachines are not compiled.
+         * @nrt
+         */
+        void compile();
+
         /**
          * Lookup a State by name. Returns null if not found.
          */
@@ -37,10 +37,17 @@
 
 
 #include "Dispatcher.hpp"
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <sstream>
+#include <boost/cstdint.hpp>
 
 namespace RTT {
     namespace mqueue {
         Dispatcher* Dispatcher::DispatchI = 0;
+        unsigned int Dispatcher::ShardCount = 1;
 
         void intrusive_ptr_add_ref(const RTT::mqueue::Dispatcher* p ) {
             p->refcount.inc();
@@ -48,6 +55,193 @@ namespace RTT {
         void intrusive_ptr_release(const RTT::mqueue::Dispatcher* p ) {
             if ( p->refcount.dec_and_test() ) delete p;
         }
+
+        /**
+         * Serves the queues of one shard, other than the first,
+         * in a thread of its own.
+         */
+        class Dispatcher::ShardRunner : public Activity
+        {
+            Dispatcher* mdispatcher;
+            Shard& mshard;
+        public:
+            ShardRunner(Dispatcher* dispatcher, Shard& shard, const std::string& name)
+                : Activity(ORO_SCHED_RT, os::HighestPriority, 0.0, 0, name),
+                  mdispatcher(dispatcher), mshard(shard)
+            {}
+
+            ~ShardRunner() {
+                stop();
+            }
+
+            void loop() {
+                mdispatcher->serve(mshard);
+            }
+
+            bool breakLoop() {
+                return mdispatcher->breakLoop();
+            }
+        };
+
+        Dispatcher::Dispatcher( const std::string& name)
+        : Activity(ORO_SCHED_RT, os::HighestPriority, 0.0, 0, name),
+          exitfd( eventfd(0, EFD_NONBLOCK) ), do_exit(false)
+        {
+            for (unsigned int i = 0; i != ShardCount; ++i) {
+                Shard* shard = new Shard();
+                shard->epfd = epoll_create1(0);
+                if (shard->epfd == -1 || exitfd == -1)
+                    log(Error) << "Dispatcher failed to create epoll set: " << strerror(errno) << endlog();
+                // exitfd is never read while do_exit is set, such that it wakes up every shard.
+                epoll_event ev = epoll_event();
+                ev.events = EPOLLIN;
+                ev.data.fd = exitfd;
+                epoll_ctl(shard->epfd, EPOLL_CTL_ADD, exitfd, &ev);
+                mshards.push_back(shard);
+                if (i != 0) {
+                    std::stringstream rname;
+                    rname << name << i;
+                    mrunners.push_back( new ShardRunner(this, *shard, rname.str()) );
+                }
+            }
+        }
+
+        Dispatcher::~Dispatcher() {
+            Logger::In in("Dispatcher");
+            log(Info) << "Dispacher cleans up: no more work."<<endlog();
+            stop();
+            for (unsigned int i = 0; i != mrunners.size(); ++i)
+                delete mrunners[i];
+            for (unsigned int i = 0; i != mshards.size(); ++i) {
+                close(mshards[i]->epfd);
+                delete mshards[i];
+            }
+            close(exitfd);
+            DispatchI = 0;
+        }
+
+        Dispatcher::shared_ptr Dispatcher::Instance() {
+            if ( DispatchI == 0) {
+                DispatchI = new Dispatcher("MQueueDispatch");
+                DispatchI->start();
+            }
+            return DispatchI;
+        }
+
+        bool Dispatcher::setShardCount(unsigned int shards) {
+            if ( DispatchI != 0 || shards == 0 )
+                return false;
+            ShardCount = shards;
+            return true;
+        }
+
+        unsigned int Dispatcher::getShardCount() {
+            return ShardCount;
+        }
+
+        Dispatcher::Shard& Dispatcher::shardOf(mqd_t mqdes) {
+            return *mshards[ (unsigned int)(mqdes) % mshards.size() ];
+        }
+
+        void Dispatcher::addQueue( mqd_t mqdes, base::ChannelElementBase* chan ) {
+            Logger::In in("Dispatcher");
+            if (mqdes < 0) {
+                log(Error) <<"Invalid mqd_t given to MQueue Dispatcher." <<endlog();
+                return;
+            }
+            log(Debug) <<"Dispatcher is monitoring mqdes "<< mqdes <<endlog();
+            // serve() drains the queue until mq_receive() fails.
+            mq_attr attr;
+            mq_getattr(mqdes, &attr);
+            attr.mq_flags |= O_NONBLOCK;
+            mq_setattr(mqdes, &attr, 0);
+
+            Shard& shard = shardOf(mqdes);
+            os::MutexLock lock(shard.maplock);
+            // we add a refcount per channel we monitor.
+            if (shard.mqmap.count(mqdes) == 0) {
+                refcount.inc();
+                epoll_event ev = epoll_event();
+                ev.events = EPOLLIN;
+                ev.data.fd = mqdes;
+                if ( epoll_ctl(shard.epfd, EPOLL_CTL_ADD, mqdes, &ev) == -1 )
+                    log(Error) <<"Dispatcher failed to monitor mqdes "<< mqdes << ": " << strerror(errno) <<endlog();
+            }
+            Queue& q = shard.mqmap[mqdes];
+            q.chan = chan;
+            q.maxmsg = attr.mq_maxmsg > 0 ? attr.mq_maxmsg : 1;
+        }
+
+        void Dispatcher::removeQueue(mqd_t mqdes) {
+            Logger::In in("Dispatcher");
+            log(Debug) <<"Dispatcher drops mqdes "<< mqdes <<endlog();
+            Shard& shard = shardOf(mqdes);
+            os::MutexLock lock(shard.maplock);
+            if (shard.mqmap.count(mqdes)) {
+                epoll_ctl(shard.epfd, EPOLL_CTL_DEL, mqdes, 0);
+                shard.mqmap.erase( shard.mqmap.find(mqdes) );
+                refcount.dec();
+            }
+        }
+
+        bool Dispatcher::initialize() {
+            // drop a wakeup of a previous breakLoop()
+            boost::uint64_t count;
+            ssize_t unused = read(exitfd, &count, sizeof(count)); (void)unused;
+            do_exit = false;
+            for (unsigned int i = 0; i != mrunners.size(); ++i)
+                mrunners[i]->start();
+            return true;
+        }
+
+        void Dispatcher::serve(Shard& shard) {
+            std::vector<epoll_event> events;
+            while (1) { /* epoll loop */
+                {
+                    // room for all queues and exitfd, this only allocates
+                    // after queues were added.
+                    os::MutexLock lock(shard.maplock);
+                    if ( events.size() < shard.mqmap.size() + 1 )
+                        events.resize( shard.mqmap.size() + 1 );
+                }
+                int readsocks = epoll_wait(shard.epfd, &events[0], events.size(), -1);
+                if (readsocks < 0 && errno != EINTR) {
+                    log(Error) <<"Dispatcher failed to wait on message queues. Stopped thread. error: "<<strerror(errno)<<endlog();
+                    return;
+                }
+
+                if ( do_exit )
+                    return;
+
+                os::MutexLock lock(shard.maplock);
+                for (int i = 0; i < readsocks; ++i) {
+                    // a queue removed in the mean time is no longer in the map.
+                    MQMap::iterator it = shard.mqmap.find( mqd_t(events[i].data.fd) );
+                    if ( it == shard.mqmap.end() )
+                        continue;
+                    // drain the queue, but leave the other queues a chance
+                    // if the sender keeps up with us.
+                    for (long n = 0; n != it->second.maxmsg; ++n)
+                        if ( !it->second.chan->signal() )
+                            break;
+                }
+            } /* while(1) */
+        }
+
+        void Dispatcher::loop() {
+            serve( *mshards[0] );
+        }
+
+        bool Dispatcher::breakLoop() {
+            do_exit = true;
+            boost::uint64_t one = 1;
+            ssize_t unused = write(exitfd, &one, sizeof(one)); (void)unused;
+            return true;
+        }
+
+        void Dispatcher::finalize() {
+            for (unsigned int i = 0; i != mrunners.size(); ++i)
+                mrunners[i]->stop();
+        }
     }
 }
-
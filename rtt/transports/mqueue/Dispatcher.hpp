@@ -42,7 +42,8 @@
 #include "../../base/ChannelElementBase.hpp"
 #include "../../Logger.hpp"
 #include <map>
-#include <sys/select.h>
+#include <vector>
+#include <sys/epoll.h>
 #include <mqueue.h>
 
 namespace RTT { namespace mqueue { class Dispatcher; } }
@@ -58,6 +59,12 @@ namespace RTT {
          * received new data.
          * Reasonably, there should be one dispatcher for each
          * peer component sending us data.
+         *
+         * The message queues are registered once in an epoll set, such
+         * that a wakeup only costs in the number of ready queues. A ready
+         * queue is drained completely before waiting again. The queues can
+         * be sharded over several threads with setShardCount(), each thread
+         * waiting on its own epoll set.
          */
         class Dispatcher : public Activity
         {
@@ -65,154 +72,74 @@ namespace RTT {
             friend void intrusive_ptr_release(const RTT::mqueue::Dispatcher* p );
             mutable os::AtomicInt refcount;
             static Dispatcher* DispatchI;
+            static unsigned int ShardCount;
 
-            typedef std::map<mqd_t,base::ChannelElementBase*> MQMap;
-            MQMap mqmap;
+            struct Queue {
+                base::ChannelElementBase* chan;
+                long maxmsg; /* Most messages drained from this queue per wakeup */
+            };
+            typedef std::map<mqd_t,Queue> MQMap;
 
-            fd_set socks;        /* Socket file descriptors we want to wake up for, using select() */
+            /**
+             * The queues of one dispatcher thread and the epoll set
+             * they are registered in.
+             */
+            struct Shard {
+                int epfd;
+                MQMap mqmap;
+                os::Mutex maplock;
+            };
+            class ShardRunner;
 
-            int highsock;        /* Highest #'d file descriptor, needed for select() */
+            std::vector<Shard*> mshards;
+            std::vector<ShardRunner*> mrunners;
 
-            bool do_exit;
+            int exitfd;          /* eventfd which wakes up all shards when do_exit is set */
 
-            os::Mutex maplock;
+            volatile bool do_exit;
 
-            Dispatcher( const std::string& name)
-            : Activity(ORO_SCHED_RT, os::HighestPriority, 0.0, 0, name),
-              highsock(0), do_exit(false)
-              {}
+            Dispatcher( const std::string& name);
 
-            ~Dispatcher() {
-                Logger::In in("Dispatcher");
-                log(Info) << "Dispacher cleans up: no more work."<<endlog();
-                stop();
-                DispatchI = 0;
-            }
+            ~Dispatcher();
 
-            void build_select_list() {
+            Shard& shardOf(mqd_t mqdes);
 
-                /* First put together fd_set for select(), which will
-                   consist of the sock veriable in case a new connection
-                   is coming in, plus all the sockets we have already
-                   accepted. */
+            void serve(Shard& shard);
 
+        public:
+            typedef boost::intrusive_ptr<Dispatcher> shared_ptr;
 
-                /* FD_ZERO() clears out the fd_set called socks, so that
-                    it doesn't contain any file descriptors. */
+            static Dispatcher::shared_ptr Instance();
 
-                FD_ZERO(&socks);
-                highsock = 0;
+            /**
+             * Sets the number of threads the message queues are
+             * distributed over. Each queue is served by one thread only.
+             * @param shards The number of threads, at least one.
+             * @return false if the dispatcher already exists, in which case
+             * the number of threads is not changed.
+             */
+            static bool setShardCount(unsigned int shards);
 
-                /* Loops through all the possible connections and adds
-                    those sockets to the fd_set */
-                os::MutexLock lock(maplock);
-                for (MQMap::const_iterator it = mqmap.begin(); it != mqmap.end(); ++it) {
-                    FD_SET( it->first, &socks);
-                    if ( int(it->first) > highsock)
-                        highsock = int(it->first);
-                }
-            }
+            /**
+             * Returns the number of threads the dispatcher uses.
+             */
+            static unsigned int getShardCount();
 
-            void read_socks() {
-                /* OK, now socks will be set with whatever socket(s)
-                   are ready for reading.*/
+            /**
+             * Starts monitoring \a mqdes and signals \a chan for each
+             * message in it. \a mqdes is put in non-blocking mode.
+             */
+            void addQueue( mqd_t mqdes, base::ChannelElementBase* chan );
 
-                /* Run through our sockets and check to see if anything
-                    happened with them, if so 'service' them. */
-                os::MutexLock lock(maplock);
-                for (MQMap::iterator it = mqmap.begin(); it != mqmap.end(); ++it) {
-                    if ( FD_ISSET( it->first, &socks) ) {
-                        //log(Debug) << "New data on " << it->first <<endlog();
-                        it->second->signal();
-                    }
-                }
-            }
+            void removeQueue(mqd_t mqdes);
 
-        public:
-            typedef boost::intrusive_ptr<Dispatcher> shared_ptr;
+            bool initialize();
 
-            static Dispatcher::shared_ptr Instance() {
-                if ( DispatchI == 0) {
-                    DispatchI = new Dispatcher("MQueueDispatch");
-                    DispatchI->start();
-                }
-                return DispatchI;
-            }
-
-            void addQueue( mqd_t mqdes, base::ChannelElementBase* chan ) {
-                Logger::In in("Dispatcher");
-                if (mqdes < 0) {
-                    log(Error) <<"Invalid mqd_t given to MQueue Dispatcher." <<endlog();
-                    return;
-                }
-                log(Debug) <<"Dispatcher is monitoring mqdes "<< mqdes <<endlog();
-                os::MutexLock lock(maplock);
-                // we add a refcount per channel we monitor.
-                if (mqmap.count(mqdes) == 0)
-                    refcount.inc();
-                mqmap[mqdes] = chan;
-            }
-
-            void removeQueue(mqd_t mqdes) {
-                Logger::In in("Dispatcher");
-                log(Debug) <<"Dispatcher drops mqdes "<< mqdes <<endlog();
-                os::MutexLock lock(maplock);
-                if (mqmap.count(mqdes)) {
-                    mqmap.erase( mqmap.find(mqdes) );
-                    refcount.dec();
-                }
-            }
-
-            bool initialize() {
-                do_exit = false;
-                return true;
-            }
-
-            void loop() {
-                struct timeval timeout;  /* Timeout for select */
-                int readsocks;       /* Number of sockets ready for reading */
-                while (1) { /* select loop */
-                    build_select_list();
-                    timeout.tv_sec = 0;
-                    timeout.tv_usec = 50000;
-
-                    /* The first argument to select is the highest file
-                        descriptor value plus 1.*/
-
-                    readsocks = select(highsock+1, &socks, (fd_set *) 0,
-                      (fd_set *) 0, &timeout);
-
-                    /* select() returns the number of sockets that had
-                        things going on with them -- i.e. they're readable. */
-
-                    /* Once select() returns, the original fd_set has been
-                        modified so it now reflects the state of why select()
-                        woke up. i.e. If file descriptor 4 was originally in
-                        the fd_set, and then it became readable, the fd_set
-                        contains file descriptor 4 in it. */
-
-                    if (readsocks < 0) {
-                        if (errno != EINTR)
-                        {
-                            log(Error) <<"Dispatcher failed to select on message queues. Stopped thread. error: "<<strerror(errno)<<endlog();
-                            return;
-                        }
-                    }
-                    else if (readsocks == 0) {
-                        // nop
-                    } else // readsocks > 0
-                        read_socks();
-
-                    if ( do_exit )
-                        return;
-                } /* while(1) */
-            }
-
-            bool breakLoop() {
-                do_exit = true;
-                return true;
-            }
+            void loop();
+
+            bool breakLoop();
+
+            void finalize();
         };
     }
 }
-
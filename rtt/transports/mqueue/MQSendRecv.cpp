@@ -100,7 +100,9 @@ void MQSendRecv::setupStream(base::DataSourceBase::shared_ptr ds, base::PortInte
     if (mis_sender)
         oflag |= O_WRONLY | O_NONBLOCK;
     else
-        oflag |= O_RDONLY; //reading is always blocking (see mqReady() )
+        // blocking for the initial mq_timedreceive() in mqReady(). Dispatcher::addQueue()
+        // then sets O_NONBLOCK, which serve() relies on to drain the queue.
+        oflag |= O_RDONLY;
     mqdes = mq_open(policy.name_id.c_str(), oflag, S_IREAD | S_IWRITE, &mattr);
 
     if (mqdes < 0)
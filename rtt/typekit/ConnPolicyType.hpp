@@ -40,6 +40,7 @@
 #define ORO_CONNPOLICYTYPE_HPP_
 
 #include <boost/serialization/serialization.hpp>
+#include <boost/serialization/version.hpp>
 #include "../ConnPolicy.hpp"
 
 namespace boost {
@@ -50,7 +51,7 @@ namespace boost {
          * @param c A ConnPolicy that will be read or written.
          */
         template<class Archive>
-        void serialize(Archive& a, RTT::ConnPolicy& c, unsigned int) {
+        void serialize(Archive& a, RTT::ConnPolicy& c, unsigned int version) {
             a & boost::serialization::make_nvp("type", c.type);
             a & boost::serialization::make_nvp("init", c.init );
             a & boost::serialization::make_nvp("lock_policy", c.lock_policy );
@@ -59,9 +60,15 @@ namespace boost {
             a & boost::serialization::make_nvp("transport", c.transport );
             a & boost::serialization::make_nvp("data_size", c.data_size );
             a & boost::serialization::make_nvp("name_id", c.name_id );
+            if ( version > 0 ) {
+                a & boost::serialization::make_nvp("max_readers", c.max_readers );
+                a & boost::serialization::make_nvp("seqlock", c.seqlock );
+            }
         }
     }
 }
 
+BOOST_CLASS_VERSION(RTT::ConnPolicy, 1)
+
 
 #endif /* ORO_CONNPOLICYTYPE_HPP_ */
@@ -0,0 +1,267 @@
+/***************************************************************************
+  tag: bench.hpp
+
+                        bench.hpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/**
+ * @file bench.hpp
+ * The scaffold which the benchmarks share: the command line options, a
+ * sleep which does not depend on a running activity, and the printing of
+ * one CSV or JSON record per measured configuration. A benchmark only
+ * registers its own options and measures.
+ */
+
+#ifndef ORO_TESTS_BENCH_HPP
+#define ORO_TESTS_BENCH_HPP
+
+#include <os/TimeService.hpp>
+#include <os/fosi.h>
+
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+
+namespace bench {
+
+    inline void sleep_nsecs(RTT::os::TimeService::nsecs ns)
+    {
+        TIME_SPEC ts;
+        ts.tv_sec = ns / 1000000000LL;
+        ts.tv_nsec = ns % 1000000000LL;
+        rtos_nanosleep(&ts, 0);
+    }
+
+    /**
+     * Returns \a s as a quoted JSON string.
+     */
+    inline std::string quoted(const std::string& s)
+    {
+        std::stringstream result;
+        result << '"';
+        for (std::string::const_iterator it = s.begin(); it != s.end(); ++it) {
+            if ( *it == '"' || *it == '\\' )
+                result << '\\' << *it;
+            else if ( *it == '\n' )
+                result << "\\n";
+            else if ( (unsigned char)(*it) < 0x20 )
+                result << "\\u00" << std::hex << std::setw(2) << std::setfill('0') << int(*it) << std::dec;
+            else
+                result << *it;
+        }
+        result << '"';
+        return result.str();
+    }
+
+    /**
+     * The results of one configuration, as named fields in the order
+     * in which they are printed.
+     */
+    class Record
+    {
+        friend class Printer;
+        std::vector<std::string> names;
+        std::vector<std::string> values;
+        std::vector<bool> strings;
+
+    public:
+        Record& add(const std::string& name, const std::string& value)
+        {
+            names.push_back(name);
+            values.push_back(value);
+            strings.push_back(true);
+            return *this;
+        }
+
+        Record& add(const std::string& name, const char* value)
+        {
+            return add(name, std::string(value));
+        }
+
+        template<class T>
+        Record& add(const std::string& name, T value)
+        {
+            std::stringstream s;
+            s << value;
+            names.push_back(name);
+            values.push_back(s.str());
+            strings.push_back(false);
+            return *this;
+        }
+    };
+
+    /**
+     * Prints records to std::cout, as CSV with a header line taken from
+     * the first record, or as one JSON array which is closed when the
+     * Printer is destroyed.
+     */
+    class Printer
+    {
+        bool mjson;
+        bool mfirst;
+
+    public:
+        explicit Printer(bool json) : mjson(json), mfirst(true) {}
+
+        ~Printer()
+        {
+            if ( mjson && !mfirst )
+                std::cout << "\n]" << std::endl;
+        }
+
+        void print(const Record& r)
+        {
+            if ( mjson ) {
+                std::cout << (mfirst ? "[\n  {" : ",\n  {");
+                for (unsigned int i = 0; i != r.names.size(); ++i)
+                    std::cout << (i ? ", " : "") << quoted(r.names[i]) << ": "
+                              << (r.strings[i] ? quoted(r.values[i]) : r.values[i]);
+                std::cout << "}";
+            } else {
+                if ( mfirst ) {
+                    for (unsigned int i = 0; i != r.names.size(); ++i)
+                        std::cout << (i ? "," : "") << r.names[i];
+                    std::cout << std::endl;
+                }
+                for (unsigned int i = 0; i != r.values.size(); ++i)
+                    std::cout << (i ? "," : "") << r.values[i];
+                std::cout << std::endl;
+            }
+            mfirst = false;
+        }
+    };
+
+    /**
+     * The command line options of a benchmark. Each option writes into a
+     * variable of the benchmark, which holds its default. The --json
+     * option is always present.
+     */
+    class Arguments
+    {
+        struct Option
+        {
+            std::string name;
+            std::string meta;
+            std::string help;
+            Option(const std::string& n, const std::string& m, const std::string& h) : name(n), meta(m), help(h) {}
+            virtual ~Option() {}
+            virtual bool takesValue() const = 0;
+            virtual bool set(const char* value) = 0;
+        };
+
+        template<class T>
+        struct Value : public Option
+        {
+            T& target;
+            Value(const std::string& n, const std::string& m, const std::string& h, T& t) : Option(n, m, h), target(t) {}
+            bool takesValue() const { return true; }
+            bool set(const char* value)
+            {
+                std::istringstream s(value);
+                T result;
+                if ( !(s >> result) || !s.eof() )
+                    return false;
+                target = result;
+                return true;
+            }
+        };
+
+        struct Flag : public Option
+        {
+            bool& target;
+            Flag(const std::string& n, const std::string& h, bool& t) : Option(n, "", h), target(t) {}
+            bool takesValue() const { return false; }
+            bool set(const char*) { target = true; return true; }
+        };
+
+        std::vector<Option*> options;
+        bool mjson;
+
+        // not copyable, it owns its options.
+        Arguments(const Arguments&);
+        Arguments& operator=(const Arguments&);
+
+        void add(Option* o) { options.push_back(o); }
+
+    public:
+        Arguments() : mjson(false)
+        {
+            flag("--json", "Print JSON instead of CSV.", mjson);
+        }
+
+        ~Arguments()
+        {
+            for (unsigned int i = 0; i != options.size(); ++i)
+                delete options[i];
+        }
+
+        /**
+         * Adds the option \a name, which takes a value called \a meta and
+         * stores it in \a target. The help text ends with the current
+         * value of \a target as default.
+         */
+        template<class T>
+        void value(const std::string& name, const std::string& meta, T& target, const std::string& help)
+        {
+            std::stringstream h;
+            h << help << " (default " << target << ").";
+            add( new Value<T>(name, meta, h.str(), target) );
+        }
+
+        /**
+         * Adds the option \a name, which takes no value and sets \a target.
+         */
+        void flag(const std::string& name, const std::string& help, bool& target)
+        {
+            add( new Flag(name, help, target) );
+        }
+
+        bool json() const { return mjson; }
+
+        /**
+         * Stores the options given in \a argv.
+         * @return false if an option is unknown or its value is missing or malformed.
+         */
+        bool parse(int argc, char** argv)
+        {
+            for (int i = 1; i < argc; ++i) {
+                std::string arg = argv[i];
+                Option* found = 0;
+                for (unsigned int o = 0; o != options.size() && !found; ++o)
+                    if ( options[o]->name == arg )
+                        found = options[o];
+                if ( !found )
+                    return false;
+                if ( found->takesValue() ) {
+                    if ( i + 1 == argc || !found->set( argv[++i] ) )
+                        return false;
+                } else
+                    found->set(0);
+            }
+            return true;
+        }
+
+        void usage(const char* program) const
+        {
+            std::cerr << "Usage: " << program << " [options]" << std::endl;
+            for (unsigned int i = 0; i != options.size(); ++i)
+                std::cerr << "  " << std::left << std::setw(23) << (options[i]->name + " " + options[i]->meta)
+                          << options[i]->help << std::endl;
+        }
+    };
+}
+
+#endif
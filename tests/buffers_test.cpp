@@ -23,6 +23,8 @@
 
 #include <internal/AtomicQueue.hpp>
 #include <internal/AtomicMWSRQueue.hpp>
+#include <internal/AtomicMPMCQueue.hpp>
+#include <internal/SegmentedMWSRQueue.hpp>
 
 #include <Activity.hpp>
 
@@ -31,6 +33,8 @@
 #include <internal/ListLockFree.hpp>
 #include <base/DataObject.hpp>
 #include <internal/TsPool.hpp>
+#include <internal/ConnFactory.hpp>
+#include <internal/ChannelBufferElement.hpp>
 //#include <internal/SortedList.hpp>
 
 #include <os/Thread.hpp>
@@ -75,6 +79,7 @@ public:
 
 typedef AtomicQueue<Dummy*> QueueType;
 typedef AtomicMWSRQueue<Dummy*> MWSRQueueType;
+typedef AtomicMPMCQueue<Dummy*> MPMCQueueType;
 
 // Don't make queue size too large, we want to catch
 // overrun issues too.
@@ -133,6 +138,7 @@ public:
     DataObjectLocked<Dummy>* dlocked;
     DataObjectLockFree<Dummy>* dlockfree;
     DataObjectUnSync<Dummy>* dunsync;
+    DataObjectSeqLock<Dummy>* dseqlock;
 
     ThreadInterface* athread;
     ThreadInterface* bthread;
@@ -156,6 +162,7 @@ public:
         dlockfree = new DataObjectLockFree<Dummy>();
         dlocked   = new DataObjectLocked<Dummy>();
         dunsync   = new DataObjectUnSync<Dummy>();
+        dseqlock  = new DataObjectSeqLock<Dummy>();
 
         // defaults
         buffer = lockfree;
@@ -172,6 +179,7 @@ public:
         delete dlockfree;
         delete dlocked;
         delete dunsync;
+        delete dseqlock;
     }
 };
 
@@ -570,6 +578,66 @@ struct LLFGrower : public RunnableInterface
     }
 };
 
+/**
+ * Writes consistent samples to a data object.
+ */
+struct DObjWriter : public RunnableInterface
+{
+    volatile bool stop;
+    DataObjectInterface<Dummy>* mdobj;
+    int writes;
+    DObjWriter(DataObjectInterface<Dummy>* d ) : stop(false), mdobj(d), writes(0) {}
+    bool initialize() {
+        stop = false; writes = 0;
+        return true;
+    }
+    void step() {
+        while (stop == false ) {
+            ++writes;
+            mdobj->Set( Dummy(writes, writes, writes) );
+        }
+    }
+
+    void finalize() {}
+
+    bool breakLoop() {
+        stop = true;
+        return true;
+    }
+};
+
+/**
+ * Reads a data object and counts the torn samples.
+ */
+struct DObjReader : public RunnableInterface
+{
+    volatile bool stop;
+    DataObjectInterface<Dummy>* mdobj;
+    int reads;
+    int torn;
+    DObjReader(DataObjectInterface<Dummy>* d ) : stop(false), mdobj(d), reads(0), torn(0) {}
+    bool initialize() {
+        stop = false; reads = 0; torn = 0;
+        return true;
+    }
+    void step() {
+        Dummy d;
+        while (stop == false ) {
+            mdobj->Get( d );
+            ++reads;
+            if ( d.d1 != d.d2 || d.d2 != d.d3 )
+                ++torn;
+        }
+    }
+
+    void finalize() {}
+
+    bool breakLoop() {
+        stop = true;
+        return true;
+    }
+};
+
 /**
  * A Worker Reads and writes the queue.
  */
@@ -785,6 +853,143 @@ BOOST_AUTO_TEST_CASE( testAtomicMWSRQueue )
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_SUITE( BuffersSegmentedQueueTestSuite )
+
+BOOST_AUTO_TEST_CASE( testSegmentedMWSRQueue )
+{
+    SegmentedMWSRQueue<Dummy*> squeue(QS);
+    Dummy d[4*QS];
+    Dummy* c = 0;
+
+    // fixed size: rejects on overflow.
+    for ( int i = 0; i < QS; ++i)
+        BOOST_CHECK( squeue.enqueue( &d[i] ) );
+    BOOST_CHECK( squeue.isFull() );
+    BOOST_CHECK( squeue.enqueue( &d[QS] ) == false );
+    BOOST_REQUIRE_EQUAL( SegmentedMWSRQueue<Dummy*>::size_type(QS), squeue.size() );
+
+    // growable: a new segment is added and FIFO order is kept.
+    squeue.setGrowable(true);
+    BOOST_CHECK( squeue.isFull() == false );
+    for ( int i = QS; i < 4*QS; ++i)
+        BOOST_CHECK( squeue.enqueue( &d[i] ) );
+    BOOST_CHECK_EQUAL( squeue.segments(), 3 );
+    BOOST_REQUIRE_EQUAL( SegmentedMWSRQueue<Dummy*>::size_type(4*QS), squeue.size() );
+    for ( int i = 0; i < 4*QS; ++i) {
+        BOOST_CHECK( squeue.dequeue( c ) );
+        BOOST_CHECK( c == &d[i] );
+    }
+    BOOST_CHECK( squeue.isEmpty() );
+    BOOST_CHECK( squeue.dequeue( c ) == false );
+
+    // resize keeps queued items.
+    squeue.setGrowable(false);
+    BOOST_CHECK( squeue.enqueue( &d[0] ) );
+    BOOST_CHECK_EQUAL( squeue.resize( 2 ), SegmentedMWSRQueue<Dummy*>::size_type(2) );
+    BOOST_REQUIRE_EQUAL( SegmentedMWSRQueue<Dummy*>::size_type(2), squeue.capacity() );
+    BOOST_CHECK( squeue.enqueue( &d[1] ) );
+    BOOST_CHECK( squeue.enqueue( &d[2] ) );
+    BOOST_CHECK( squeue.enqueue( &d[3] ) == false );
+    for ( int i = 0; i < 3; ++i) {
+        BOOST_CHECK( squeue.dequeue( c ) );
+        BOOST_CHECK( c == &d[i] );
+    }
+
+    // drained segments are retired, such that resizing never runs out of segments.
+    for ( int i = 0; i < 4 * SegmentedMWSRQueue<Dummy*>::MaxSegments; ++i) {
+        BOOST_CHECK( squeue.enqueue( &d[i] ) );
+        BOOST_REQUIRE( squeue.canResize() );
+        BOOST_CHECK_EQUAL( squeue.resize( 1 + i % 3 ), SegmentedMWSRQueue<Dummy*>::size_type(1 + i % 3) );
+        BOOST_CHECK( squeue.dequeue( c ) );
+        BOOST_CHECK( c == &d[i] );
+    }
+    BOOST_CHECK( squeue.dequeue( c ) == false );
+    BOOST_CHECK_EQUAL( squeue.segments(), 1 );
+
+    // segments which still hold items are not retired.
+    for ( int i = 1; i < SegmentedMWSRQueue<Dummy*>::MaxSegments; ++i) {
+        BOOST_CHECK( squeue.enqueue( &d[i] ) );
+        BOOST_CHECK( squeue.resize( 1 ) );
+    }
+    BOOST_CHECK( squeue.canResize() == false );
+    BOOST_CHECK_EQUAL( squeue.resize( 1 ), SegmentedMWSRQueue<Dummy*>::size_type(0) );
+    for ( int i = 1; i < SegmentedMWSRQueue<Dummy*>::MaxSegments; ++i) {
+        BOOST_CHECK( squeue.dequeue( c ) );
+        BOOST_CHECK( c == &d[i] );
+    }
+    BOOST_CHECK( squeue.canResize() );
+
+    // segments are not limited to 16-bit sizes.
+    BOOST_CHECK_EQUAL( squeue.resize( 70000 ), SegmentedMWSRQueue<Dummy*>::size_type(70000) );
+    for ( int i = 0; i < 70000; ++i)
+        BOOST_REQUIRE( squeue.enqueue( &d[i % QS] ) );
+    BOOST_CHECK_EQUAL( squeue.size(), SegmentedMWSRQueue<Dummy*>::size_type(70000) );
+    squeue.clear();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( BuffersMPMCQueueTestSuite )
+
+BOOST_AUTO_TEST_CASE( testAtomicMPMCQueue )
+{
+    MPMCQueueType mqueue(QS);
+    Dummy d[2*QS];
+    Dummy* c = 0;
+
+    BOOST_REQUIRE_EQUAL( MPMCQueueType::size_type(QS), mqueue.capacity() );
+    BOOST_REQUIRE_EQUAL( MPMCQueueType::size_type(0), mqueue.size() );
+    BOOST_CHECK( mqueue.isFull() == false );
+    BOOST_CHECK( mqueue.isEmpty() == true );
+    BOOST_CHECK( mqueue.dequeue(c) == false );
+    BOOST_CHECK( c == 0 );
+
+    // wrap around the cells a few times, keeping the order.
+    for ( int round = 0; round < 3; ++round) {
+        for ( int i = 0; i < QS; ++i) {
+            BOOST_CHECK( mqueue.enqueue( &d[i] ) == true);
+            BOOST_REQUIRE_EQUAL( MPMCQueueType::size_type(i+1), mqueue.size() );
+        }
+        BOOST_CHECK( mqueue.isFull() == true );
+        BOOST_CHECK( mqueue.enqueue( &d[QS] ) == false );
+        BOOST_REQUIRE_EQUAL( MPMCQueueType::size_type(QS), mqueue.size() );
+        for ( int i = 0; i < QS - round; ++i) {
+            BOOST_CHECK( mqueue.dequeue( c ) == true);
+            BOOST_CHECK( c == &d[i] );
+        }
+        for ( int i = QS - round; i < QS; ++i) {
+            BOOST_CHECK( mqueue.dequeue( c ) == true);
+            BOOST_CHECK( c == &d[i] );
+        }
+        BOOST_CHECK( mqueue.isEmpty() == true );
+        BOOST_CHECK( mqueue.dequeue( c ) == false );
+    }
+
+    // batches are partially accepted when the queue gets full.
+    Dummy* in[2*QS];
+    Dummy* out[2*QS];
+    for ( int i = 0; i < 2*QS; ++i)
+        in[i] = &d[i];
+    BOOST_CHECK_EQUAL( mqueue.enqueue( in, 3 ), MPMCQueueType::size_type(3) );
+    BOOST_CHECK_EQUAL( mqueue.enqueue( in + 3, 2*QS - 3 ), MPMCQueueType::size_type(QS - 3) );
+    BOOST_CHECK( mqueue.isFull() == true );
+    BOOST_CHECK_EQUAL( mqueue.dequeue( out, 4 ), MPMCQueueType::size_type(4) );
+    BOOST_CHECK_EQUAL( mqueue.enqueue( in + QS, 2*QS ), MPMCQueueType::size_type(4) );
+    BOOST_CHECK_EQUAL( mqueue.dequeue( out + 4, 2*QS ), MPMCQueueType::size_type(QS) );
+    for ( int i = 0; i < QS + 4; ++i)
+        BOOST_CHECK( out[i] == &d[i] );
+    BOOST_CHECK( mqueue.isEmpty() == true );
+    BOOST_CHECK_EQUAL( mqueue.dequeue( out, 2*QS ), MPMCQueueType::size_type(0) );
+
+    // null pointers are stored as any other value.
+    BOOST_CHECK( mqueue.enqueue( 0 ) );
+    c = &d[0];
+    BOOST_CHECK( mqueue.dequeue( c ) );
+    BOOST_CHECK( c == 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_FIXTURE_TEST_SUITE( BuffersDataFlowTestSuite, BuffersDataFlowTest )
 
 BOOST_AUTO_TEST_CASE( testBufLockFree )
@@ -829,7 +1034,150 @@ BOOST_AUTO_TEST_CASE( testDObjUnSync )
     testDObj();
 }
 
+BOOST_AUTO_TEST_CASE( testDObjSeqLock )
+{
+    dataobj = dseqlock;
+    testDObj();
+}
+
+BOOST_AUTO_TEST_CASE( testBuildDataObject )
+{
+    // the default is lock-free, also for small types.
+    boost::scoped_ptr< DataObjectInterface<Dummy> > small( buildDataObject<Dummy>( Dummy(1,2,3) ) );
+    BOOST_CHECK( dynamic_cast<DataObjectLockFree<Dummy>*>( small.get() ) );
+    BOOST_CHECK_EQUAL( small->Get(), Dummy(1,2,3) );
+
+    boost::scoped_ptr< DataObjectInterface<Dummy> > seqlock( buildDataObject<Dummy>( Dummy(1,2,3), 2, true ) );
+    BOOST_CHECK( dynamic_cast<DataObjectSeqLock<Dummy>*>( seqlock.get() ) );
+    BOOST_CHECK_EQUAL( seqlock->Get(), Dummy(1,2,3) );
+
+    // types that are not trivially copyable never get a sequence lock.
+    boost::scoped_ptr< DataObjectInterface< std::vector<int> > > large( buildDataObject< std::vector<int> >( std::vector<int>(3, 1), 5, true ) );
+    DataObjectLockFree< std::vector<int> >* lockfree = dynamic_cast<DataObjectLockFree< std::vector<int> >*>( large.get() );
+    BOOST_REQUIRE( lockfree );
+    BOOST_CHECK_EQUAL( lockfree->MAX_THREADS, 5u );
+    BOOST_CHECK_EQUAL( large->Get().size(), 3u );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( BuffersBatchTestSuite )
+
+BOOST_AUTO_TEST_CASE( testMemoryPoolBatch )
+{
+    TsPool<int> pool(10, 1);
+    int* items[12];
+    BOOST_CHECK_EQUAL( pool.allocate(items, 4), 4u );
+    BOOST_CHECK_EQUAL( pool.size(), 6u );
+    // the pool hands out what is left.
+    BOOST_CHECK_EQUAL( pool.allocate(items + 4, 8), 6u );
+    BOOST_CHECK_EQUAL( pool.size(), 0u );
+    BOOST_CHECK_EQUAL( pool.allocate(items, 1), 0u );
+    for (int i = 0; i != 10; ++i)
+        for (int j = 0; j != i; ++j)
+            BOOST_CHECK( items[i] != items[j] );
+
+    pool.deallocate(items, 3);
+    BOOST_CHECK_EQUAL( pool.size(), 3u );
+    pool.deallocate(items + 3, 7);
+    BOOST_CHECK_EQUAL( pool.size(), 10u );
+    BOOST_CHECK_EQUAL( pool.allocate(items, 10), 10u );
+    pool.deallocate(items, 10);
+}
+
+BOOST_AUTO_TEST_CASE( testBufLockFreeBatch )
+{
+    BufferLockFree<int> buf(40);
+    std::vector<int> in, out;
+    for (int i = 0; i != 50; ++i)
+        in.push_back(i);
+
+    // a full buffer drops the remaining samples.
+    BOOST_CHECK_EQUAL( buf.Push(in), 40u );
+    BOOST_CHECK( buf.full() );
+    BOOST_CHECK_EQUAL( buf.dropped(), 10u );
+
+    out.push_back(-1);
+    BOOST_CHECK_EQUAL( buf.Pop(out, 25), 25u );
+    BOOST_REQUIRE_EQUAL( out.size(), 26u );
+    BOOST_CHECK_EQUAL( out[0], -1 );
+    for (int i = 0; i != 25; ++i)
+        BOOST_CHECK_EQUAL( out[i + 1], i );
+    BOOST_CHECK_EQUAL( buf.Pop(out), 15u );
+    BOOST_REQUIRE_EQUAL( out.size(), 15u );
+    for (int i = 0; i != 15; ++i)
+        BOOST_CHECK_EQUAL( out[i], i + 25 );
+    BOOST_CHECK( buf.empty() );
+    BOOST_CHECK_EQUAL( buf.Pop(out, 10), 0u );
+
+    // a circular buffer keeps the newest samples.
+    BufferLockFree<int> cbuf(20, 0, true);
+    BOOST_CHECK_EQUAL( cbuf.Push(in), 50u );
+    BOOST_CHECK_EQUAL( cbuf.Pop(out), 20u );
+    BOOST_REQUIRE_EQUAL( out.size(), 20u );
+    for (int i = 0; i != 20; ++i)
+        BOOST_CHECK_EQUAL( out[i], i + 30 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#ifdef ORO_HAVE_CAS64
+BOOST_AUTO_TEST_SUITE( BuffersLargeTestSuite )
+
+BOOST_AUTO_TEST_CASE( testLargeMemoryPool )
+{
+    const unsigned int sz = 100000;
+    TsPool<int, unsigned int> pool(sz, 3);
+    BOOST_REQUIRE_EQUAL( sz, pool.capacity() );
+    BOOST_CHECK_EQUAL( sz, pool.size() );
+
+    std::vector<int*> items;
+    for (unsigned int i = 0; i != sz; ++i) {
+        items.push_back( pool.allocate() );
+        BOOST_REQUIRE( items.back() );
+    }
+    BOOST_CHECK_EQUAL( pool.size(), 0u );
+    BOOST_CHECK_EQUAL( pool.allocate(), (int*)0 );
+    for (unsigned int i = 0; i != sz; ++i)
+        BOOST_REQUIRE( pool.deallocate( items[i] ) );
+    BOOST_CHECK_EQUAL( sz, pool.size() );
+}
+
+BOOST_AUTO_TEST_CASE( testLargeBufLockFree )
+{
+    typedef BufferLockFree<int, unsigned int> LargeBuffer;
+    const int sz = 500000;
+    BOOST_CHECK_EQUAL( BufferLockFree<int>::max_capacity(), 65534 );
+    BOOST_CHECK( LargeBuffer::max_capacity() >= sz );
+
+    // ConnFactory picks the 32-bit index for large lock-free buffers.
+    ChannelElementBase::shared_ptr storage( ConnFactory::buildDataStorage<int>( ConnPolicy::buffer(sz) ) );
+    ChannelBufferElementBase* element = dynamic_cast<ChannelBufferElementBase*>( storage.get() );
+    BOOST_REQUIRE( element );
+    BOOST_CHECK_EQUAL( element->getBufferSize(), size_t(sz) );
+
+    boost::scoped_ptr< BufferInterface<int> > buf( buildBuffer<int>(sz) );
+    BOOST_REQUIRE( dynamic_cast<LargeBuffer*>( buf.get() ) );
+    BOOST_REQUIRE_EQUAL( buf->capacity(), sz );
+
+    for (int i = 0; i != sz; ++i)
+        BOOST_REQUIRE( buf->Push(i) );
+    BOOST_CHECK( buf->full() );
+    BOOST_CHECK( buf->Push(sz) == false );
+    BOOST_CHECK_EQUAL( buf->size(), sz );
+
+    int value = -1;
+    for (int i = 0; i != sz; ++i) {
+        BOOST_REQUIRE( buf->Pop(value) );
+        BOOST_REQUIRE_EQUAL( value, i );
+    }
+    BOOST_CHECK( buf->empty() );
+    BOOST_CHECK( buf->Pop(value) == false );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
+#endif
+
 BOOST_FIXTURE_TEST_SUITE( BuffersMPoolTestSuite, BuffersMPoolTest )
 
 BOOST_AUTO_TEST_CASE( testMemoryPool )
@@ -1155,5 +1503,116 @@ BOOST_AUTO_TEST_CASE( testAtomicMWSRQueue )
     delete grower;
     delete eater;
 }
+
+BOOST_AUTO_TEST_CASE( testAtomicMPMCQueue )
+{
+    MPMCQueueType* qt = new MPMCQueueType(QS);
+    AQWorker<MPMCQueueType>* aworker = new AQWorker<MPMCQueueType>( qt );
+    AQWorker<MPMCQueueType>* bworker = new AQWorker<MPMCQueueType>( qt );
+    AQGrower<MPMCQueueType>* grower = new AQGrower<MPMCQueueType>( qt );
+    AQGrower<MPMCQueueType>* hgrower = new AQGrower<MPMCQueueType>( qt );
+    AQEater<MPMCQueueType>* eater = new AQEater<MPMCQueueType>( qt );
+    AQEater<MPMCQueueType>* feater = new AQEater<MPMCQueueType>( qt );
+
+    {
+        boost::scoped_ptr<Activity> athread( new Activity(20, aworker, "ActivityA" ));
+        boost::scoped_ptr<Activity> bthread( new Activity(20, bworker, "ActivityB" ));
+        boost::scoped_ptr<Activity> gthread( new Activity(20, grower, "ActivityG"));
+        boost::scoped_ptr<Activity> hthread( new Activity(20, hgrower, "ActivityH"));
+        boost::scoped_ptr<Activity> ethread( new Activity(20, eater, "ActivityE"));
+        boost::scoped_ptr<Activity> fthread( new Activity(20, feater, "ActivityF"));
+
+        // avoid system lock-ups
+        athread->thread()->setScheduler(ORO_SCHED_OTHER);
+        bthread->thread()->setScheduler(ORO_SCHED_OTHER);
+        gthread->thread()->setScheduler(ORO_SCHED_OTHER);
+        hthread->thread()->setScheduler(ORO_SCHED_OTHER);
+        ethread->thread()->setScheduler(ORO_SCHED_OTHER);
+        fthread->thread()->setScheduler(ORO_SCHED_OTHER);
+
+        log(Info) <<"Stressing multi-write/multi-read..." <<endlog();
+        athread->start();
+        bthread->start();
+        gthread->start();
+        hthread->start();
+        ethread->start();
+        fthread->start();
+        sleep(5);
+        athread->stop();
+        bthread->stop();
+        log(Info) <<"Stressing multi-write/multi-read...without workers" <<endlog();
+        sleep(5);
+        gthread->stop();
+        hthread->stop();
+        ethread->stop();
+        fthread->stop();
+    }
+
+    int appends = aworker->appends + bworker->appends + grower->appends + hgrower->appends;
+    int erases = aworker->erases + bworker->erases + eater->erases + feater->erases;
+    cout <<endl
+         << "Total appends: " << appends <<endl;
+    cout << "Total erases : " << erases + int(qt->size()) <<endl;
+    int i = 0; // left-over count
+    Dummy* d = 0;
+    BOOST_CHECK( qt->size() <= QS );
+    while( qt->dequeue(d) ) {
+        BOOST_CHECK( d );
+        i++;
+        if ( i > QS ) {
+            BOOST_CHECK( i <= QS); // avoid infinite loop.
+            break;
+        }
+    }
+    cout << "Left in Queue: "<< i <<endl;
+    BOOST_CHECK( qt->isEmpty() );
+    BOOST_CHECK_EQUAL( qt->size(), 0 );
+
+    // assert: sum queues == sum dequeues
+    BOOST_CHECK_EQUAL( appends, erases + i );
+    delete aworker;
+    delete bworker;
+    delete grower;
+    delete hgrower;
+    delete eater;
+    delete feater;
+    delete qt;
+}
+#endif
+
+#ifdef OROPKG_OS_GNULINUX
+BOOST_AUTO_TEST_CASE( testDObjSeqLock )
+{
+    DataObjectSeqLock<Dummy> dobj( Dummy(0,0,0) );
+    DObjWriter* writer = new DObjWriter( &dobj );
+    DObjReader* areader = new DObjReader( &dobj );
+    DObjReader* breader = new DObjReader( &dobj );
+
+    {
+        boost::scoped_ptr<Activity> wthread( new Activity(ORO_SCHED_OTHER, 0, 0, writer, "ActivityW" ));
+        boost::scoped_ptr<Activity> athread( new Activity(ORO_SCHED_OTHER, 0, 0, areader, "ActivityA" ));
+        boost::scoped_ptr<Activity> bthread( new Activity(ORO_SCHED_OTHER, 0, 0, breader, "ActivityB" ));
+
+        log(Info) <<"Stressing single-write/multi-read..." <<endlog();
+        athread->start();
+        bthread->start();
+        wthread->start();
+        sleep(2);
+        wthread->stop();
+        athread->stop();
+        bthread->stop();
+    }
+
+    BOOST_CHECK( writer->writes > 0 );
+    BOOST_CHECK( areader->reads > 0 );
+    BOOST_CHECK( breader->reads > 0 );
+    BOOST_CHECK_EQUAL( areader->torn, 0 );
+    BOOST_CHECK_EQUAL( breader->torn, 0 );
+    BOOST_CHECK_EQUAL( dobj.Get(), Dummy(writer->writes, writer->writes, writer->writes) );
+
+    delete writer;
+    delete areader;
+    delete breader;
+}
 #endif
 BOOST_AUTO_TEST_SUITE_END()
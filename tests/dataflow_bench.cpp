@@ -0,0 +1,430 @@
+/***************************************************************************
+  tag: dataflow_bench.cpp
+
+                        dataflow_bench.cpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/**
+ * @file dataflow_bench.cpp
+ * Measures the write-to-read latency and the throughput of port connections
+ * for each connection type and locking policy, for a range of sample sizes
+ * and numbers of writers and readers. The results are printed as CSV or JSON,
+ * one record per configuration, such that runs of different RTT versions can
+ * be compared.
+ *
+ * Each writer owns an OutputPort and each reader an InputPort, and every
+ * writer is connected to every reader. A sample is a std::vector<double>
+ * which carries its write time in its first element. UNSYNC connections are
+ * not thread-safe, so these are measured with writes and reads in one thread.
+ *
+ * The mqueue transport is loaded as a plugin, so set RTT_COMPONENT_PATH
+ * when running the benchmark from the build directory.
+ */
+
+#include <os/main.h>
+#include <os/TimeService.hpp>
+#include <Logger.hpp>
+#include <Activity.hpp>
+#include <base/RunnableInterface.hpp>
+#include <TaskContext.hpp>
+#include <InputPort.hpp>
+#include <OutputPort.hpp>
+#ifdef RTT_BENCH_MQUEUE
+#include <transports/mqueue/MQLib.hpp>
+#endif
+
+#include "bench.hpp"
+
+#include <sstream>
+#include <vector>
+#include <string>
+
+using namespace std;
+using namespace RTT;
+
+namespace {
+
+    typedef std::vector<double> Sample;
+
+    os::TimeService::nsecs epoch = 0;
+
+    /**
+     * The time since the start of the benchmark, which a double holds exactly.
+     */
+    os::TimeService::nsecs now()
+    {
+        return os::TimeService::Instance()->getNSecs() - epoch;
+    }
+
+    /**
+     * The command line options of the benchmark.
+     */
+    struct Options
+    {
+        bool mqueue;
+        unsigned long max_size;
+        int max_threads;
+        int buffer_size;
+        int latency_samples;
+        os::TimeService::nsecs latency_period;
+        unsigned long throughput_bytes;
+
+        Options()
+            : mqueue(false), max_size(8*1024*1024), max_threads(2), buffer_size(8),
+              latency_samples(200), latency_period(1000000), throughput_bytes(64*1024*1024)
+        {}
+    };
+
+    /**
+     * Collects write-to-read latencies in microseconds.
+     */
+    struct LatencyStats
+    {
+        long count;
+        double min, max, sum;
+
+        LatencyStats() : count(0), min(0), max(0), sum(0) {}
+
+        void add(os::TimeService::nsecs written, os::TimeService::nsecs received)
+        {
+            double us = (received - written) / 1000.0;
+            if ( count == 0 || us < min )
+                min = us;
+            if ( count == 0 || us > max )
+                max = us;
+            sum += us;
+            ++count;
+        }
+
+        void merge(const LatencyStats& other)
+        {
+            if ( other.count == 0 )
+                return;
+            if ( count == 0 || other.min < min )
+                min = other.min;
+            if ( count == 0 || other.max > max )
+                max = other.max;
+            sum += other.sum;
+            count += other.count;
+        }
+    };
+
+    /**
+     * Writes \a count samples, stamped with their write time,
+     * and sleeps \a period nanoseconds in between.
+     */
+    struct BenchWriter : public base::RunnableInterface
+    {
+        OutputPort<Sample> port;
+        Sample sample;
+        long count;
+        os::TimeService::nsecs period;
+        os::TimeService::nsecs start;
+        volatile bool done;
+
+        BenchWriter(const string& name, unsigned long doubles)
+            : port(name), sample(doubles, 0.0), count(0), period(0), start(0), done(false)
+        {
+            port.setDataSample(sample);
+        }
+
+        bool initialize() { done = false; return true; }
+
+        void step() {
+            start = now();
+            for (long i = 0; i != count; ++i) {
+                sample[0] = now();
+                port.write(sample);
+                if (period)
+                    bench::sleep_nsecs(period);
+            }
+            done = true;
+        }
+
+        void finalize() {}
+    };
+
+    /**
+     * Reads new samples until stopped, and records their latency and
+     * the time of the last one.
+     */
+    struct BenchReader : public base::RunnableInterface
+    {
+        InputPort<Sample> port;
+        Sample sample;
+        LatencyStats latency;
+        long received;
+        os::TimeService::nsecs last;
+        volatile bool running;
+        volatile bool stop;
+
+        BenchReader(const string& name, unsigned long doubles)
+            : port(name), sample(doubles, 0.0), received(0), last(0), running(false), stop(false)
+        {}
+
+        bool initialize() {
+            latency = LatencyStats();
+            received = 0; last = 0; stop = false;
+            return true;
+        }
+
+        /**
+         * Reads all new samples available now.
+         */
+        void poll() {
+            while ( port.read(sample, false) == NewData ) {
+                last = now();
+                latency.add( os::TimeService::nsecs(sample[0]), last );
+                ++received;
+            }
+        }
+
+        void step() {
+            running = true;
+            while ( !stop )
+                poll();
+            // drain what was written before we were stopped.
+            poll();
+            running = false;
+        }
+
+        bool breakLoop() {
+            stop = true;
+            return true;
+        }
+
+        void finalize() {}
+    };
+
+    /**
+     * One connection configuration: writers, readers and the connections between them.
+     */
+    class Bench
+    {
+        TaskContext tc;
+        vector<BenchWriter*> writers;
+        vector<BenchReader*> readers;
+        ConnPolicy policy;
+        bool threaded;
+
+    public:
+        Bench(ConnPolicy const& policy, int nwriters, int nreaders, unsigned long doubles)
+            : tc("bench"), policy(policy), threaded(policy.lock_policy != ConnPolicy::UNSYNC)
+        {
+            for (int i = 0; i != nwriters; ++i) {
+                stringstream name; name << "w" << i;
+                writers.push_back( new BenchWriter(name.str(), doubles) );
+                tc.ports()->addPort( writers.back()->port );
+            }
+            for (int i = 0; i != nreaders; ++i) {
+                stringstream name; name << "r" << i;
+                readers.push_back( new BenchReader(name.str(), doubles) );
+                tc.ports()->addPort( readers.back()->port );
+            }
+        }
+
+        ~Bench()
+        {
+            for (unsigned int i = 0; i != writers.size(); ++i)
+                writers[i]->port.disconnect();
+            for (unsigned int i = 0; i != writers.size(); ++i)
+                delete writers[i];
+            for (unsigned int i = 0; i != readers.size(); ++i)
+                delete readers[i];
+        }
+
+        bool connect()
+        {
+            for (unsigned int w = 0; w != writers.size(); ++w)
+                for (unsigned int r = 0; r != readers.size(); ++r)
+                    if ( !writers[w]->port.createConnection( readers[r]->port, policy ) )
+                        return false;
+            return true;
+        }
+
+        /**
+         * Lets each writer write \a count samples, \a period nanoseconds apart,
+         * and collects what the readers received.
+         * @return the time from the first write until the last read, in seconds.
+         */
+        double run(long count, os::TimeService::nsecs period, long& received, LatencyStats& latency)
+        {
+            for (unsigned int i = 0; i != writers.size(); ++i) {
+                writers[i]->count = count;
+                writers[i]->period = period;
+            }
+            if ( threaded )
+                run_threaded();
+            else
+                run_sequential();
+
+            os::TimeService::nsecs start = writers[0]->start, last = start;
+            for (unsigned int i = 0; i != writers.size(); ++i)
+                if ( writers[i]->start < start )
+                    start = writers[i]->start;
+            received = 0;
+            for (unsigned int i = 0; i != readers.size(); ++i) {
+                received += readers[i]->received;
+                latency.merge( readers[i]->latency );
+                if ( readers[i]->last > last )
+                    last = readers[i]->last;
+            }
+            return (last - start) / 1e9;
+        }
+
+    private:
+        void run_threaded()
+        {
+            vector<Activity*> activities;
+            for (unsigned int i = 0; i != readers.size(); ++i) {
+                activities.push_back( new Activity(ORO_SCHED_OTHER, 0, 0, readers[i], "BenchReader") );
+                activities.back()->start();
+                while ( !readers[i]->running )
+                    bench::sleep_nsecs(100000);
+            }
+            for (unsigned int i = 0; i != writers.size(); ++i) {
+                activities.push_back( new Activity(ORO_SCHED_OTHER, 0, 0, writers[i], "BenchWriter") );
+                activities.back()->start();
+            }
+            for (unsigned int i = 0; i != writers.size(); ++i)
+                while ( !writers[i]->done )
+                    bench::sleep_nsecs(1000000);
+            // allow transports to deliver the last samples.
+            if ( policy.transport != 0 )
+                bench::sleep_nsecs(100000000);
+            for (unsigned int i = 0; i != activities.size(); ++i) {
+                activities[i]->stop();
+                delete activities[i];
+            }
+        }
+
+        void run_sequential()
+        {
+            for (unsigned int i = 0; i != readers.size(); ++i)
+                readers[i]->initialize();
+            for (unsigned int i = 0; i != writers.size(); ++i) {
+                writers[i]->start = now();
+                for (long n = 0; n != writers[i]->count; ++n) {
+                    writers[i]->sample[0] = now();
+                    writers[i]->port.write( writers[i]->sample );
+                    for (unsigned int r = 0; r != readers.size(); ++r)
+                        readers[r]->poll();
+                }
+            }
+        }
+    };
+
+    bench::Record measure(const Options& opts, const string& transport, const string& type, const string& lock,
+                          ConnPolicy const& policy, int nwriters, int nreaders, unsigned long bytes)
+    {
+        long written = 0, received = 0;
+        double seconds = 0;
+        LatencyStats latency;
+        string error;
+
+        Bench connections(policy, nwriters, nreaders, bytes / sizeof(double));
+        if ( connections.connect() ) {
+            // latency: writes are spaced such that samples do not queue up.
+            connections.run(opts.latency_samples, opts.latency_period, received, latency);
+
+            // throughput: writes as fast as possible.
+            long count = long(opts.throughput_bytes / bytes);
+            if ( count < 10 )
+                count = 10;
+            if ( count > 100000 )
+                count = 100000;
+            LatencyStats ignored;
+            seconds = connections.run(count, 0, received, ignored);
+            written = count * nwriters * nreaders;
+        } else
+            error = "connection failed";
+
+        double samples_per_s = seconds > 0 ? received / seconds : 0;
+        return bench::Record().add("transport", transport).add("type", type).add("lock", lock)
+            .add("writers", nwriters).add("readers", nreaders)
+            .add("sample_bytes", bytes).add("written", written).add("read", received)
+            .add("seconds", seconds).add("samples_per_s", samples_per_s)
+            .add("mbytes_per_s", samples_per_s * bytes / (1024*1024))
+            .add("latency_min_us", latency.min).add("latency_avg_us", latency.count ? latency.sum / latency.count : 0)
+            .add("latency_max_us", latency.max).add("error", error);
+    }
+
+    /**
+     * Returns the sample size that follows \a bytes, which grows eightfold
+     * but ends at \a max, rounded down to whole doubles. Returns zero after \a max.
+     */
+    unsigned long nextSize(unsigned long bytes, unsigned long max)
+    {
+        unsigned long last = max - max % sizeof(double);
+        if ( bytes >= last )
+            return 0;
+        return bytes * 8 < last ? bytes * 8 : last;
+    }
+}
+
+int ORO_main(int argc, char** argv)
+{
+    Options opts;
+    epoch = os::TimeService::Instance()->getNSecs();
+    bench::Arguments args;
+    args.value("--max-size", "BYTES", opts.max_size, "Largest sample size, from 8 bytes up, eightfold");
+    args.value("--max-threads", "N", opts.max_threads, "Measure 1..N writers and 1..N readers");
+    args.value("--buffer", "N", opts.buffer_size, "Size of buffered connections");
+    args.value("--latency-samples", "N", opts.latency_samples, "Samples per writer of the latency run");
+    args.value("--throughput-bytes", "N", opts.throughput_bytes, "Bytes per writer of the throughput run");
+#ifdef RTT_BENCH_MQUEUE
+    args.flag("--mqueue", "Also measure the mqueue transport.", opts.mqueue);
+#endif
+    if ( !args.parse(argc, argv) || opts.max_size < sizeof(double) || opts.max_threads <= 0 || opts.buffer_size <= 0
+         || opts.latency_samples <= 0 || opts.throughput_bytes == 0 ) {
+        args.usage(argv[0]);
+        return 1;
+    }
+
+    const int types[] = { ConnPolicy::DATA, ConnPolicy::BUFFER, ConnPolicy::CIRCULAR_BUFFER };
+    const char* type_names[] = { "DATA", "BUFFER", "CIRCULAR_BUFFER" };
+    const int locks[] = { ConnPolicy::UNSYNC, ConnPolicy::LOCKED, ConnPolicy::LOCK_FREE };
+    const char* lock_names[] = { "UNSYNC", "LOCKED", "LOCK_FREE" };
+
+    bench::Printer out( args.json() );
+    for (unsigned long bytes = sizeof(double); bytes != 0; bytes = nextSize(bytes, opts.max_size)) {
+        for (int t = 0; t != 3; ++t) {
+            for (int l = 0; l != 3; ++l) {
+                ConnPolicy policy(types[t], locks[l]);
+                policy.size = opts.buffer_size;
+                policy.init = false;
+                for (int w = 1; w <= opts.max_threads; ++w)
+                    for (int r = 1; r <= opts.max_threads; ++r) {
+                        // UNSYNC connections only support one thread.
+                        if ( locks[l] == ConnPolicy::UNSYNC && (w != 1 || r != 1) )
+                            continue;
+                        out.print( measure(opts, "local", type_names[t], lock_names[l], policy, w, r, bytes) );
+                    }
+            }
+#ifdef RTT_BENCH_MQUEUE
+            if ( opts.mqueue ) {
+                // the reader side of an mqueue connection stores samples lock-free.
+                ConnPolicy policy(types[t], ConnPolicy::LOCK_FREE);
+                policy.size = opts.buffer_size;
+                policy.init = false;
+                policy.transport = ORO_MQUEUE_PROTOCOL_ID;
+                for (int w = 1; w <= opts.max_threads; ++w)
+                    for (int r = 1; r <= opts.max_threads; ++r)
+                        out.print( measure(opts, "mqueue", type_names[t], "LOCK_FREE", policy, w, r, bytes) );
+            }
+#endif
+        }
+    }
+    return 0;
+}
@@ -31,6 +31,8 @@
 
 #include <boost/bind.hpp>
 #include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <vector>
 
 using namespace RTT;
 using namespace boost;
@@ -223,6 +225,23 @@ public:
 
 };
 
+/**
+ * A handler which counts its calls in a shared token, such that
+ * the token's use count tells how many connections are alive.
+ */
+struct TokenHandler
+{
+    boost::shared_ptr<int> token;
+    TokenHandler(boost::shared_ptr<int> t) : token(t) {}
+    void operator()() { ++*token; }
+};
+
+void destroyHandle(Handle& h)
+{
+    CleanupHandle ch(h);
+    h = Handle();
+}
+
 BOOST_FIXTURE_TEST_SUITE( EventTestSuite, EventTest )
 
 BOOST_AUTO_TEST_CASE( testEmpty )
@@ -306,6 +325,75 @@ BOOST_AUTO_TEST_CASE( testConcurrentEmit )
 }
 #endif
 
+/**
+ * Tests that destroyed connections are released once no emit can use them.
+ */
+BOOST_AUTO_TEST_CASE( testDestroyedConnections )
+{
+    Signal<void(void)> event;
+    boost::shared_ptr<int> token( new int(0) );
+    std::vector<Handle> handles;
+    for (int i = 0; i != 20; ++i)
+        handles.push_back( event.connect( TokenHandler(token) ) );
+    event();
+    BOOST_CHECK_EQUAL( *token, 20 );
+
+    for (int i = 0; i != 10; ++i)
+        destroyHandle( handles[i] );
+    handles.erase( handles.begin(), handles.begin() + 10 );
+    event();
+    BOOST_CHECK_EQUAL( *token, 30 );
+    BOOST_CHECK_EQUAL( token.use_count(), 11 );
+
+    // a connection destroyed during emit is released by a later setup.
+    boost::shared_ptr<int> victim_token( new int(0) );
+    Handle victim = event.connect( TokenHandler(victim_token) );
+    Handle killer = event.connect( boost::bind(&destroyHandle, boost::ref(victim)) );
+    event();
+    BOOST_CHECK( !victim.ready() );
+    BOOST_CHECK_EQUAL( victim_token.use_count(), 2 );
+    killer.disconnect();
+    event();
+    BOOST_CHECK_EQUAL( *victim_token, 1 );
+    Handle h = event.connect( TokenHandler(token) );
+    BOOST_CHECK_EQUAL( victim_token.use_count(), 1 );
+
+    handles.clear();
+    event.destroy();
+    BOOST_CHECK_EQUAL( token.use_count(), 2 );
+    h = Handle();
+    BOOST_CHECK_EQUAL( token.use_count(), 1 );
+}
+
+#ifdef OROCOS_TARGET_GNULINUX
+/**
+ * Tests setting up and destroying connections while other threads emit.
+ */
+BOOST_AUTO_TEST_CASE( testConcurrentSetupAndEmit )
+{
+    testConcurrentEmitHandlerCount.set(0);
+    Signal<void(void)> event;
+    EmitAndcount arunobj(event);
+    EmitAndcount brunobj(event);
+    Activity atask(ORO_SCHED_OTHER, 0, 0, &arunobj);
+    Activity btask(ORO_SCHED_OTHER, 0, 0, &brunobj);
+    Handle h = event.connect( &testConcurrentEmitHandler );
+    boost::shared_ptr<int> token( new int(0) );
+    BOOST_CHECK( atask.start() );
+    BOOST_CHECK( btask.start() );
+    for (int i = 0; i != 1000; ++i) {
+        Handle t = event.connect( TokenHandler(token) );
+        destroyHandle( t );
+    }
+    BOOST_CHECK( atask.stop() );
+    BOOST_CHECK( btask.stop() );
+    BOOST_CHECK_EQUAL( arunobj.count + brunobj.count, testConcurrentEmitHandlerCount.read() );
+    // the last destroyed connections are released by the next setup.
+    Handle t = event.connect( &testConcurrentEmitHandler );
+    BOOST_CHECK_EQUAL( token.use_count(), 1 );
+}
+#endif
+
 BOOST_AUTO_TEST_CASE( testBlockingTask )
 {
     Signal<void(int)> event;
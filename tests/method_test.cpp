@@ -24,10 +24,76 @@
 #include <OperationCaller.hpp>
 #include <Operation.hpp>
 #include <Service.hpp>
+#include <os/Atomic.hpp>
 
 #include "unit.hpp"
 #include "operations_fixture.hpp"
 
+#include <unistd.h>
+
+#ifdef __GLIBC__
+
+extern "C" void* __libc_malloc(size_t size);
+
+namespace {
+    // counts the calls to malloc() of the thread which enabled counting,
+    // such that the allocations of other threads in the process are ignored.
+    __thread bool count_mallocs = false;
+    os::AtomicInt mallocs(0);
+}
+
+extern "C" void* malloc(size_t size)
+{
+    if ( count_mallocs )
+        mallocs.inc();
+    return __libc_malloc(size);
+}
+#endif
+
+/**
+ * Records in which step of its ExecutionEngine each call is executed.
+ */
+class StepRecorder : public TaskContext
+{
+public:
+    unsigned int steps;
+    std::vector<unsigned int> calls;
+
+    StepRecorder() : TaskContext("steprecorder"), steps(0)
+    {
+        calls.reserve(100);
+        this->addOperation("record", &StepRecorder::record, this, OwnThread);
+        this->addOperation("add", &StepRecorder::add, this, OwnThread);
+    }
+
+    int record(int i) { calls.push_back(steps); return i; }
+
+    int add(int i, const std::string& s) { calls.push_back(steps); return i + s.size(); }
+
+    void updateHook() { ++steps; }
+};
+
+/**
+ * Counts the completions of sent calls and checks in which thread they run.
+ */
+struct CompletionRecorder
+{
+    TaskContext* owner;
+    os::AtomicInt done;
+    volatile bool in_owner;
+    CompletionRecorder(TaskContext* t) : owner(t), done(0), in_owner(true) {}
+    void completed() {
+        if ( !owner->engine()->getActivity()->thread()->isSelf() )
+            in_owner = false;
+        done.inc();
+    }
+    bool wait(int count) {
+        for (int i = 0; i != 1000 && done.read() < count; ++i)
+            usleep(1000);
+        return done.read() == count;
+    }
+};
+
 /**
  * This test suite tests the RTT::OperationCaller object's LocalOperationCaller implementation.
  */
@@ -425,4 +491,132 @@ BOOST_AUTO_TEST_CASE(testDSOperationCaller)
 
 }
 
+/**
+ * Tests that sendMany() executes all calls in one step of the receiver.
+ */
+BOOST_AUTO_TEST_CASE(testOwnThreadOperationCallerSendMany)
+{
+    StepRecorder recorder;
+    BOOST_REQUIRE( recorder.start() );
+    OperationCaller<int(int)> record = recorder.getOperation("record");
+    OperationCaller<int(int,const std::string&)> add = recorder.getOperation("add");
+    record.setCaller( caller->engine() );
+    add.setCaller( caller->engine() );
+
+    std::vector<int> ints;
+    std::vector<std::string> strings;
+    for (int i = 0; i != 50; ++i) {
+        ints.push_back(i);
+        strings.push_back( std::string(i % 5, 'x') );
+    }
+
+    std::vector< SendHandle<int(int)> > handles = record.sendMany(ints);
+    BOOST_REQUIRE_EQUAL( handles.size(), 50u );
+    int retn = 0;
+    for (int i = 0; i != 50; ++i) {
+        BOOST_CHECK_EQUAL( SendSuccess, handles[i].collect(retn) );
+        BOOST_CHECK_EQUAL( retn, i );
+    }
+
+    std::vector< SendHandle<int(int,const std::string&)> > addhandles = add.sendMany(ints, strings);
+    BOOST_REQUIRE_EQUAL( addhandles.size(), 50u );
+    for (int i = 0; i != 50; ++i) {
+        BOOST_CHECK_EQUAL( SendSuccess, addhandles[i].collect(retn) );
+        BOOST_CHECK_EQUAL( retn, i + i % 5 );
+    }
+
+    BOOST_REQUIRE_EQUAL( recorder.calls.size(), 100u );
+    BOOST_CHECK( std::count(recorder.calls.begin(), recorder.calls.begin() + 50, recorder.calls[0]) == 50 );
+    BOOST_CHECK( std::count(recorder.calls.begin() + 50, recorder.calls.end(), recorder.calls[50]) == 50 );
+
+    // argument vectors of different sizes send nothing.
+    strings.pop_back();
+    BOOST_CHECK( add.sendMany(ints, strings).empty() );
+    BOOST_CHECK_EQUAL( recorder.calls.size(), 100u );
+
+    // an engine without activity rejects the whole batch.
+    ExecutionEngine idle;
+    OperationCaller<int(int)> rejected("record", &StepRecorder::record, &recorder, &idle, caller->engine(), OwnThread);
+    BOOST_CHECK( rejected.sendMany(ints).empty() );
+    BOOST_CHECK_EQUAL( recorder.calls.size(), 100u );
+}
+
+/**
+ * Tests that the completion of a sent call runs in the caller's engine.
+ */
+BOOST_AUTO_TEST_CASE(testOwnThreadOperationCallerCompletion)
+{
+    tc->provides()->addOperation("m1completion", &OperationsFixture::m1, this, OwnThread);
+    OperationCaller<double(int)> m1 = tc->provides()->getOperation("m1completion");
+    m1.setCaller( caller->engine() );
+    BOOST_REQUIRE( m1.ready() );
+    BOOST_REQUIRE( tc->isRunning() );
+    BOOST_REQUIRE( caller->isRunning() );
+
+    CompletionRecorder rec( caller );
+    double retn = 0;
+    SendHandle<double(int)> h = m1.send(1);
+    BOOST_CHECK( h.onCompletion( boost::bind(&CompletionRecorder::completed, &rec) ) );
+    BOOST_CHECK( rec.wait(1) );
+    BOOST_CHECK_EQUAL( SendSuccess, h.collectIfDone(retn) );
+    BOOST_CHECK_EQUAL( retn, -2.0 );
+
+    // a call which already returned runs its completion too.
+    h = m1.send(1);
+    BOOST_CHECK_EQUAL( SendSuccess, h.collect(retn) );
+    BOOST_CHECK( h.onCompletion( boost::bind(&CompletionRecorder::completed, &rec) ) );
+    BOOST_CHECK( rec.wait(2) );
+    BOOST_CHECK( rec.in_owner );
+
+    // without caller engine, there is no engine to run the completion in.
+    OperationCaller<double(int)> nocaller = tc->provides()->getOperation("m1completion");
+    h = nocaller.send(1);
+    BOOST_CHECK( !h.onCompletion( boost::bind(&CompletionRecorder::completed, &rec) ) );
+    h.collect(retn);
+    BOOST_CHECK( !SendHandle<double(int)>().onCompletion( boost::bind(&CompletionRecorder::completed, &rec) ) );
+    BOOST_CHECK_EQUAL( rec.done.read(), 2 );
+}
+
+#ifdef __GLIBC__
+/**
+ * Tests that send() and collect() recycle the call records of the
+ * OperationCaller instead of allocating memory.
+ */
+BOOST_AUTO_TEST_CASE(testOwnThreadOperationCallerSendPool)
+{
+    tc->provides()->addOperation("m1pooled", &OperationsFixture::m1, this, OwnThread);
+    OperationCaller<double(int)> m1 = tc->provides()->getOperation("m1pooled");
+    unsigned int poolsize = base::OperationCallerInterface::getSendPoolSize();
+    base::OperationCallerInterface::setSendPoolSize(8);
+    m1.setCaller( caller->engine() );
+    base::OperationCallerInterface::setSendPoolSize(poolsize);
+    BOOST_REQUIRE( m1.ready() );
+    BOOST_REQUIRE( tc->isRunning() );
+    BOOST_REQUIRE( caller->isRunning() );
+
+    double retn = 0;
+    SendHandle<double(int)> h;
+    mallocs.set(0);
+    count_mallocs = true;
+    for (int i = 0; i != 100; ++i) {
+        h = m1.send(1);
+        BOOST_CHECK_EQUAL( SendSuccess, h.collect(retn) );
+        BOOST_CHECK_EQUAL( retn, -2.0 );
+        // leave the caller's engine the time to dispose the record.
+        usleep(1000);
+    }
+    count_mallocs = false;
+    BOOST_CHECK_EQUAL( mallocs.read(), 0 );
+
+    // more outstanding handles than records fall back to allocation.
+    std::vector< SendHandle<double(int)> > handles(10);
+    for (unsigned int i = 0; i != handles.size(); ++i)
+        handles[i] = m1.send(1);
+    for (unsigned int i = 0; i != handles.size(); ++i) {
+        BOOST_CHECK_EQUAL( SendSuccess, handles[i].collect(retn) );
+        BOOST_CHECK_EQUAL( retn, -2.0 );
+    }
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
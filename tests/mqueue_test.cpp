@@ -24,6 +24,7 @@
 #include <transports/mqueue/MQLib.hpp>
 #include <transports/mqueue/MQChannelElement.hpp>
 #include <transports/mqueue/MQTemplateProtocol.hpp>
+#include <transports/mqueue/Dispatcher.hpp>
 #include <os/fosi.h>
 
 using namespace std;
@@ -286,6 +287,49 @@ BOOST_AUTO_TEST_CASE( testPortStreams )
     testPortDisconnected();
 }
 
+BOOST_AUTO_TEST_CASE( testDispatcherShards )
+{
+    // Serve both streams in their own dispatcher thread.
+    BOOST_REQUIRE( mqueue::Dispatcher::setShardCount(2) );
+    BOOST_CHECK_EQUAL( mqueue::Dispatcher::getShardCount(), 2u );
+
+    policy.type = ConnPolicy::BUFFER;
+    policy.pull = false;
+    policy.size = 10;
+    policy.name_id = "/shard1";
+    BOOST_REQUIRE( mw1->createStream( policy ) );
+    BOOST_REQUIRE( mr2->createStream( policy ) );
+    policy.name_id = "/shard2";
+    BOOST_REQUIRE( mw2->createStream( policy ) );
+    BOOST_REQUIRE( mr1->createStream( policy ) );
+    BOOST_CHECK( !mqueue::Dispatcher::setShardCount(1) );
+
+    // a burst of samples is drained from both queues.
+    for (int i = 0; i != 5; ++i) {
+        mw1->write( double(i) );
+        mw2->write( double(10 + i) );
+    }
+    usleep(200000);
+    double value = 0;
+    for (int i = 0; i != 5; ++i) {
+        BOOST_CHECK_EQUAL( NewData, mr2->read(value) );
+        BOOST_CHECK_EQUAL( double(i), value );
+        BOOST_CHECK_EQUAL( NewData, mr1->read(value) );
+        BOOST_CHECK_EQUAL( double(10 + i), value );
+    }
+    BOOST_CHECK( OldData == mr2->read(value) );
+    BOOST_CHECK( OldData == mr1->read(value) );
+
+    mw1->disconnect();
+    mr2->disconnect();
+    mw2->disconnect();
+    mr1->disconnect();
+    testPortDisconnected();
+
+    // the dispatcher is gone with its last queue.
+    BOOST_CHECK( mqueue::Dispatcher::setShardCount(1) );
+}
+
 BOOST_AUTO_TEST_CASE( testPortStreamsTimeout )
 {
     // Test creating an input stream without an output stream available.
@@ -25,6 +25,7 @@
 #include <extras/SequentialActivity.hpp>
 #include <extras/SimulationActivity.hpp>
 #include <extras/SimulationThread.hpp>
+#include <Activity.hpp>
 
 #include <boost/function_types/function_type.hpp>
 #include <OperationCaller.hpp>
@@ -32,6 +33,7 @@
 #include <rtt-config.h>
 
 #include <memory>
+#include <boost/scoped_ptr.hpp>
 
 using namespace std;
 using namespace RTT;
@@ -100,6 +102,33 @@ public:
 };
 
 
+/**
+ * Writes to a port as fast as possible, until breakLoop().
+ */
+struct PortWriter : public RunnableInterface
+{
+    volatile bool stop;
+    OutputPort<int>& port;
+    volatile int writes;
+    PortWriter(OutputPort<int>& p) : stop(false), port(p), writes(0) {}
+    bool initialize() {
+        stop = false;
+        writes = 0;
+        return true;
+    }
+    void step() {
+        while (stop == false) {
+            port.write( int(writes) );
+            ++writes;
+        }
+    }
+    void finalize() {}
+    bool breakLoop() {
+        stop = true;
+        return true;
+    }
+};
+
 // Registers the fixture into the 'registry'
 BOOST_FIXTURE_TEST_SUITE(  PortsTestSuite,  PortsTestFixture )
 
@@ -362,6 +391,189 @@ BOOST_AUTO_TEST_CASE(testPortOneWriterThreeReaders)
     BOOST_CHECK_EQUAL( rp3.read(value), NoData );
 }
 
+BOOST_AUTO_TEST_CASE(testPortConnectWhileWriting)
+{
+    OutputPort<int> wp("W");
+    InputPort<int> rp1("R1", ConnPolicy::data());
+    InputPort<int> rp2("R2", ConnPolicy::buffer(4));
+
+    wp.createConnection(rp1);
+    PortWriter* writer = new PortWriter(wp);
+    {
+        boost::scoped_ptr<Activity> athread( new Activity(ORO_SCHED_OTHER, 0, 0, writer, "PortWriter" ));
+        BOOST_CHECK( athread->start() );
+        while ( writer->writes == 0 )
+            usleep(1000);
+        // the writer never blocks on the connection list while we modify it.
+        int value = 0;
+        for (int i = 0; i != 200; ++i) {
+            BOOST_CHECK( wp.createConnection(rp2) );
+            BOOST_CHECK( rp2.connected() );
+            rp1.read(value);
+            rp2.read(value);
+            wp.disconnect(&rp2);
+            BOOST_CHECK( !rp2.connected() );
+        }
+        BOOST_CHECK( athread->stop() );
+    }
+    BOOST_CHECK( writer->writes > 0 );
+    BOOST_CHECK( wp.connected() );
+    BOOST_CHECK( rp1.connected() );
+    BOOST_CHECK_EQUAL( wp.getManager()->getChannels().size(), 1u );
+    int value = -1;
+    BOOST_CHECK( rp1.read(value) );
+    BOOST_CHECK_EQUAL( value, writer->writes - 1 );
+    delete writer;
+}
+
+BOOST_AUTO_TEST_CASE(testPortLoanPublish)
+{
+    OutputPort<int> wp("W", false);
+    InputPort<int> rp1("R1", ConnPolicy::data());
+    InputPort<int> rp2("R2", ConnPolicy::buffer(4));
+    InputPort<int> rp3("R3", ConnPolicy::data());
+
+    // loaning must be enabled first.
+    BOOST_CHECK( !wp.loan().valid() );
+
+    wp.createConnection(rp1);
+    wp.createConnection(rp2);
+    wp.reserveLoans(1);
+    wp.createConnection(rp3);
+
+    internal::LoanedSample<int> loan = wp.loan();
+    BOOST_REQUIRE( loan.valid() );
+    *loan = 10;
+    wp.publish( loan );
+    BOOST_CHECK( !loan.valid() );
+
+    // all readers share the same sample.
+    internal::SharedSample<int> s1, s2;
+    BOOST_CHECK_EQUAL( rp1.readShared(s1), NewData );
+    BOOST_CHECK_EQUAL( rp2.readShared(s2), NewData );
+    BOOST_REQUIRE( s1.valid() && s2.valid() );
+    BOOST_CHECK_EQUAL( *s1, 10 );
+    BOOST_CHECK( s1.get() == s2.get() );
+    BOOST_CHECK_EQUAL( rp1.readShared(s1), OldData );
+    BOOST_CHECK_EQUAL( rp2.readShared(s2), OldData );
+    BOOST_CHECK( s1.get() == s2.get() );
+
+    // a plain read copies the shared sample.
+    int value = 0;
+    BOOST_CHECK_EQUAL( rp3.read(value), NewData );
+    BOOST_CHECK_EQUAL( value, 10 );
+
+    // a shared read of a plain write copies the sample.
+    wp.write(20);
+    BOOST_CHECK_EQUAL( rp1.readShared(s1), NewData );
+    BOOST_CHECK_EQUAL( *s1, 20 );
+    BOOST_CHECK_EQUAL( rp2.readShared(s2), NewData );
+    BOOST_CHECK_EQUAL( *s2, 20 );
+    BOOST_CHECK( s1.get() != s2.get() );
+
+    // the buffer keeps the order of the published samples.
+    for (int i = 0; i != 4; ++i) {
+        loan = wp.loan();
+        BOOST_REQUIRE( loan.valid() );
+        *loan = 30 + i;
+        wp.publish( loan );
+    }
+    for (int i = 0; i != 4; ++i) {
+        BOOST_CHECK_EQUAL( rp2.readShared(s2), NewData );
+        BOOST_CHECK_EQUAL( *s2, 30 + i );
+    }
+    BOOST_CHECK_EQUAL( rp1.readShared(s1), NewData );
+    BOOST_CHECK_EQUAL( *s1, 33 );
+
+    // samples return to the pool when all references are gone.
+    s1.reset();
+    s2.reset();
+    wp.disconnect();
+    internal::LoanedSample<int> loans[100];
+    unsigned int count = 0;
+    do {
+        loans[count] = wp.loan();
+    } while ( loans[count++].valid() && count < 100 );
+    // 17 samples: 1 loan, 2 data connections of 5 and a buffer of 4 + 2,
+    // followed by the failed loan.
+    BOOST_CHECK_EQUAL( count, 18u );
+}
+
+BOOST_AUTO_TEST_CASE(testPortLoanMove)
+{
+    OutputPort<int> wp("W", false);
+    InputPort<int> rp("R", ConnPolicy::data());
+    wp.createConnection(rp);
+    wp.reserveLoans(1);
+
+    // a LoanedSample is moved, never copied.
+    internal::LoanedSample<int> loan = wp.loan();
+    BOOST_REQUIRE( loan.valid() );
+    internal::LoanedSample<int> moved = loan;
+    BOOST_CHECK( !loan.valid() );
+    BOOST_REQUIRE( moved.valid() );
+    loan = moved;
+    BOOST_CHECK( !moved.valid() );
+    BOOST_REQUIRE( loan.valid() );
+    BOOST_CHECK_EQUAL( loan.use_count(), 1 );
+
+    // publishing consumes the loan.
+    *loan = 5;
+    wp.publish( loan );
+    BOOST_CHECK( !loan.valid() );
+    internal::SharedSample<int> s;
+    BOOST_CHECK_EQUAL( rp.readShared(s), NewData );
+    BOOST_CHECK_EQUAL( *s, 5 );
+}
+
+BOOST_AUTO_TEST_CASE(testPortReadAll)
+{
+    OutputPort<int> wp("W");
+    InputPort<int> rp1("R1", ConnPolicy::buffer(100));
+    InputPort<int> rp2("R2", ConnPolicy::data());
+    std::vector<int> samples;
+
+    BOOST_CHECK_EQUAL( rp1.readAll(samples), NoData );
+    wp.createConnection(rp1);
+    wp.createConnection(rp2);
+    BOOST_CHECK_EQUAL( rp1.readAll(samples), NoData );
+    BOOST_CHECK( samples.empty() );
+
+    std::vector<int> written;
+    for (int i = 0; i != 60; ++i)
+        written.push_back(i);
+    wp.write(written);
+    for (int i = 60; i != 100; ++i)
+        wp.write(i);
+
+    samples.push_back(-1);
+    BOOST_CHECK_EQUAL( rp1.readAll(samples), NewData );
+    BOOST_REQUIRE_EQUAL( samples.size(), 100u );
+    for (int i = 0; i != 100; ++i)
+        BOOST_CHECK_EQUAL( samples[i], i );
+    BOOST_CHECK_EQUAL( rp1.readAll(samples), OldData );
+    BOOST_CHECK( samples.empty() );
+    int value = 0;
+    BOOST_CHECK_EQUAL( rp1.read(value), OldData );
+    BOOST_CHECK_EQUAL( value, 99 );
+
+    // a data connection only keeps the last sample.
+    BOOST_CHECK_EQUAL( rp2.readAll(samples), NewData );
+    BOOST_REQUIRE_EQUAL( samples.size(), 1u );
+    BOOST_CHECK_EQUAL( samples[0], 99 );
+    BOOST_CHECK_EQUAL( rp2.readAll(samples), OldData );
+    BOOST_CHECK_EQUAL( wp.getLastWrittenValue(), 99 );
+
+    // a full buffer drops the newest samples.
+    written.clear();
+    for (int i = 0; i != 150; ++i)
+        written.push_back(i);
+    wp.write(written);
+    BOOST_CHECK_EQUAL( rp1.readAll(samples), NewData );
+    BOOST_CHECK_EQUAL( samples.size(), 100u );
+    BOOST_CHECK_EQUAL( samples.back(), 99 );
+}
+
 BOOST_AUTO_TEST_CASE(testPortThreeWritersOneReader)
 {
     OutputPort<int> wp1("W1");
@@ -634,6 +846,104 @@ BOOST_AUTO_TEST_CASE(testEventPortSignalling)
     tce->ports()->removePort( rp1.getName() );
 }
 
+/**
+ * Counts the callbacks of an event port, the first one blocking
+ * until released.
+ */
+struct NewestListener
+{
+    os::Mutex block;
+    InputPort<double>& port;
+    volatile int calls;
+    double last;
+    NewestListener(InputPort<double>& p) : port(p), calls(0), last(0.0) {}
+    void new_data(PortInterface*) {
+        os::MutexLock lock(block);
+        ++calls;
+        port.read(last);
+    }
+};
+
+BOOST_AUTO_TEST_CASE(testEventPortNewestOnly)
+{
+    OutputPort<double> wp1("Write");
+    InputPort<double>  rp1("Read");
+    NewestListener listener(rp1);
+    TaskContext tca("newest");
+    tca.setActivity( new Activity(ORO_SCHED_OTHER, 0, 0.0, 0, "Newest") );
+
+    BOOST_CHECK( !rp1.isNewestOnly() );
+    rp1.setNewestOnly(true);
+    BOOST_CHECK( rp1.isNewestOnly() );
+    tca.addEventPort(rp1, boost::bind(&NewestListener::new_data, &listener, _1) );
+    wp1.createConnection(rp1, ConnPolicy::buffer(20));
+    BOOST_CHECK( tca.start() );
+
+    // samples arriving while the callback blocks are delivered once,
+    // and only the newest one of them is read from the buffer.
+    listener.block.lock();
+    wp1.write(1.0);
+    usleep(100000);
+    for (int i = 2; i != 12; ++i)
+        wp1.write( double(i) );
+    listener.block.unlock();
+    usleep(100000);
+    BOOST_CHECK_EQUAL( listener.calls, 2 );
+    BOOST_CHECK_EQUAL( listener.last, 11.0 );
+
+    // the port is notified again once it was served.
+    wp1.write(12.0);
+    usleep(100000);
+    BOOST_CHECK_EQUAL( listener.calls, 3 );
+    BOOST_CHECK_EQUAL( listener.last, 12.0 );
+    double sample = 0.0;
+    BOOST_CHECK_EQUAL( rp1.read(sample), OldData );
+
+    tca.stop();
+    tca.ports()->removePort( rp1.getName() );
+}
+
+/**
+ * Records the ports of the callbacks of event ports.
+ */
+struct PortRecorder
+{
+    std::vector<PortInterface*> ports;
+    void new_data(PortInterface* port) { ports.push_back(port); }
+};
+
+BOOST_AUTO_TEST_CASE(testEventPortRemovedWhileQueued)
+{
+    OutputPort<double> wp1("Write1");
+    OutputPort<double> wp2("Write2");
+    InputPort<double>* rp1 = new InputPort<double>("Read1");
+    InputPort<double>  rp2("Read2");
+    PortRecorder recorder;
+    TaskContext tca("removed");
+    // without a master, the slave steps only when we execute it.
+    SlaveActivity* act = new SlaveActivity();
+    tca.setActivity( act );
+
+    rp1->setNewestOnly(true);
+    tca.addEventPort(*rp1, boost::bind(&PortRecorder::new_data, &recorder, _1) );
+    tca.addEventPort(rp2, boost::bind(&PortRecorder::new_data, &recorder, _1) );
+    wp1.createConnection(*rp1, ConnPolicy::data());
+    wp2.createConnection(rp2, ConnPolicy::data());
+    BOOST_CHECK( tca.start() );
+
+    wp1.write(1.0);
+    wp2.write(2.0);
+    // the removed port is dropped from the queue before it is deleted.
+    tca.ports()->removePort("Read1");
+    delete rp1;
+    BOOST_CHECK( act->execute() );
+    BOOST_REQUIRE_EQUAL( recorder.ports.size(), 1u );
+    BOOST_CHECK( recorder.ports[0] == &rp2 );
+
+    tca.stop();
+    tca.ports()->removePort( rp2.getName() );
+}
+
 BOOST_AUTO_TEST_CASE(testPlainPortNotSignalling)
 {
     OutputPort<double> wp1("Write");
@@ -383,6 +383,39 @@ BOOST_AUTO_TEST_CASE(testProgramLoops)
     this->finishProgram( tc, "x");
 }
 
+BOOST_AUTO_TEST_CASE(testCompiledProgram)
+{
+    // see if a compiled program takes the same branches as the graph
+    BOOST_REQUIRE( sa->properties()->getPropertyType<bool>("CompileScripts") );
+    sa->properties()->getPropertyType<bool>("CompileScripts")->set(true);
+    string prog = string("program x { \n")
+        + "do test.resetI()\n"
+        + "while (test.increase() != 200) {\n"
+        + "   for (var int j = 0; j != 100  ; j = j + 1 ) {\n"
+        + "      if j == 50 then break \n"
+        + "   }\n"
+        + "   if j != 50 then \n"
+        + "      do test.fail() \n"
+        + "}\n"
+        + "if test.i != 200 then \n"
+        + "    do test.fail() \n"
+        + "else \n"
+        + "    test.resetI()\n"
+        + "}";
+    this->doProgram( prog, tc );
+    FunctionGraph* fg = dynamic_cast<FunctionGraph*>( sa->getProgram("x").get() );
+    BOOST_REQUIRE( fg );
+    BOOST_CHECK( fg->isCompiled() );
+    this->finishProgram( tc, "x");
+
+    // an error stops a compiled program as well.
+    prog = "program y { test.resetI()\n test.fail()\n test.increase()\n }";
+    this->doProgram( prog, tc, false );
+    BOOST_CHECK( sa->getProgram("y")->inError() );
+    BOOST_CHECK_EQUAL( i, 0 );
+    this->finishProgram( tc, "y");
+}
+
 BOOST_AUTO_TEST_CASE(testProgramAnd)
 {
     // see if checking a remote condition works
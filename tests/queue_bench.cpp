@@ -0,0 +1,177 @@
+/***************************************************************************
+  tag: queue_bench.cpp
+
+                        queue_bench.cpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/**
+ * @file queue_bench.cpp
+ * Measures the multi-producer throughput of the lock-free queues: 1 up to
+ * a number of threads enqueue into one queue while one thread dequeues.
+ * The AtomicMPMCQueue is compared to the AtomicMWSRQueue and AtomicQueue
+ * it replaces, which keep both indexes in one word. The results are printed
+ * as CSV or JSON, one record per queue and number of producers.
+ */
+
+#include <os/main.h>
+#include <os/TimeService.hpp>
+#include <Activity.hpp>
+#include <base/RunnableInterface.hpp>
+#include <internal/AtomicMPMCQueue.hpp>
+#include <internal/AtomicMWSRQueue.hpp>
+#include <internal/AtomicQueue.hpp>
+
+#include "bench.hpp"
+
+#include <vector>
+#include <string>
+
+using namespace std;
+using namespace RTT;
+
+namespace {
+
+    /**
+     * The command line options of the benchmark.
+     */
+    struct Options
+    {
+        int max_producers;
+        long items;
+        int capacity;
+
+        Options()
+            : max_producers(16), items(1000000), capacity(1024)
+        {}
+    };
+
+    /**
+     * Waits for \a go and enqueues \a count items, retrying while the queue is full.
+     */
+    template<class Queue>
+    struct Producer : public base::RunnableInterface
+    {
+        Queue& queue;
+        long count;
+        volatile bool& go;
+        volatile bool done;
+
+        Producer(Queue& q, long n, volatile bool& g)
+            : queue(q), count(n), go(g), done(false)
+        {}
+
+        bool initialize() { done = false; return true; }
+
+        void step() {
+            static int item;
+            while ( !go )
+                ;
+            for (long i = 0; i != count; ++i)
+                while ( !queue.enqueue( &item ) )
+                    ;
+            done = true;
+        }
+
+        void finalize() {}
+    };
+
+    /**
+     * Dequeues \a count items and records how long it took since \a go was set.
+     */
+    template<class Queue>
+    struct Consumer : public base::RunnableInterface
+    {
+        Queue& queue;
+        long count;
+        volatile bool& go;
+        os::TimeService::nsecs elapsed;
+        volatile bool done;
+
+        Consumer(Queue& q, long n, volatile bool& g)
+            : queue(q), count(n), go(g), elapsed(0), done(false)
+        {}
+
+        bool initialize() { done = false; return true; }
+
+        void step() {
+            int* item;
+            while ( !go )
+                ;
+            os::TimeService::nsecs start = os::TimeService::Instance()->getNSecs();
+            for (long i = 0; i != count; ++i)
+                while ( !queue.dequeue( item ) )
+                    ;
+            elapsed = os::TimeService::Instance()->getNSecs() - start;
+            done = true;
+        }
+
+        void finalize() {}
+    };
+
+    template<class Queue>
+    bench::Record measure(const Options& opts, const string& name, int nproducers)
+    {
+        long items = opts.items * nproducers;
+        Queue queue( opts.capacity );
+        volatile bool go = false;
+        Consumer<Queue> consumer(queue, items, go);
+        vector<Producer<Queue>*> producers;
+        vector<Activity*> activities;
+        activities.push_back( new Activity(ORO_SCHED_OTHER, 0, 0, &consumer, "QueueConsumer") );
+        for (int i = 0; i != nproducers; ++i) {
+            producers.push_back( new Producer<Queue>(queue, opts.items, go) );
+            activities.push_back( new Activity(ORO_SCHED_OTHER, 0, 0, producers.back(), "QueueProducer") );
+        }
+        for (size_t i = 0; i != activities.size(); ++i)
+            activities[i]->start();
+        go = true;
+        while ( !consumer.done )
+            bench::sleep_nsecs(1000000);
+
+        for (size_t i = 0; i != activities.size(); ++i) {
+            activities[i]->stop();
+            delete activities[i];
+        }
+        for (int i = 0; i != nproducers; ++i)
+            delete producers[i];
+        double seconds = consumer.elapsed / 1e9;
+        return bench::Record().add("queue", name).add("producers", nproducers)
+            .add("items", items).add("seconds", seconds)
+            .add("items_per_sec", seconds > 0 ? items / seconds : 0.0)
+            .add("ns_per_item", double(consumer.elapsed) / items);
+    }
+}
+
+int ORO_main(int argc, char** argv)
+{
+    Options opts;
+    bench::Arguments args;
+    args.value("--max-producers", "N", opts.max_producers, "Measure 1..N producing threads");
+    args.value("--items", "N", opts.items, "Items enqueued per producer");
+    args.value("--capacity", "N", opts.capacity, "Capacity of the queue");
+    // AtomicMWSRQueue and AtomicQueue use 16-bit indexes.
+    if ( !args.parse(argc, argv) || opts.max_producers <= 0 || opts.items <= 0
+         || opts.capacity <= 1 || opts.capacity >= 65535 ) {
+        args.usage(argv[0]);
+        return 1;
+    }
+
+    bench::Printer out( args.json() );
+    for (int p = 1; p <= opts.max_producers; ++p) {
+        out.print( measure< internal::AtomicMPMCQueue<int*> >(opts, "mpmc", p) );
+        out.print( measure< internal::AtomicMWSRQueue<int*> >(opts, "mwsr", p) );
+        out.print( measure< internal::AtomicQueue<int*> >(opts, "atomic", p) );
+    }
+    return 0;
+}
@@ -26,10 +26,17 @@
 #include <Operation.hpp>
 #include <internal/RemoteOperationCaller.hpp>
 #include <Service.hpp>
+#include <os/Atomic.hpp>
+#include <unistd.h>
 
 #include "unit.hpp"
 #include "operations_fixture.hpp"
 
+namespace {
+    os::AtomicInt completions(0);
+    void completed() { completions.inc(); }
+}
+
 /**
  * This test suite tests the RTT::internal::RemoteOperationCaller class
  * and its dependencies, being OperationCallerC and SendHandleC.
@@ -193,6 +200,28 @@ BOOST_AUTO_TEST_CASE(testOperationCallerC_Send)
     BOOST_REQUIRE(tc->inException() );
 }
 
+BOOST_AUTO_TEST_CASE(testSendHandleC_Completion)
+{
+    OperationCallerC mc;
+    SendHandleC shc;
+    double r = 0.0;
+    double cr = 0.0;
+    completions.set(0);
+    mc = tc->provides("methods")->create("o1", caller->engine()).argC(1).ret( r );
+    shc = mc.send();
+    shc.arg(cr);
+    BOOST_REQUIRE( shc.ready() );
+    BOOST_CHECK( shc.onCompletion( &completed ) );
+    for (int i = 0; i != 1000 && completions.read() == 0; ++i)
+        usleep(1000);
+    BOOST_CHECK_EQUAL( completions.read(), 1 );
+    BOOST_CHECK_EQUAL( shc.collectIfDone(), SendSuccess);
+    BOOST_CHECK_EQUAL( cr, -2.0 );
+
+    // a handle which was not sent has nothing to complete.
+    BOOST_CHECK( !SendHandleC().onCompletion( &completed ) );
+}
+
 BOOST_AUTO_TEST_CASE(testOperationCallerFromDS)
 {
     ServicePtr sp = tc->provides("methods");
@@ -0,0 +1,138 @@
+/***************************************************************************
+  tag: signal_bench.cpp
+
+                        signal_bench.cpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/**
+ * @file signal_bench.cpp
+ * Measures the cost of emitting an internal::Signal for 1 up to 64
+ * connected handlers, doubling each time, and for one up to a number of
+ * threads which emit the same Signal at once. The handlers do nothing, such
+ * that the cost of emit() itself is measured. The results are printed as CSV
+ * or JSON, one record per configuration.
+ */
+
+#include <os/main.h>
+#include <os/TimeService.hpp>
+#include <Activity.hpp>
+#include <base/RunnableInterface.hpp>
+#include <internal/Signal.hpp>
+
+#include "bench.hpp"
+
+#include <vector>
+
+using namespace std;
+using namespace RTT;
+
+namespace {
+
+    void handler(int) {}
+
+    /**
+     * The command line options of the benchmark.
+     */
+    struct Options
+    {
+        int max_handlers;
+        int max_threads;
+        long emits;
+
+        Options()
+            : max_handlers(64), max_threads(2), emits(1000000)
+        {}
+    };
+
+    /**
+     * Emits the signal \a count times and records how long it took.
+     */
+    struct Emitter : public base::RunnableInterface
+    {
+        internal::Signal<void(int)>& sig;
+        long count;
+        os::TimeService::nsecs elapsed;
+        volatile bool done;
+
+        Emitter(internal::Signal<void(int)>& s, long n)
+            : sig(s), count(n), elapsed(0), done(false)
+        {}
+
+        bool initialize() { done = false; return true; }
+
+        void step() {
+            os::TimeService::nsecs start = os::TimeService::Instance()->getNSecs();
+            for (long i = 0; i != count; ++i)
+                sig.emit( int(i) );
+            elapsed = os::TimeService::Instance()->getNSecs() - start;
+            done = true;
+        }
+
+        void finalize() {}
+    };
+
+    bench::Record measure(const Options& opts, int nhandlers, int nemitters)
+    {
+        internal::Signal<void(int)> sig;
+        sig.reserve( nhandlers );
+        vector<Handle> handles;
+        for (int i = 0; i != nhandlers; ++i)
+            handles.push_back( sig.connect( &handler ) );
+
+        vector<Emitter*> emitters;
+        vector<Activity*> activities;
+        for (int i = 0; i != nemitters; ++i) {
+            emitters.push_back( new Emitter(sig, opts.emits) );
+            activities.push_back( new Activity(ORO_SCHED_OTHER, 0, 0, emitters.back(), "SignalEmitter") );
+        }
+        for (int i = 0; i != nemitters; ++i)
+            activities[i]->start();
+        for (int i = 0; i != nemitters; ++i)
+            while ( !emitters[i]->done )
+                bench::sleep_nsecs(1000000);
+
+        os::TimeService::nsecs elapsed = 0;
+        for (int i = 0; i != nemitters; ++i) {
+            activities[i]->stop();
+            elapsed += emitters[i]->elapsed;
+            delete activities[i];
+            delete emitters[i];
+        }
+        // summed over the threads, such that ns_per_emit is the cost of one emit in one thread.
+        long emits = opts.emits * nemitters;
+        double ns_per_emit = double(elapsed) / emits;
+        return bench::Record().add("handlers", nhandlers).add("emitters", nemitters)
+            .add("emits", emits).add("seconds", elapsed / 1e9)
+            .add("ns_per_emit", ns_per_emit).add("ns_per_handler", ns_per_emit / nhandlers);
+    }
+}
+
+int ORO_main(int argc, char** argv)
+{
+    Options opts;
+    bench::Arguments args;
+    args.value("--max-handlers", "N", opts.max_handlers, "Measure 1..N handlers, doubling");
+    args.value("--max-threads", "N", opts.max_threads, "Measure 1..N emitting threads");
+    args.value("--emits", "N", opts.emits, "Emits per thread");
+    if ( !args.parse(argc, argv) || opts.max_handlers <= 0 || opts.max_threads <= 0 || opts.emits <= 0 ) {
+        args.usage(argv[0]);
+        return 1;
+    }
+
+    bench::Printer out( args.json() );
+    for (int h = 1; h <= opts.max_handlers; h *= 2)
+        for (int t = 1; t <= opts.max_threads; ++t)
+            out.print( measure(opts, h, t) );
+    return 0;
+}
@@ -10,8 +10,13 @@
 
 #include "specialized_activities.hpp"
 #include <extras/FileDescriptorActivity.hpp>
+#include <cstdio>
 #include <iostream>
 #include <memory>
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/select.h>
+#endif
 
 #include <rtt-detail-fwd.hpp>
 using namespace RTT::detail;
@@ -151,5 +156,95 @@ BOOST_AUTO_TEST_CASE( testFileDescriptorActivity )
 }
 
 
+#ifdef __linux__
+BOOST_AUTO_TEST_CASE( testFileDescriptorActivityEpoll )
+{
+#if __cplusplus > 199711L
+    unique_ptr<TestFDActivity>
+#else
+    auto_ptr<TestFDActivity>
+#endif
+            activity(new TestFDActivity);
+    static const int USLEEP = 250000;
+
+    int pipe_fds[2];
+    int other_pipe[2];
+    BOOST_REQUIRE( pipe(pipe_fds) == 0 );
+    BOOST_REQUIRE( pipe(other_pipe) == 0 );
+
+    // select() can not watch file descriptors above FD_SETSIZE
+    int reader = fcntl(pipe_fds[0], F_DUPFD, FD_SETSIZE + 476);
+    BOOST_REQUIRE( reader >= FD_SETSIZE );
+    int writer = pipe_fds[1];
+    int other_reader = other_pipe[0];
+    int other_writer = other_pipe[1];
+
+    activity->fd = reader;
+    activity->other_fd = other_reader;
+    activity->do_read = true;
+    activity->watch(reader);
+    activity->watch(other_reader);
+    BOOST_CHECK( activity->isWatched(reader) );
+
+    // Both FDs are ready before starting, they must be reported in one step.
+    char buffer = 0;
+    BOOST_CHECK( write(writer, &buffer, 1) == 1 );
+    BOOST_CHECK( write(other_writer, &buffer, 1) == 1 );
+    BOOST_CHECK( activity->start() );
+    usleep(USLEEP);
+    BOOST_CHECK_EQUAL(1, activity->step_count);
+    BOOST_CHECK_EQUAL(1, activity->count);
+    BOOST_CHECK_EQUAL(1, activity->other_count);
+
+    // In edge-triggered mode, unread data does not wake up the activity again.
+    BOOST_CHECK( activity->setEdgeTriggered(true) );
+    BOOST_CHECK( activity->isEdgeTriggered() );
+    activity->do_read = false;
+    BOOST_CHECK( write(writer, &buffer, 1) == 1 );
+    usleep(USLEEP);
+    BOOST_CHECK_EQUAL(2, activity->step_count);
+    BOOST_CHECK_EQUAL(2, activity->count);
+    BOOST_CHECK( activity->stop() );
+
+    activity->unwatch(reader);
+    BOOST_CHECK( !activity->isWatched(reader) );
+    close(reader); close(pipe_fds[0]); close(writer);
+    close(other_reader); close(other_writer);
+}
+
+BOOST_AUTO_TEST_CASE( testFileDescriptorActivityEpollErrors )
+{
+#if __cplusplus > 199711L
+    unique_ptr<TestFDActivity>
+#else
+    auto_ptr<TestFDActivity>
+#endif
+            activity(new TestFDActivity);
+    static const int USLEEP = 250000;
+
+    // epoll can not watch regular files.
+    FILE* file = tmpfile();
+    BOOST_REQUIRE( file );
+    activity->fd = activity->other_fd = -1;
+    activity->watch( fileno(file) );
+    BOOST_CHECK( !activity->isWatched( fileno(file) ) );
+    fclose(file);
+
+    // the timeout triggers step() until it is set back to 0.
+    activity->setTimeout(20);
+    BOOST_CHECK( activity->start() );
+    usleep(USLEEP);
+    BOOST_CHECK( activity->step_count > 2 );
+    activity->setTimeout(0);
+    activity->trigger();
+    usleep(USLEEP);
+    int steps = activity->step_count;
+    usleep(USLEEP);
+    BOOST_CHECK_EQUAL( steps, activity->step_count );
+    BOOST_CHECK( !activity->hasTimeout() );
+    BOOST_CHECK( activity->stop() );
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -25,6 +25,8 @@
 #include <iostream>
 
 #include <extras/PeriodicActivity.hpp>
+#include <extras/PooledActivity.hpp>
+#include <os/Atomic.hpp>
 #include <os/TimeService.hpp>
 #include <Logger.hpp>
 
@@ -220,6 +222,81 @@ struct TestSelfRemove
     }
 };
 
+/**
+ * Detects concurrent steps and remembers the last trigger
+ * that was seen by a step.
+ */
+struct TestPooled
+    : public RunnableInterface
+{
+    os::AtomicInt inside;
+    os::AtomicInt triggered;
+    int steps, seen, overlaps;
+    bool fini;
+    TestPooled() : inside(0), triggered(0), steps(0), seen(0), overlaps(0), fini(false) {}
+    bool initialize() {
+        fini = false;
+        return true;
+    }
+    void step() {
+        inside.inc();
+        if ( inside.read() != 1 )
+            ++overlaps;
+        seen = triggered.read();
+        ++steps;
+        usleep(100);
+        inside.dec();
+    }
+    void finalize() {
+        fini = true;
+    }
+    bool trigger() {
+        triggered.inc();
+        return this->getActivity()->trigger();
+    }
+};
+
+/**
+ * Stops its activity from within step() and keeps running for a while.
+ */
+struct TestStopInStep
+    : public RunnableInterface
+{
+    volatile bool stopped, returned;
+    TestStopInStep() : stopped(false), returned(false) {}
+    bool initialize() { return true; }
+    void step() {
+        this->getActivity()->stop();
+        stopped = true;
+        usleep(100000);
+        returned = true;
+    }
+    void finalize() {}
+};
+
+/**
+ * Records the order in which activities are stepped.
+ */
+struct TestOrder
+    : public RunnableInterface
+{
+    int id;
+    std::vector<int>* order;
+    useconds_t delay;
+    TestOrder(int i, std::vector<int>* o) : id(i), order(o), delay(0) {}
+    bool initialize() {
+        return true;
+    }
+    void finalize() {
+    }
+    void step() {
+        if ( order->size() < order->capacity() )
+            order->push_back(id);
+        if ( delay )
+            usleep(delay);
+    }
+};
+
 void
 ActivitiesTest::setUp()
 {
@@ -539,6 +616,147 @@ BOOST_AUTO_TEST_CASE( testAllocation )
     testRemoveAllocate();
 }
 
+BOOST_AUTO_TEST_CASE( testPooledActivity )
+{
+    const int N = 50;
+    TestPooled runners[N];
+    // force ordering of destruction.
+    {
+        extras::ActivityPoolPtr pool( new extras::ActivityPool(ORO_SCHED_OTHER, os::LowestPriority, 3) );
+        BOOST_CHECK_EQUAL( pool->getWorkerCount(), 3u );
+        std::vector<extras::PooledActivity*> acts;
+        for (int i = 0; i != N; ++i) {
+            acts.push_back( new extras::PooledActivity(pool, &runners[i]) );
+            BOOST_CHECK( !acts[i]->trigger() );
+            BOOST_CHECK( acts[i]->start() );
+            BOOST_CHECK( acts[i]->thread() == pool->idleThread() );
+        }
+        for (int k = 0; k != 20; ++k) {
+            for (int i = 0; i != N; ++i)
+                BOOST_CHECK( runners[i].trigger() );
+            if ( k % 5 == 0 )
+                usleep(1000);
+        }
+        // every trigger is followed by a step which saw it.
+        for (int i = 0; i != N; ++i) {
+            for (int w = 0; w != 500 && runners[i].seen != 20; ++w)
+                usleep(10000);
+            BOOST_CHECK_EQUAL( runners[i].seen, 20 );
+            BOOST_CHECK( runners[i].steps >= 1 && runners[i].steps <= 20 );
+            BOOST_CHECK_EQUAL( runners[i].overlaps, 0 );
+        }
+        // stop() waits for a running step.
+        for (int i = 0; i != N; ++i) {
+            runners[i].trigger();
+            BOOST_CHECK( acts[i]->stop() );
+            BOOST_CHECK_EQUAL( runners[i].inside.read(), 0 );
+            BOOST_CHECK( runners[i].fini );
+            BOOST_CHECK( !acts[i]->trigger() );
+        }
+        // restart
+        BOOST_CHECK( acts[0]->start() );
+        int steps = runners[0].steps;
+        BOOST_CHECK( runners[0].trigger() );
+        for (int w = 0; w != 500 && runners[0].steps == steps; ++w)
+            usleep(10000);
+        BOOST_CHECK_EQUAL( runners[0].steps, steps + 1 );
+        for (int i = 0; i != N; ++i)
+            delete acts[i];
+    }
+}
+
+BOOST_AUTO_TEST_CASE( testPooledSelfRemove )
+{
+    extras::PooledActivity act;
+    BOOST_CHECK( act.run( t_self_remove ) );
+    BOOST_CHECK( act.start() );
+    for (int i = 0; i != 5; ++i) {
+        BOOST_CHECK( act.trigger() );
+        for (int w = 0; w != 500 && t_self_remove->c == i; ++w)
+            usleep(10000);
+    }
+    BOOST_CHECK_EQUAL( t_self_remove->c, 5 );
+    BOOST_CHECK( t_self_remove->fini );
+    BOOST_CHECK( !act.isActive() );
+    BOOST_CHECK( !act.trigger() );
+    BOOST_CHECK( act.run( 0 ) );
+}
+
+BOOST_AUTO_TEST_CASE( testPooledStopInStep )
+{
+    TestStopInStep runner;
+    extras::PooledActivity* act = new extras::PooledActivity( &runner );
+    BOOST_CHECK( act->start() );
+    BOOST_CHECK( act->isRunning() );
+    BOOST_CHECK( act->trigger() );
+    for (int w = 0; w != 500 && !runner.stopped; ++w)
+        usleep(10000);
+    BOOST_REQUIRE( runner.stopped );
+    BOOST_CHECK( !act->isActive() );
+    BOOST_CHECK( !act->isRunning() );
+    BOOST_CHECK( !act->trigger() );
+    // the destructor waits until the worker is done with the activity.
+    delete act;
+    BOOST_CHECK( runner.returned );
+}
+
+BOOST_AUTO_TEST_CASE( testTimerThreadOrder )
+{
+    std::vector<int> order;
+    order.reserve(30);
+    TestOrder r0(0, &order), r1(1, &order), r2(2, &order);
+    {
+        TimerThreadPtr timer( new TimerThread(ORO_SCHED_OTHER, 0, "TimerOrder", 0.01) );
+        PeriodicActivity a0(timer, &r0), a1(timer, &r1), a2(timer, &r2);
+        // 0 reads from 2, 2 reads from 1
+        BOOST_CHECK( timer->addDependency(&a2, &a0) );
+        BOOST_CHECK( timer->addDependency(&a1, &a2) );
+        BOOST_CHECK( !timer->addDependency(&a0, &a1) );
+        BOOST_CHECK( !timer->addDependency(&a0, &a0) );
+        timer->setScheduleOrder( TimerThread::DependencyOrder );
+        BOOST_CHECK( a0.start() );
+        BOOST_CHECK( a1.start() );
+        BOOST_CHECK( a2.start() );
+        testPause();
+        BOOST_CHECK( a0.stop() && a1.stop() && a2.stop() );
+        BOOST_REQUIRE( order.size() >= 3 );
+        for (unsigned int i = 0; i + 2 < order.size(); i += 3) {
+            BOOST_CHECK_EQUAL( order[i], 1 );
+            BOOST_CHECK_EQUAL( order[i+1], 2 );
+            BOOST_CHECK_EQUAL( order[i+2], 0 );
+        }
+
+        order.clear();
+        BOOST_CHECK( a2.setDeadline(0.002) );
+        BOOST_CHECK( a0.setDeadline(0.004) );
+        BOOST_CHECK( !a1.setDeadline(-1.0) );
+        BOOST_CHECK_CLOSE( a1.getDeadline(), 0.01, 0.01 );
+        timer->setScheduleOrder( TimerThread::DeadlineOrder );
+        BOOST_CHECK( a1.start() );
+        BOOST_CHECK( a0.start() );
+        BOOST_CHECK( a2.start() );
+        testPause();
+        BOOST_CHECK( a1.stop() && a0.stop() && a2.stop() );
+        BOOST_REQUIRE( order.size() >= 3 );
+        for (unsigned int i = 0; i + 2 < order.size(); i += 3) {
+            BOOST_CHECK_EQUAL( order[i], 2 );
+            BOOST_CHECK_EQUAL( order[i+1], 0 );
+            BOOST_CHECK_EQUAL( order[i+2], 1 );
+        }
+
+        // a slow step misses its deadline.
+        order.clear();
+        r2.delay = 3000;
+        BOOST_CHECK( a2.start() );
+        BOOST_CHECK( a0.start() );
+        BOOST_CHECK( a1.start() );
+        testPause();
+        BOOST_CHECK( a2.stop() && a0.stop() && a1.stop() );
+        BOOST_CHECK( a2.getOverruns() > 0 );
+        BOOST_CHECK_EQUAL( a1.getOverruns(), 0u );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #if defined( OROCOS_TARGET_GNULINUX ) && defined( ORO_HAVE_PTHREAD_SETNAME_NP )
@@ -727,5 +727,226 @@ BOOST_AUTO_TEST_CASE(testErrorHook_is_not_called_during_stop)
     }
 }
 
+struct CountingMessage : public base::DisposableInterface
+{
+    int& count;
+    CountingMessage(int& c) : count(c) {}
+    void executeAndDispose() { ++count; }
+    void dispose() {}
+    bool isError() const { return false; }
+};
+
+/**
+ * Tests the sizing of the message queue and the counting
+ * of rejected messages.
+ */
+BOOST_AUTO_TEST_CASE( testQueueSize )
+{
+    TaskContext qtc("QTC");
+    qtc.setActivity( new SlaveActivity() );
+    int count = 0;
+    CountingMessage msg(count);
+
+    BOOST_CHECK( qtc.setQueueSize(5, false) );
+    BOOST_CHECK_EQUAL( qtc.getQueueSize(), 5u );
+    for (int i = 0; i != 10; ++i)
+        qtc.engine()->process( &msg );
+    BOOST_CHECK_EQUAL( qtc.getRejectedMessages(), 5u );
+    BOOST_CHECK( qtc.update() );
+    BOOST_CHECK_EQUAL( count, 5 );
+
+    // growable queue does not reject:
+    count = 0;
+    BOOST_CHECK( qtc.setQueueSize(5, true) );
+    for (int i = 0; i != 100; ++i)
+        BOOST_CHECK( qtc.engine()->process( &msg ) );
+    BOOST_CHECK_EQUAL( qtc.getRejectedMessages(), 5u );
+    BOOST_CHECK( qtc.getQueueSize() > 5u );
+    BOOST_CHECK( qtc.update() );
+    BOOST_CHECK_EQUAL( count, 100 );
+}
+
+/**
+ * Tests the carry-over of messages when the message budget
+ * of a step is exceeded.
+ */
+BOOST_AUTO_TEST_CASE( testMessageBudget )
+{
+    TaskContext btc("BTC");
+    btc.setActivity( new SlaveActivity() );
+    int count = 0;
+    CountingMessage msg(count);
+
+    btc.setMessageBudget(3, 0.0);
+    BOOST_CHECK_EQUAL( btc.engine()->getMaxMessages(), 3u );
+    for (int i = 0; i != 10; ++i)
+        BOOST_CHECK( btc.engine()->process( &msg ) );
+    BOOST_CHECK( btc.update() );
+    BOOST_CHECK_EQUAL( count, 3 );
+    BOOST_CHECK_EQUAL( btc.engine()->getMessagesDrained(), 3u );
+    BOOST_CHECK_EQUAL( btc.engine()->getMessagesBacklog(), 7u );
+
+    // the statistics are attributes of the TaskContext:
+    base::AttributeBase* backlog = btc.getAttribute("messagesBacklog");
+    BOOST_REQUIRE( backlog );
+    internal::DataSource<unsigned int>::shared_ptr ds = internal::DataSource<unsigned int>::narrow( backlog->getDataSource().get() );
+    BOOST_REQUIRE( ds );
+    BOOST_CHECK_EQUAL( ds->get(), 7u );
+
+    BOOST_CHECK( btc.update() );
+    BOOST_CHECK( btc.update() );
+    BOOST_CHECK( btc.update() );
+    BOOST_CHECK_EQUAL( count, 10 );
+    BOOST_CHECK_EQUAL( ds->get(), 0u );
+
+    // no limit:
+    btc.setMessageBudget(0, 0.0);
+    for (int i = 0; i != 10; ++i)
+        BOOST_CHECK( btc.engine()->process( &msg ) );
+    BOOST_CHECK( btc.update() );
+    BOOST_CHECK_EQUAL( count, 20 );
+    BOOST_CHECK_EQUAL( btc.engine()->getMessagesDrained(), 10u );
+}
+
+/**
+ * Tests the execution time statistics of the 'stats' service.
+ */
+BOOST_AUTO_TEST_CASE( testStatsService )
+{
+    StatesTC stc;
+    stc.do_checks = false;
+    stc.setActivity( new SlaveActivity(0.01) );
+    BOOST_REQUIRE( stc.provides()->hasService("stats") );
+    Service::shared_ptr stats = stc.provides("stats");
+    OperationCaller<unsigned int(const std::string&)> getCount = stats->getOperation("getCount");
+    OperationCaller<double(const std::string&)> getMax = stats->getOperation("getMax");
+    OperationCaller<double(const std::string&, double)> getPercentile = stats->getOperation("getPercentile");
+    OperationCaller<void(void)> reset = stats->getOperation("reset");
+    BOOST_REQUIRE( getCount.ready() && getMax.ready() && getPercentile.ready() && reset.ready() );
+
+    BOOST_CHECK( stc.configure() );
+    BOOST_CHECK( stc.start() );
+    // start() may already have processed messages.
+    reset();
+    for (int i = 0; i != 10; ++i)
+        BOOST_CHECK( stc.update() );
+    BOOST_CHECK_EQUAL( getCount("updateHook"), 10u );
+    BOOST_CHECK_EQUAL( getCount("prepareUpdateHook"), 10u );
+    BOOST_CHECK_EQUAL( getCount("processMessages"), 10u );
+    BOOST_CHECK_EQUAL( getCount("errorHook"), 0u );
+    BOOST_CHECK_EQUAL( getCount("noSuchTimer"), 0u );
+    BOOST_CHECK( getMax("updateHook") >= 0.0 );
+    BOOST_CHECK( getPercentile("updateHook", 0.99) <= getMax("updateHook") );
+
+    reset();
+    BOOST_CHECK( stc.update() );
+    BOOST_CHECK_EQUAL( getCount("updateHook"), 1u );
+    BOOST_CHECK( stc.stop() );
+}
+
+/**
+ * A child which records when its updateHook() starts and ends,
+ * and how many children run at the same time.
+ */
+struct OrderedChild : public base::TaskCore
+{
+    os::AtomicInt& sequence;
+    os::AtomicInt& concurrent;
+    int& max_concurrent;
+    int started, ended, updates, stopped;
+    bool stop_in_update;
+    TaskCore* stop_other;
+    unsigned int set_helpers;
+    OrderedChild(ExecutionEngine* ee, os::AtomicInt& seq, os::AtomicInt& conc, int& max_conc)
+        : TaskCore(ee), sequence(seq), concurrent(conc), max_concurrent(max_conc),
+          started(0), ended(0), updates(0), stopped(0), stop_in_update(false), stop_other(0), set_helpers(0) {}
+    void updateHook() {
+        concurrent.inc();
+        sequence.inc();
+        started = sequence.read();
+        if ( concurrent.read() > max_concurrent )
+            max_concurrent = concurrent.read();
+        usleep(2000);
+        ++updates;
+        sequence.inc();
+        ended = sequence.read();
+        concurrent.dec();
+        if ( stop_in_update )
+            this->stop();
+        if ( stop_other ) {
+            stop_other->stop();
+            stop_other = 0;
+        }
+        if ( set_helpers ) {
+            this->engine()->setParallelChildren(set_helpers);
+            set_helpers = 0;
+        }
+    }
+    void stopHook() {
+        sequence.inc();
+        stopped = sequence.read();
+    }
+};
+
+/**
+ * Tests executing children on helper threads in a partial order.
+ */
+BOOST_AUTO_TEST_CASE( testParallelChildren )
+{
+    TaskContext ptc("PTC");
+    ptc.setActivity( new SlaveActivity() );
+    os::AtomicInt sequence(0), concurrent(0);
+    int max_concurrent = 0;
+    std::vector<OrderedChild*> kids;
+    for (int i = 0; i != 8; ++i) {
+        kids.push_back( new OrderedChild(ptc.engine(), sequence, concurrent, max_concurrent) );
+        BOOST_CHECK( kids[i]->start() );
+    }
+    // 0 before 1 before 2, and 0 before 3.
+    BOOST_CHECK( ptc.engine()->addChildDependency(kids[0], kids[1]) );
+    BOOST_CHECK( ptc.engine()->addChildDependency(kids[1], kids[2]) );
+    BOOST_CHECK( ptc.engine()->addChildDependency(kids[0], kids[3]) );
+    BOOST_CHECK( !ptc.engine()->addChildDependency(kids[2], kids[0]) );
+
+    BOOST_CHECK( ptc.engine()->setParallelChildren(3) );
+    BOOST_CHECK_EQUAL( ptc.engine()->getParallelChildren(), 3u );
+    BOOST_CHECK( ptc.start() );
+    for (int n = 1; n != 6; ++n) {
+        BOOST_CHECK( ptc.update() );
+        for (int i = 0; i != 8; ++i)
+            BOOST_CHECK_EQUAL( kids[i]->updates, n );
+        BOOST_CHECK( kids[0]->ended < kids[1]->started );
+        BOOST_CHECK( kids[1]->ended < kids[2]->started );
+        BOOST_CHECK( kids[0]->ended < kids[3]->started );
+    }
+    BOOST_CHECK( max_concurrent > 1 );
+
+    // stop() from within updateHook() in a helper thread.
+    kids[7]->stop_in_update = true;
+    BOOST_CHECK( ptc.update() );
+    BOOST_CHECK( !kids[7]->isRunning() );
+    BOOST_CHECK_EQUAL( kids[6]->updates, 6 );
+
+    // stop a sibling and replace the helpers from within updateHook().
+    kids[4]->stop_other = kids[5];
+    kids[6]->set_helpers = 2;
+    BOOST_CHECK( ptc.update() );
+    BOOST_CHECK( !kids[5]->isRunning() );
+    BOOST_CHECK( kids[5]->stopped > kids[5]->ended );
+    BOOST_CHECK_EQUAL( ptc.engine()->getParallelChildren(), 2u );
+    BOOST_CHECK( ptc.update() );
+    BOOST_CHECK_EQUAL( kids[6]->updates, 8 );
+
+    // back to sequential execution.
+    BOOST_CHECK( ptc.engine()->setParallelChildren(0) );
+    max_concurrent = 0;
+    BOOST_CHECK( ptc.update() );
+    BOOST_CHECK_EQUAL( kids[0]->updates, 9 );
+    BOOST_CHECK_EQUAL( max_concurrent, 1 );
+    BOOST_CHECK( ptc.stop() );
+    for (int i = 0; i != 8; ++i)
+        delete kids[i];
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
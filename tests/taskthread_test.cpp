@@ -22,12 +22,16 @@
 #include "taskthread_test.hpp"
 
 #include <iostream>
+#include <algorithm>
+#include <sstream>
 
 #include <extras/Activities.hpp>
 #include <extras/TimerThread.hpp>
 #include <extras/SimulationThread.hpp>
 #include <os/MainThread.hpp>
 #include <Logger.hpp>
+#include <OperationCaller.hpp>
+#include <internal/GlobalService.hpp>
 #include <rtt-config.h>
 
 using namespace std;
@@ -623,5 +627,214 @@ BOOST_AUTO_TEST_CASE( testExceptionRecovery )
 }
 #endif
 
+/**
+ * A runner which overruns its period in every fourth step.
+ */
+struct OverrunRunner
+    : public RunnableInterface
+{
+    int steps;
+    OverrunRunner() : steps(0) {}
+    bool initialize() { return true; }
+    void finalize() {}
+    void step() {
+        if ( ++steps % 4 == 0 )
+            usleep(15000);
+    }
+};
+
+/**
+ * Tests the statistics recorded by a periodic thread.
+ */
+BOOST_AUTO_TEST_CASE( testThreadStatistics )
+{
+    OverrunRunner runner;
+    Activity act(ORO_SCHED_OTHER, 0, 0.01, &runner, "StatsThread");
+    os::ThreadStatistics* stats = act.thread()->getThreadStatistics();
+    BOOST_REQUIRE( stats );
+    BOOST_CHECK_EQUAL( stats->execution.count(), 0u );
+
+    BOOST_CHECK( act.start() );
+    usleep(500000);
+    BOOST_CHECK( act.stop() );
+    unsigned int steps = runner.steps;
+    BOOST_CHECK( steps > 10 );
+    BOOST_CHECK_EQUAL( stats->execution.count(), steps );
+    BOOST_CHECK_EQUAL( stats->wakeLatency.count(), steps );
+    BOOST_CHECK( stats->execution.maximum() >= 15000000 );
+    BOOST_CHECK( stats->overruns() >= steps / 4 - 1 );
+    // the step after an overrun starts late:
+    BOOST_CHECK( stats->wakeLatency.maximum() >= 4000000 );
+
+    // published through the GlobalService:
+    Service::shared_ptr threads = internal::GlobalService::Instance()->provides("threads");
+    BOOST_REQUIRE( threads );
+    OperationCaller<std::vector<std::string>(void)> getThreads = threads->getOperation("getThreads");
+    OperationCaller<unsigned int(unsigned int)> getOverruns = threads->getOperation("getOverruns");
+    OperationCaller<unsigned int(unsigned int, const std::string&)> getCount = threads->getOperation("getCount");
+    OperationCaller<double(unsigned int, const std::string&)> getMax = threads->getOperation("getMax");
+    OperationCaller<bool(unsigned int)> reset = threads->getOperation("reset");
+    unsigned int number = act.thread()->threadNumber();
+    std::ostringstream label;
+    label << number << ": StatsThread";
+    std::vector<std::string> labels = getThreads();
+    BOOST_CHECK( std::find(labels.begin(), labels.end(), label.str()) != labels.end() );
+    BOOST_CHECK_EQUAL( getOverruns(number), stats->overruns() );
+    BOOST_CHECK_EQUAL( getCount(number, "execution"), steps );
+    BOOST_CHECK( getMax(number, "execution") >= 0.015 );
+    BOOST_CHECK_EQUAL( getCount(number, "noSuchTimer"), 0u );
+
+    // a second thread with the same name has its own statistics:
+    OverrunRunner other_runner;
+    Activity other(ORO_SCHED_OTHER, 0, 0.01, &other_runner, "StatsThread");
+    BOOST_CHECK( other.thread()->threadNumber() != number );
+    BOOST_CHECK_EQUAL( getCount(other.thread()->threadNumber(), "execution"), 0u );
+    BOOST_CHECK_EQUAL( getCount(number, "execution"), steps );
+
+    os::ThreadStatistics snapshot;
+    BOOST_CHECK( os::Thread::copyThreadStatistics(number, snapshot) );
+    BOOST_CHECK_EQUAL( snapshot.execution.count(), steps );
+    BOOST_CHECK_EQUAL( snapshot.wakeLatency.count(), steps );
+
+    BOOST_CHECK( reset(number) );
+    BOOST_CHECK_EQUAL( getOverruns(number), 0u );
+    BOOST_CHECK( !reset(~0u) );
+}
+
+/**
+ * A runner which records the moment of each step on the RTOS clock.
+ */
+struct StampRunner
+    : public RunnableInterface
+{
+    std::vector<nsecs> stamps;
+    StampRunner() { stamps.reserve(100); }
+    bool initialize() { return true; }
+    void finalize() {}
+    void step() {
+        if ( stamps.size() < stamps.capacity() )
+            stamps.push_back( rtos_get_time_ns() );
+    }
+    /**
+     * The number of steps that started within \a window after
+     * a multiple of \a period plus \a phase.
+     */
+    unsigned int aligned(nsecs period, nsecs phase, nsecs window) {
+        unsigned int result = 0;
+        for (unsigned int i = 0; i != stamps.size(); ++i)
+            if ( (stamps[i] - phase) % period < window )
+                ++result;
+        return result;
+    }
+};
+
+/**
+ * Counts its steps, the first one blocking until released.
+ */
+struct BlockingRunner : public RunnableInterface
+{
+    os::Mutex block;
+    volatile unsigned int steps;
+    BlockingRunner() : steps(0) {}
+    bool initialize() { return true; }
+    void step() {
+        os::MutexLock lock(block);
+        ++steps;
+    }
+    void finalize() {}
+};
+
+/**
+ * Tests aligning periodic threads to the clock with a phase offset.
+ */
+BOOST_AUTO_TEST_CASE( testClockAlignment )
+{
+    StampRunner first, second;
+    Activity act1(ORO_SCHED_OTHER, 0, 0.02, &first, "Aligned0");
+    Activity act2(ORO_SCHED_OTHER, 0, 0.02, &second, "Aligned10");
+    BOOST_CHECK( !act1.isClockAligned() );
+    act1.setClockAlignment(true);
+    act2.setClockAlignment(true, 0.01);
+    BOOST_CHECK( act2.isClockAligned() );
+    BOOST_CHECK_EQUAL( act2.getClockPhase(), 0.01 );
+
+    BOOST_CHECK( act2.start() );
+    usleep(7000);
+    BOOST_CHECK( act1.start() );
+    usleep(400000);
+    BOOST_CHECK( act1.stop() );
+    BOOST_CHECK( act2.stop() );
+
+    BOOST_REQUIRE( first.stamps.size() > 10 );
+    BOOST_REQUIRE( second.stamps.size() > 10 );
+    // allow for scheduling latency on a loaded machine:
+    BOOST_CHECK( first.aligned(20000000, 0, 5000000) >= first.stamps.size() * 8 / 10 );
+    BOOST_CHECK( second.aligned(20000000, 10000000, 5000000) >= second.stamps.size() * 8 / 10 );
+}
+
+BOOST_AUTO_TEST_CASE( testTriggerCoalescing )
+{
+    BlockingRunner runner;
+    Activity act(ORO_SCHED_OTHER, 0, 0.0, &runner, "Coalescing");
+    BOOST_CHECK( act.start() );
+    usleep(100000);
+    BOOST_CHECK_EQUAL( runner.steps, 1u );
+
+    // triggers while step() blocks collapse into one more step().
+    runner.block.lock();
+    BOOST_CHECK( act.trigger() );
+    usleep(100000);
+    for (int i = 0; i != 100; ++i)
+        BOOST_CHECK( act.trigger() );
+    runner.block.unlock();
+    usleep(100000);
+    BOOST_CHECK_EQUAL( runner.steps, 3u );
+    BOOST_CHECK_EQUAL( act.getCoalescedTriggers(), 99u );
+
+    // a trigger after step() returned is not lost.
+    BOOST_CHECK( act.trigger() );
+    usleep(100000);
+    BOOST_CHECK_EQUAL( runner.steps, 4u );
+    BOOST_CHECK( act.stop() );
+}
+
+/**
+ * Tests applying a thread profile from within the thread.
+ */
+BOOST_AUTO_TEST_CASE( testThreadProfile )
+{
+    os::ThreadProfile profile;
+    profile.cpus.push_back(0);
+    profile.stack_prefault = 64*1024;
+    StampRunner runner;
+    Activity act(ORO_SCHED_OTHER, 0, 0.01, profile, &runner, "Profiled");
+    BOOST_CHECK_EQUAL( act.getProfile().cpus.size(), 1u );
+    BOOST_CHECK_EQUAL( act.getProfile().stack_prefault, 64u*1024u );
+    BOOST_CHECK( act.start() );
+    usleep(100000);
+    BOOST_CHECK( runner.stamps.size() > 2 );
+#ifdef OROPKG_OS_GNULINUX
+    BOOST_CHECK_EQUAL( act.getCpuAffinity(), 1u );
+#endif
+
+    // a changed profile is applied by the running thread.
+    profile.stack_prefault = 0;
+    act.setProfile(profile);
+    BOOST_CHECK_EQUAL( act.getProfile().stack_prefault, 0u );
+    usleep(100000);
+    BOOST_CHECK( act.stop() );
+    BOOST_CHECK( !act.isRunning() );
+
+    // a prefault beyond the end of the stack is clamped to the stack size.
+    os::ThreadProfile large;
+    large.stack_prefault = 1024*1024*1024;
+    StampRunner large_runner;
+    Activity large_act(ORO_SCHED_OTHER, 0, 0.01, large, &large_runner, "LargePrefault");
+    BOOST_CHECK( large_act.start() );
+    usleep(100000);
+    BOOST_CHECK( large_runner.stamps.size() > 2 );
+    BOOST_CHECK( large_act.stop() );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -21,6 +21,7 @@
 #include "time_test.hpp"
 #include <boost/bind.hpp>
 #include <os/Timer.hpp>
+#include <os/TimingHistogram.hpp>
 #include <rtt-detail-fwd.hpp>
 #include <iostream>
 
@@ -86,6 +87,34 @@ struct TestTimer
     }
 };
 
+/**
+ * Kills timer 1 from the timeout() of timer 0, after timer 2 kept the
+ * timer thread busy until both expired.
+ */
+struct BatchKillTimer
+    : public Timer
+{
+    std::vector<Timer::TimerId> occured;
+    bool rearm;
+    BatchKillTimer(bool r = false)
+        :Timer(3, ORO_SCHED_RT, os::HighestPriority), rearm(r)
+    {
+        occured.reserve(3);
+    }
+    void timeout(Timer::TimerId id)
+    {
+        occured.push_back( id );
+        if ( id == 2 )
+            usleep(500000);
+        if ( id == 0 ) {
+            if ( rearm )
+                arm( 1, 10.0 );
+            else
+                killTimer( 1 );
+        }
+    }
+};
+
 BOOST_FIXTURE_TEST_SUITE( TimeTestSuite, TimeTest )
 
 BOOST_AUTO_TEST_CASE( testSecondsConversion )
@@ -350,4 +379,104 @@ BOOST_AUTO_TEST_CASE( testTimerWaitFor )
     BOOST_REQUIRE_CLOSE( hbg->secondsSince(0), now + 0.5, 0.1 );
 }
 
+BOOST_AUTO_TEST_CASE( testManyTimers )
+{
+    TestTimer timer;
+    const int n = 2000;
+    timer.setMaxTimers( n );
+    timer.occured.reserve( n );
+
+    // timers expire in groups of 100, which fire in one wake-up.
+    for (int i = 0; i != n; ++i)
+        BOOST_CHECK( timer.arm(i, 0.5 + 0.01 * ((i * 7) % 20)) );
+    // kill every third timer and re-arm every fifth one later.
+    for (int i = 0; i < n; i += 3)
+        BOOST_CHECK( timer.killTimer(i) );
+    for (int i = 0; i < n; i += 5)
+        BOOST_CHECK( timer.arm(i, 0.8) );
+    int expected = 0;
+    for (int i = 0; i != n; ++i)
+        if ( i % 3 != 0 || i % 5 == 0 )
+            ++expected;
+
+    sleep(2);
+
+    BOOST_REQUIRE_EQUAL( int(timer.occured.size()), expected );
+    std::vector<bool> fired(n, false);
+    for (int i = 0; i != expected; ++i) {
+        Timer::TimerId id = timer.occured[i].first;
+        BOOST_CHECK( !fired[id] );
+        fired[id] = true;
+        BOOST_CHECK( id % 3 != 0 || id % 5 == 0 );
+        BOOST_CHECK( !timer.isArmed( id ) );
+        if ( i != 0 )
+            BOOST_CHECK( timer.occured[i].second >= timer.occured[i-1].second );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( testKillTimerInBatch )
+{
+    BatchKillTimer timer;
+    BOOST_CHECK( timer.arm(2, 0.1) );
+    BOOST_CHECK( timer.arm(0, 0.2) );
+    BOOST_CHECK( timer.arm(1, 0.3) );
+    sleep(1);
+
+    // timers 0 and 1 expired together, but timer 0 killed timer 1.
+    BOOST_REQUIRE_EQUAL( timer.occured.size(), 2u );
+    BOOST_CHECK_EQUAL( timer.occured[0], 2 );
+    BOOST_CHECK_EQUAL( timer.occured[1], 0 );
+    BOOST_CHECK( !timer.isArmed( 1 ) );
+
+    // the same if timer 0 re-armed timer 1.
+    BatchKillTimer rearming(true);
+    BOOST_CHECK( rearming.arm(2, 0.1) );
+    BOOST_CHECK( rearming.arm(0, 0.2) );
+    BOOST_CHECK( rearming.arm(1, 0.3) );
+    sleep(1);
+    BOOST_REQUIRE_EQUAL( rearming.occured.size(), 2u );
+    BOOST_CHECK_EQUAL( rearming.occured[0], 2 );
+    BOOST_CHECK_EQUAL( rearming.occured[1], 0 );
+    BOOST_CHECK( rearming.isArmed( 1 ) );
+}
+
+BOOST_AUTO_TEST_CASE( testTimingHistogram )
+{
+    TimingHistogram h;
+    BOOST_CHECK_EQUAL( h.count(), 0u );
+    BOOST_CHECK_EQUAL( h.percentile(0.99), 0 );
+
+    BOOST_CHECK_EQUAL( TimingHistogram::bucket(0), 0 );
+    BOOST_CHECK_EQUAL( TimingHistogram::bucket(1), 0 );
+    BOOST_CHECK_EQUAL( TimingHistogram::bucket(2), 1 );
+    BOOST_CHECK_EQUAL( TimingHistogram::bucket(1000), 9 );
+    BOOST_CHECK_EQUAL( TimingHistogram::bucket(1024), 10 );
+    BOOST_CHECK_EQUAL( TimingHistogram::bucket(nsecs(1) << 50), TimingHistogram::Buckets - 1 );
+
+    // 99 samples of 1us and one of 1ms:
+    for (int i = 0; i != 99; ++i)
+        h.record( 1000 );
+    h.record( 1000000 );
+    BOOST_CHECK_EQUAL( h.count(), 100u );
+    BOOST_CHECK_EQUAL( h.minimum(), 1000 );
+    BOOST_CHECK_EQUAL( h.maximum(), 1000000 );
+    BOOST_CHECK_CLOSE( h.mean(), (99*1000.0 + 1000000.0)/100, 0.001 );
+    BOOST_CHECK_EQUAL( h.bucketCount(9), 99u );
+    BOOST_CHECK_EQUAL( h.percentile(0.99), 1024 );
+    BOOST_CHECK_EQUAL( h.percentile(1.0), 1000000 );
+
+    // readers see the reset before the next record:
+    h.reset();
+    BOOST_CHECK_EQUAL( h.count(), 0u );
+    BOOST_CHECK_EQUAL( h.minimum(), 0 );
+    BOOST_CHECK_EQUAL( h.maximum(), 0 );
+    BOOST_CHECK_EQUAL( h.mean(), 0.0 );
+    BOOST_CHECK_EQUAL( h.bucketCount(9), 0u );
+    BOOST_CHECK_EQUAL( h.percentile(1.0), 0 );
+    h.record( 10 );
+    BOOST_CHECK_EQUAL( h.count(), 1u );
+    BOOST_CHECK_EQUAL( h.minimum(), 10 );
+    BOOST_CHECK_EQUAL( h.maximum(), 10 );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
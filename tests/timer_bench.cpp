@@ -0,0 +1,160 @@
+/***************************************************************************
+  tag: timer_bench.cpp
+
+                        timer_bench.cpp -  description
+                           -------------------
+    begin                : October 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/**
+ * @file timer_bench.cpp
+ * Measures how long os::Timer takes to deliver the timeout() of N one-shot
+ * timers that expire together, for N from 10 up to a maximum, tenfold each
+ * time. The min-heap of os::Timer is compared to the linear scan over all
+ * timers which it replaced, and which is reproduced here by overriding
+ * Timer::loop(). The results are printed as CSV or JSON, one record per
+ * loop and number of timers.
+ */
+
+#include <os/main.h>
+#include <os/TimeService.hpp>
+#include <os/Timer.hpp>
+#include <os/MutexLock.hpp>
+#include <os/fosi.h>
+#include <Activity.hpp>
+
+#include "bench.hpp"
+
+#include <limits>
+
+using namespace std;
+using namespace RTT;
+
+namespace {
+
+    /**
+     * The command line options of the benchmark.
+     */
+    struct Options
+    {
+        int max_timers;
+        double wait;
+
+        Options()
+            : max_timers(10000), wait(0.2)
+        {}
+    };
+
+    /**
+     * Counts the timeouts and remembers when the last one happened.
+     * With \a scan set, expired timers are found like os::Timer did
+     * before it kept a heap: one scan over all timers per expired timer.
+     */
+    class BenchTimer : public os::Timer
+    {
+        bool mscan;
+    public:
+        volatile int fired;
+        volatile os::TimeService::nsecs last;
+
+        BenchTimer(TimerId max_timers, bool scan)
+            : os::Timer(max_timers, -1), mscan(scan), fired(0), last(0)
+        {
+            // started here, such that the thread runs our loop().
+            mThread = new Activity(ORO_SCHED_OTHER, 0, 0.0, this, "BenchTimer");
+            mThread->start();
+        }
+
+        ~BenchTimer()
+        {
+            mThread->stop();
+        }
+
+        void timeout(TimerId)
+        {
+            last = os::TimeService::Instance()->getNSecs();
+            ++fired;
+        }
+
+        void loop()
+        {
+            if ( !mscan ) {
+                os::Timer::loop();
+                return;
+            }
+            while (!mdo_quit) {
+                Time wake_up_time;
+                TimerId next_timer_id = 0;
+                {
+                    os::MutexLock locker(m);
+                    wake_up_time = 1000000000LL * std::numeric_limits<int32_t>::max();
+                    for (TimerIds::iterator it = mtimers.begin(); it != mtimers.end(); ++it) {
+                        if ( it->expires != 0 && it->expires < wake_up_time  ) {
+                            wake_up_time = it->expires;
+                            next_timer_id = it - mtimers.begin();
+                        }
+                    }
+                }
+                int ret = 0;
+                if ( wake_up_time > rtos_get_time_ns() )
+                    ret = msem.waitUntil( wake_up_time );
+                else
+                    ret = -1;
+                if (ret == -1) {
+                    {
+                        os::MutexLock locker(m);
+                        mtimers[next_timer_id].expires = 0;
+                        mtimers[next_timer_id].expired.broadcast();
+                    }
+                    timeout( next_timer_id );
+                }
+            }
+        }
+    };
+
+    bench::Record measure(const Options& opts, bool scan, int ntimers)
+    {
+        BenchTimer timer(ntimers, scan);
+        for (int i = 0; i != ntimers; ++i)
+            timer.arm(i, opts.wait);
+        // the last timer expires at about this time.
+        os::TimeService::nsecs expires = os::TimeService::Instance()->getNSecs() + Seconds_to_nsecs(opts.wait);
+
+        // give up after ten times the wait, or at least ten seconds.
+        os::TimeService::nsecs deadline = expires + Seconds_to_nsecs(opts.wait * 10 + 10);
+        while ( timer.fired != ntimers && os::TimeService::Instance()->getNSecs() < deadline )
+            bench::sleep_nsecs(1000000);
+
+        return bench::Record().add("loop", scan ? "scan" : "heap").add("timers", ntimers)
+            .add("fired", int(timer.fired))
+            .add("seconds", timer.last > expires ? nsecs_to_Seconds(timer.last - expires) : 0.0);
+    }
+}
+
+int ORO_main(int argc, char** argv)
+{
+    Options opts;
+    bench::Arguments args;
+    args.value("--max-timers", "N", opts.max_timers, "Measure 10..N timers, tenfold");
+    args.value("--wait", "SECONDS", opts.wait, "Time until the timers expire");
+    if ( !args.parse(argc, argv) || opts.max_timers < 10 || opts.wait <= 0 ) {
+        args.usage(argv[0]);
+        return 1;
+    }
+
+    bench::Printer out( args.json() );
+    for (int n = 10; n <= opts.max_timers; n *= 10) {
+        out.print( measure(opts, false, n) );
+        out.print( measure(opts, true, n) );
+    }
+    return 0;
+}